@@ -0,0 +1,117 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_IMPLEMENTATION__CALL_STATISTICS_H_
+#define RMW_IMPLEMENTATION__CALL_STATISTICS_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rmw/ret_types.h"
+
+#include "rmw_implementation/visibility_control.h"
+
+/// Number of buckets in call latency histograms.
+/**
+ * Buckets are log-linear: latencies below 8 nanoseconds get a bucket each,
+ * and larger ones get eight buckets per power of two nanoseconds, which
+ * bounds their relative error to 12.5%, up to about 17 seconds.
+ * The last bucket also holds every latency beyond its lower bound.
+ * See rmw_implementation_get_call_latency_bucket_lower_bound().
+ */
+#define RMW_IMPLEMENTATION_CALL_LATENCY_BUCKET_COUNT 256
+
+/// Statistics about the calls made to one function of the RMW implementation.
+typedef struct RMW_IMPLEMENTATION_PUBLIC_TYPE rmw_implementation_call_statistics_s
+{
+  /// Name of the function, e.g. "rmw_publish".
+  const char * function_name;
+  /// Number of calls.
+  uint64_t call_count;
+  /// Number of calls which returned an error.
+  /**
+   * That is, any return code other than RMW_RET_OK and RMW_RET_TIMEOUT,
+   * or a null pointer for functions returning one.
+   */
+  uint64_t error_count;
+  /// Accumulated duration of all calls, in nanoseconds.
+  uint64_t total_duration_ns;
+  /// Number of calls per latency bucket.
+  uint64_t latency_histogram[RMW_IMPLEMENTATION_CALL_LATENCY_BUCKET_COUNT];
+} rmw_implementation_call_statistics_t;
+
+/// Check whether call statistics are being collected.
+/**
+ * Call statistics are collected when the RMW_IMPLEMENTATION_CALL_STATISTICS
+ * environment variable is set to 1 by the time the RMW implementation is
+ * loaded.
+ * Collection adds no overhead to calls otherwise.
+ *
+ * \return `true` if call statistics are being collected, or
+ * \return `false` otherwise.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+bool
+rmw_implementation_call_statistics_enabled(void);
+
+/// Take a snapshot of call statistics.
+/**
+ * Statistics are recorded per thread and aggregated upon snapshot.
+ * Statistics of threads that are still making calls may not be accounted
+ * for up to the very last call.
+ *
+ * \param[out] statistics Array to populate, one element per function.
+ * \param[in] capacity Number of elements in `statistics`.
+ * \param[out] count Number of functions there are statistics for, which may
+ *   exceed `capacity`.
+ * \return `RMW_RET_OK` if successful, or
+ * \return `RMW_RET_INVALID_ARGUMENT` if `count` is NULL, or if `statistics`
+ *   is NULL while `capacity` is not 0.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+rmw_ret_t
+rmw_implementation_get_call_statistics(
+  rmw_implementation_call_statistics_t * statistics,
+  size_t capacity,
+  size_t * count);
+
+/// Reset call statistics.
+/**
+ * Calls that are ongoing may still be accounted for after the reset.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+void
+rmw_implementation_reset_call_statistics(void);
+
+/// Get the lower bound of a call latency histogram bucket.
+/**
+ * \param[in] bucket Index of the bucket.
+ * \return Lower bound of the bucket, in nanoseconds, or
+ * \return `UINT64_MAX` if `bucket` is out of range.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+uint64_t
+rmw_implementation_get_call_latency_bucket_lower_bound(size_t bucket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RMW_IMPLEMENTATION__CALL_STATISTICS_H_
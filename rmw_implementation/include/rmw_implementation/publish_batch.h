@@ -0,0 +1,71 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_IMPLEMENTATION__PUBLISH_BATCH_H_
+#define RMW_IMPLEMENTATION__PUBLISH_BATCH_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rmw/ret_types.h"
+#include "rmw/types.h"
+
+#include "rmw_implementation/visibility_control.h"
+
+/// A message to publish as part of a batch.
+typedef struct RMW_IMPLEMENTATION_PUBLIC_TYPE rmw_implementation_publish_batch_entry_s
+{
+  /// Publisher to publish the message with.
+  const rmw_publisher_t * publisher;
+  /// Message to publish.
+  const void * ros_message;
+  /// Preallocated memory to use, as for rmw_publish(), which may be NULL.
+  rmw_publisher_allocation_t * allocation;
+} rmw_implementation_publish_batch_entry_t;
+
+/// Publish a batch of messages, possibly with different publishers.
+/**
+ * Messages are published in order, as if by calling rmw_publish() on each
+ * entry, until one fails.
+ * If the loaded RMW implementation exports a function named
+ * `rmw_publish_batch` with the very same signature as this one, the whole
+ * batch is handed over to it, so that it may amortize locking and system
+ * calls across messages. Otherwise, messages are published one by one.
+ *
+ * \param[in] entries Array of messages to publish, along with their publisher.
+ * \param[in] count Number of elements in `entries`.
+ * \param[out] published_count Number of messages published, which is less
+ *   than `count` only if publishing one failed.
+ * \return `RMW_RET_OK` if all messages were published, or
+ * \return `RMW_RET_INVALID_ARGUMENT` if `published_count` is NULL, or if
+ *   `entries` is NULL while `count` is not 0, or
+ * \return any error rmw_publish() may return for the first message that
+ *   failed to be published.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+rmw_ret_t
+rmw_implementation_publish_batch(
+  const rmw_implementation_publish_batch_entry_t * entries,
+  size_t count,
+  size_t * published_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RMW_IMPLEMENTATION__PUBLISH_BATCH_H_
@@ -0,0 +1,88 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RMW_IMPLEMENTATION__SERIALIZED_MESSAGE_POOL_H_
+#define RMW_IMPLEMENTATION__SERIALIZED_MESSAGE_POOL_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#include <stddef.h>
+
+#include "rcutils/allocator.h"
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_runtime_c/sequence_bound.h"
+
+#include "rmw/ret_types.h"
+#include "rmw/serialized_message.h"
+
+#include "rmw_implementation/visibility_control.h"
+
+/// Get an allocator drawing memory from a pool of serialized message buffers.
+/**
+ * Buffers are sized in powers of two, from 256 bytes to 64 MiB, and larger
+ * ones are not pooled.
+ * Deallocated buffers are kept in a cache of the deallocating thread, which
+ * overflows into a free list shared by all threads, for later allocations of
+ * the same size class to reuse them.
+ * Both only hold on to a few buffers of each size class, and reserve no memory
+ * until buffers are deallocated.
+ * Reallocations that fit the size class of a buffer return it as is, so that
+ * growing serialized messages does not copy them over and over.
+ *
+ * The allocator may be passed to rmw_serialized_message_init() and is safe to
+ * use from any thread, but memory it allocates must be reallocated and
+ * deallocated with it, and it only.
+ *
+ * \return Allocator using the pool.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+rcutils_allocator_t
+rmw_implementation_get_serialized_message_pool_allocator(void);
+
+/// Initialize a serialized message with a pooled buffer sized for a message type.
+/**
+ * The buffer is sized using rmw_get_serialized_message_size() if the loaded
+ * RMW implementation can compute the size of serialized messages of the given
+ * type, and to `default_capacity` otherwise.
+ *
+ * \param[out] serialized_message Zero initialized serialized message.
+ * \param[in] type_support Type support of the messages to serialize.
+ * \param[in] message_bounds Bounds of the messages to serialize.
+ * \param[in] default_capacity Capacity of the buffer if the size of
+ *   serialized messages cannot be computed.
+ * \return `RMW_RET_OK` if successful, or
+ * \return `RMW_RET_INVALID_ARGUMENT` if any argument is NULL, or
+ * \return `RMW_RET_BAD_ALLOC` if the buffer could not be allocated.
+ */
+RMW_IMPLEMENTATION_PUBLIC
+rmw_ret_t
+rmw_implementation_serialized_message_init_pooled(
+  rmw_serialized_message_t * serialized_message,
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  size_t default_capacity);
+
+/// Release the buffers cached by the calling thread and by the shared free list.
+RMW_IMPLEMENTATION_PUBLIC
+void
+rmw_implementation_trim_serialized_message_pool(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // RMW_IMPLEMENTATION__SERIALIZED_MESSAGE_POOL_H_
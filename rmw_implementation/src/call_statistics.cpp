@@ -0,0 +1,271 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_implementation/call_statistics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "rcpputils/env.hpp"
+
+#include "rmw/error_handling.h"
+
+#include "./call_statistics.hpp"
+#include "./function_ids.hpp"
+
+namespace
+{
+
+constexpr size_t cache_line_size = 64;
+
+constexpr size_t bucket_count = RMW_IMPLEMENTATION_CALL_LATENCY_BUCKET_COUNT;
+
+// Latencies below 2^sub_bucket_bits nanoseconds get a bucket each, and
+// larger ones get 2^sub_bucket_bits buckets per power of two.
+constexpr size_t sub_bucket_bits = 3u;
+constexpr size_t sub_bucket_count = size_t{1u} << sub_bucket_bits;
+
+// Statistics are only ever incremented by the thread that owns them, and
+// reset by others, hence relaxed increments suffice, which are uncontended
+// but for resets, and padding keeps the statistics of different functions
+// apart.
+struct alignas(cache_line_size) FunctionCallStatistics
+{
+  void reset()
+  {
+    call_count.store(0u, std::memory_order_relaxed);
+    error_count.store(0u, std::memory_order_relaxed);
+    total_duration_ns.store(0u, std::memory_order_relaxed);
+    for (std::atomic<uint64_t> & bucket : latency_histogram) {
+      bucket.store(0u, std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<uint64_t> call_count{0u};
+  std::atomic<uint64_t> error_count{0u};
+  std::atomic<uint64_t> total_duration_ns{0u};
+  std::atomic<uint64_t> latency_histogram[bucket_count]{};
+};
+
+// Statistics of the functions a thread called, allocated upon their first
+// call, as threads usually call only a few of them.
+struct ThreadCallStatistics
+{
+  ~ThreadCallStatistics()
+  {
+    for (std::atomic<FunctionCallStatistics *> & function : functions) {
+      delete function.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::atomic<FunctionCallStatistics *> functions[function_count]{};
+};
+
+// Statistics of all threads that ever made a call.
+// Statistics of threads that are gone are kept, and handed over to new threads.
+struct Registry
+{
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadCallStatistics>> all_statistics;
+  std::vector<ThreadCallStatistics *> unowned_statistics;
+};
+
+Registry &
+get_registry()
+{
+  // Never destroyed, as threads may still exit after static destruction.
+  static Registry * registry = new Registry();
+  return *registry;
+}
+
+class ThreadCallStatisticsHandle
+{
+public:
+  ThreadCallStatisticsHandle()
+  {
+    Registry & registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (!registry.unowned_statistics.empty()) {
+      statistics = registry.unowned_statistics.back();
+      registry.unowned_statistics.pop_back();
+    } else {
+      registry.all_statistics.emplace_back(new ThreadCallStatistics());
+      statistics = registry.all_statistics.back().get();
+    }
+  }
+
+  ~ThreadCallStatisticsHandle()
+  {
+    Registry & registry = get_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.unowned_statistics.push_back(statistics);
+  }
+
+  ThreadCallStatistics * statistics;
+};
+
+std::atomic<bool> g_enabled{false};
+
+inline void
+add(std::atomic<uint64_t> & counter, uint64_t value)
+{
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+inline size_t
+get_latency_bucket(uint64_t duration_ns)
+{
+  if (duration_ns < sub_bucket_count) {
+    return static_cast<size_t>(duration_ns);
+  }
+#if defined(__GNUC__) || defined(__clang__)
+  const size_t msb = 63u - static_cast<size_t>(__builtin_clzll(duration_ns));
+#else
+  size_t msb = 0u;
+  for (uint64_t value = duration_ns; value > 1u; value >>= 1u) {
+    ++msb;
+  }
+#endif
+  const size_t sub_bucket =
+    static_cast<size_t>((duration_ns >> (msb - sub_bucket_bits)) & (sub_bucket_count - 1u));
+  const size_t bucket = (msb - sub_bucket_bits + 1u) * sub_bucket_count + sub_bucket;
+  return std::min(bucket, bucket_count - 1u);
+}
+
+}  // namespace
+
+bool
+call_statistics_requested()
+{
+  try {
+    return rcpputils::get_env_var("RMW_IMPLEMENTATION_CALL_STATISTICS") == "1";
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+void
+set_call_statistics_enabled(bool enabled)
+{
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void
+record_call(size_t function_id, std::chrono::nanoseconds duration, bool failed)
+{
+  thread_local ThreadCallStatisticsHandle handle;
+  std::atomic<FunctionCallStatistics *> & function = handle.statistics->functions[function_id];
+  FunctionCallStatistics * function_statistics = function.load(std::memory_order_relaxed);
+  if (!function_statistics) {
+    function_statistics = new (std::nothrow) FunctionCallStatistics();
+    if (!function_statistics) {
+      // the call goes unaccounted for
+      return;
+    }
+    function.store(function_statistics, std::memory_order_release);
+  }
+  FunctionCallStatistics & statistics = *function_statistics;
+  const uint64_t duration_ns =
+    duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0u;
+  add(statistics.call_count, 1u);
+  if (failed) {
+    add(statistics.error_count, 1u);
+  }
+  add(statistics.total_duration_ns, duration_ns);
+  add(statistics.latency_histogram[get_latency_bucket(duration_ns)], 1u);
+}
+
+bool
+rmw_implementation_call_statistics_enabled(void)
+{
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+rmw_ret_t
+rmw_implementation_get_call_statistics(
+  rmw_implementation_call_statistics_t * statistics,
+  size_t capacity,
+  size_t * count)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(count, RMW_RET_INVALID_ARGUMENT);
+  if (!statistics && capacity != 0u) {
+    RMW_SET_ERROR_MSG("statistics argument is null");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  const size_t size = std::min(capacity, static_cast<size_t>(function_count));
+  for (size_t id = 0u; id < size; ++id) {
+    statistics[id] = rmw_implementation_call_statistics_t();
+    statistics[id].function_name = get_function_name(id);
+  }
+
+  Registry & registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto & thread_statistics : registry.all_statistics) {
+    for (size_t id = 0u; id < size; ++id) {
+      const FunctionCallStatistics * function_statistics =
+        thread_statistics->functions[id].load(std::memory_order_acquire);
+      if (!function_statistics) {
+        continue;
+      }
+      const FunctionCallStatistics & function = *function_statistics;
+      statistics[id].call_count += function.call_count.load(std::memory_order_relaxed);
+      statistics[id].error_count += function.error_count.load(std::memory_order_relaxed);
+      statistics[id].total_duration_ns +=
+        function.total_duration_ns.load(std::memory_order_relaxed);
+      for (size_t bucket = 0u; bucket < bucket_count; ++bucket) {
+        statistics[id].latency_histogram[bucket] +=
+          function.latency_histogram[bucket].load(std::memory_order_relaxed);
+      }
+    }
+  }
+  *count = function_count;
+  return RMW_RET_OK;
+}
+
+void
+rmw_implementation_reset_call_statistics(void)
+{
+  Registry & registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto & thread_statistics : registry.all_statistics) {
+    for (std::atomic<FunctionCallStatistics *> & function : thread_statistics->functions) {
+      FunctionCallStatistics * function_statistics = function.load(std::memory_order_acquire);
+      if (function_statistics) {
+        function_statistics->reset();
+      }
+    }
+  }
+}
+
+uint64_t
+rmw_implementation_get_call_latency_bucket_lower_bound(size_t bucket)
+{
+  if (bucket >= bucket_count) {
+    return UINT64_MAX;
+  }
+  if (bucket < sub_bucket_count) {
+    return bucket;
+  }
+  const size_t msb = bucket / sub_bucket_count + sub_bucket_bits - 1u;
+  const uint64_t sub_bucket = bucket % sub_bucket_count;
+  return (sub_bucket_count + sub_bucket) << (msb - sub_bucket_bits);
+}
@@ -0,0 +1,55 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CALL_STATISTICS_HPP_
+#define CALL_STATISTICS_HPP_
+
+#include <chrono>
+#include <cstddef>
+
+#include "rmw/ret_types.h"
+
+/// Check whether call statistics collection was requested via the environment.
+bool
+call_statistics_requested();
+
+/// Record whether calls are being instrumented to collect statistics.
+void
+set_call_statistics_enabled(bool enabled);
+
+/// Record a call to a function on behalf of the calling thread.
+void
+record_call(size_t function_id, std::chrono::nanoseconds duration, bool failed);
+
+/// Check whether a function return value denotes an error.
+inline bool
+is_error_return(rmw_ret_t ret)
+{
+  return RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret;
+}
+
+inline bool
+is_error_return(bool)
+{
+  return false;
+}
+
+template<typename T>
+inline bool
+is_error_return(T * ret)
+{
+  return nullptr == ret;
+}
+
+#endif  // CALL_STATISTICS_HPP_
@@ -0,0 +1,1262 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./content_filter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/env.hpp"
+
+#include "rmw/error_handling.h"
+
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_runtime_c/string.h"
+#include "rosidl_typesupport_introspection_c/field_types.h"
+#include "rosidl_typesupport_introspection_c/identifier.h"
+#include "rosidl_typesupport_introspection_c/message_introspection.h"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+
+namespace
+{
+
+enum class Language
+{
+  c,
+  cpp
+};
+
+// Introspection members of a message type, in either language.
+struct Members
+{
+  Language language;
+  const void * message_members;
+};
+
+// A member of a message type, as described by introspection.
+struct Member
+{
+  uint8_t type_id;
+  bool is_array;
+  size_t offset;
+  Members nested;
+};
+
+template<typename MessageMembersT>
+bool
+find_member_in(
+  const MessageMembersT * message_members, Language language, const std::string & name,
+  Member & member)
+{
+  for (uint32_t i = 0u; i < message_members->member_count_; ++i) {
+    const auto & candidate = message_members->members_[i];
+    if (name == candidate.name_) {
+      member.type_id = candidate.type_id_;
+      member.is_array = candidate.is_array_;
+      member.offset = candidate.offset_;
+      member.nested = {language, candidate.members_ ? candidate.members_->data : nullptr};
+      return true;
+    }
+  }
+  return false;
+}
+
+bool
+find_member(const Members & members, const std::string & name, Member & member)
+{
+  if (Language::c == members.language) {
+    return find_member_in(
+      static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+        members.message_members), Language::c, name, member);
+  }
+  return find_member_in(
+    static_cast<const rosidl_typesupport_introspection_cpp::MessageMembers *>(
+      members.message_members), Language::cpp, name, member);
+}
+
+Members
+get_members(const rosidl_message_type_support_t * type_support)
+{
+  const rosidl_message_type_support_t * introspection =
+    get_message_typesupport_handle(type_support, rosidl_typesupport_introspection_c__identifier);
+  if (introspection) {
+    return {Language::c, introspection->data};
+  }
+  rmw_reset_error();
+  introspection = get_message_typesupport_handle(
+    type_support, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+  if (introspection) {
+    return {Language::cpp, introspection->data};
+  }
+  rmw_reset_error();
+  throw std::invalid_argument("message type support provides no introspection");
+}
+
+enum class Kind
+{
+  boolean,
+  number,
+  string
+};
+
+const char *
+get_kind_name(Kind kind)
+{
+  switch (kind) {
+    case Kind::boolean:
+      return "boolean";
+    case Kind::number:
+      return "number";
+    default:
+      return "string";
+  }
+}
+
+// How an operand is loaded upon evaluation: either a literal, or a field of
+// a given type at a given offset in messages.
+enum class Load : uint8_t
+{
+  literal,
+  boolean,
+  float32,
+  float64,
+  long_double,
+  signed_char,
+  unsigned_char,
+  uint8,
+  int8,
+  uint16,
+  int16,
+  uint32,
+  int32,
+  uint64,
+  int64,
+  c_string,
+  cpp_string
+};
+
+// Field type ids are shared by C and C++ introspection, unlike the types
+// fields are stored as.
+bool
+get_load(uint8_t type_id, Language language, Load & load, Kind & kind)
+{
+  kind = Kind::number;
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+      load = Load::boolean;
+      kind = Kind::boolean;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      load = Load::float32;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      load = Load::float64;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
+      load = Load::long_double;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+      // char maps to signed char in C, and to unsigned char in C++
+      load = Language::c == language ? Load::signed_char : Load::unsigned_char;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+      load = Load::uint8;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      load = Load::int8;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+      load = Load::uint16;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      load = Load::int16;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+      load = Load::uint32;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      load = Load::int32;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      load = Load::uint64;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      load = Load::int64;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+      load = Language::c == language ? Load::c_string : Load::cpp_string;
+      kind = Kind::string;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// A number, kept as an integer whenever it is one, so that 64 bits integers
+// compare exactly.
+struct Number
+{
+  enum class Type : uint8_t
+  {
+    signed_integer,
+    unsigned_integer,
+    floating_point
+  };
+
+  Type type{Type::signed_integer};
+  union
+  {
+    int64_t signed_integer;
+    uint64_t unsigned_integer;
+    double floating_point{0.0};
+  };
+};
+
+inline Number
+make_number(int64_t value)
+{
+  Number number;
+  number.type = Number::Type::signed_integer;
+  number.signed_integer = value;
+  return number;
+}
+
+inline Number
+make_number(uint64_t value)
+{
+  Number number;
+  number.type = Number::Type::unsigned_integer;
+  number.unsigned_integer = value;
+  return number;
+}
+
+inline Number
+make_number(double value)
+{
+  Number number;
+  number.type = Number::Type::floating_point;
+  number.floating_point = value;
+  return number;
+}
+
+// A message field, given by its type and its offset from the start of
+// messages, nested messages included, or a literal, which expression
+// parameters are substituted with.
+struct Operand
+{
+  Load load{Load::literal};
+  size_t offset{0u};
+  Kind kind{Kind::number};
+  Number number;
+  std::string string;
+};
+
+enum class Operation
+{
+  equal,
+  not_equal,
+  less,
+  less_equal,
+  greater,
+  greater_equal,
+  like,
+  between,
+  logical_and,
+  logical_or,
+  logical_not
+};
+
+struct Node
+{
+  Operation operation;
+  // Whether the result of a LIKE or BETWEEN predicate is to be negated.
+  bool negated{false};
+  // Conditions of logical operations.
+  std::unique_ptr<Node> left;
+  std::unique_ptr<Node> right;
+  // Operands of predicates.
+  Operand operands[3];
+};
+
+enum class TokenType
+{
+  identifier,
+  number,
+  string,
+  parameter,
+  relational_operator,
+  left_parenthesis,
+  right_parenthesis,
+  end
+};
+
+struct Token
+{
+  TokenType type;
+  std::string text;
+};
+
+std::vector<Token>
+tokenize(const std::string & expression)
+{
+  std::vector<Token> tokens;
+  size_t i = 0u;
+  const size_t size = expression.size();
+  while (i < size) {
+    const char c = expression[i];
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+    } else if (std::isalpha(static_cast<unsigned char>(c)) || '_' == c) {
+      const size_t start = i;
+      while (i < size && (std::isalnum(static_cast<unsigned char>(expression[i])) ||
+        '_' == expression[i] || '.' == expression[i]))
+      {
+        ++i;
+      }
+      tokens.push_back({TokenType::identifier, expression.substr(start, i - start)});
+    } else if (
+      std::isdigit(static_cast<unsigned char>(c)) || '.' == c ||
+      (('-' == c || '+' == c) && i + 1u < size &&
+      (std::isdigit(static_cast<unsigned char>(expression[i + 1u])) || '.' == expression[i + 1u])))
+    {
+      const char * start = expression.c_str() + i;
+      char * end = nullptr;
+      std::strtod(start, &end);
+      if (end == start) {
+        throw std::invalid_argument("malformed number at offset " + std::to_string(i));
+      }
+      tokens.push_back({TokenType::number, std::string(start, static_cast<size_t>(end - start))});
+      i += static_cast<size_t>(end - start);
+    } else if ('\'' == c || '"' == c || '`' == c) {
+      const size_t end = expression.find(c, i + 1u);
+      if (std::string::npos == end) {
+        throw std::invalid_argument("unterminated string at offset " + std::to_string(i));
+      }
+      tokens.push_back({TokenType::string, expression.substr(i + 1u, end - i - 1u)});
+      i = end + 1u;
+    } else if ('%' == c) {
+      const size_t start = ++i;
+      while (i < size && std::isdigit(static_cast<unsigned char>(expression[i]))) {
+        ++i;
+      }
+      if (start == i) {
+        throw std::invalid_argument("malformed parameter at offset " + std::to_string(start - 1u));
+      }
+      tokens.push_back({TokenType::parameter, expression.substr(start, i - start)});
+    } else if ('(' == c) {
+      tokens.push_back({TokenType::left_parenthesis, "("});
+      ++i;
+    } else if (')' == c) {
+      tokens.push_back({TokenType::right_parenthesis, ")"});
+      ++i;
+    } else if ('=' == c || '<' == c || '>' == c || '!' == c) {
+      std::string text(1u, c);
+      if (i + 1u < size && ('=' == expression[i + 1u] || ('<' == c && '>' == expression[i + 1u]))) {
+        text += expression[i + 1u];
+      }
+      if ("!" == text) {
+        throw std::invalid_argument("unexpected '!' at offset " + std::to_string(i));
+      }
+      tokens.push_back({TokenType::relational_operator, text});
+      i += text.size();
+    } else {
+      throw std::invalid_argument(
+              std::string("unexpected '") + c + "' at offset " + std::to_string(i));
+    }
+  }
+  tokens.push_back({TokenType::end, ""});
+  return tokens;
+}
+
+bool
+equals_ignoring_case(const std::string & text, const char * keyword)
+{
+  size_t i = 0u;
+  for (; i < text.size() && keyword[i] != '\0'; ++i) {
+    if (std::toupper(static_cast<unsigned char>(text[i])) != keyword[i]) {
+      return false;
+    }
+  }
+  return i == text.size() && keyword[i] == '\0';
+}
+
+bool
+is_keyword(const std::string & text)
+{
+  for (const char * keyword : {"AND", "OR", "NOT", "LIKE", "BETWEEN", "TRUE", "FALSE"}) {
+    if (equals_ignoring_case(text, keyword)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Parse a literal, as found in expression parameters.
+// Anything but a number, a boolean or a quoted string is taken as a string.
+Operand
+parse_literal(const std::string & text)
+{
+  Operand operand;
+  const size_t start = text.find_first_not_of(" \t\r\n");
+  const size_t end = text.find_last_not_of(" \t\r\n");
+  const std::string trimmed =
+    std::string::npos == start ? std::string() : text.substr(start, end - start + 1u);
+  if (
+    trimmed.size() >= 2u && ('\'' == trimmed.front() || '"' == trimmed.front()) &&
+    trimmed.back() == trimmed.front())
+  {
+    operand.kind = Kind::string;
+    operand.string = trimmed.substr(1u, trimmed.size() - 2u);
+    return operand;
+  }
+  if (equals_ignoring_case(trimmed, "TRUE") || equals_ignoring_case(trimmed, "FALSE")) {
+    operand.kind = Kind::boolean;
+    operand.number = make_number(static_cast<uint64_t>(equals_ignoring_case(trimmed, "TRUE")));
+    return operand;
+  }
+  if (!trimmed.empty()) {
+    // Integers are parsed as such unless out of range, and only then as
+    // floating point numbers like all other numbers.
+    const char * number_start = trimmed.c_str();
+    char * number_end = nullptr;
+    errno = 0;
+    if ('-' == number_start[0]) {
+      const long long number = std::strtoll(number_start, &number_end, 10);  // NOLINT
+      if ('\0' == *number_end && 0 == errno) {
+        operand.kind = Kind::number;
+        operand.number = make_number(static_cast<int64_t>(number));
+        return operand;
+      }
+    } else if (std::isdigit(static_cast<unsigned char>(number_start[0])) || '+' == number_start[0]) {
+      const unsigned long long number = std::strtoull(number_start, &number_end, 10);  // NOLINT
+      if ('\0' == *number_end && 0 == errno) {
+        operand.kind = Kind::number;
+        operand.number = make_number(static_cast<uint64_t>(number));
+        return operand;
+      }
+    }
+    const double number = std::strtod(number_start, &number_end);
+    if ('\0' == *number_end) {
+      operand.kind = Kind::number;
+      operand.number = make_number(number);
+      return operand;
+    }
+  }
+  operand.kind = Kind::string;
+  operand.string = text;
+  return operand;
+}
+
+class Parser
+{
+public:
+  Parser(
+    const Members & members, const std::string & expression,
+    const std::vector<std::string> & parameters)
+  : members_(members), tokens_(tokenize(expression)), parameters_(parameters)
+  {
+  }
+
+  std::unique_ptr<Node> parse()
+  {
+    std::unique_ptr<Node> root = parse_or();
+    if (TokenType::end != peek().type) {
+      throw std::invalid_argument("unexpected '" + peek().text + "'");
+    }
+    return root;
+  }
+
+private:
+  const Token & peek() const
+  {
+    return tokens_[position_];
+  }
+
+  bool accept_keyword(const char * keyword)
+  {
+    if (TokenType::identifier == peek().type && equals_ignoring_case(peek().text, keyword)) {
+      ++position_;
+      return true;
+    }
+    return false;
+  }
+
+  std::unique_ptr<Node> make_logical_node(
+    Operation operation, std::unique_ptr<Node> left, std::unique_ptr<Node> right)
+  {
+    auto node = std::make_unique<Node>();
+    node->operation = operation;
+    node->left = std::move(left);
+    node->right = std::move(right);
+    return node;
+  }
+
+  std::unique_ptr<Node> parse_or()
+  {
+    std::unique_ptr<Node> node = parse_and();
+    while (accept_keyword("OR")) {
+      node = make_logical_node(Operation::logical_or, std::move(node), parse_and());
+    }
+    return node;
+  }
+
+  std::unique_ptr<Node> parse_and()
+  {
+    std::unique_ptr<Node> node = parse_not();
+    while (accept_keyword("AND")) {
+      node = make_logical_node(Operation::logical_and, std::move(node), parse_not());
+    }
+    return node;
+  }
+
+  std::unique_ptr<Node> parse_not()
+  {
+    if (accept_keyword("NOT")) {
+      return make_logical_node(Operation::logical_not, parse_not(), nullptr);
+    }
+    if (TokenType::left_parenthesis == peek().type) {
+      ++position_;
+      std::unique_ptr<Node> node = parse_or();
+      if (TokenType::right_parenthesis != peek().type) {
+        throw std::invalid_argument("expected ')' instead of '" + peek().text + "'");
+      }
+      ++position_;
+      return node;
+    }
+    return parse_predicate();
+  }
+
+  std::unique_ptr<Node> parse_predicate()
+  {
+    auto node = std::make_unique<Node>();
+    node->operands[0] = parse_operand();
+    const Token & token = peek();
+    if (TokenType::relational_operator == token.type) {
+      if ("=" == token.text || "==" == token.text) {
+        node->operation = Operation::equal;
+      } else if ("<>" == token.text || "!=" == token.text) {
+        node->operation = Operation::not_equal;
+      } else if ("<" == token.text) {
+        node->operation = Operation::less;
+      } else if ("<=" == token.text) {
+        node->operation = Operation::less_equal;
+      } else if (">" == token.text) {
+        node->operation = Operation::greater;
+      } else {
+        node->operation = Operation::greater_equal;
+      }
+      ++position_;
+      node->operands[1] = parse_operand();
+      check_kinds(*node, 2u);
+    } else {
+      node->negated = accept_keyword("NOT");
+      if (accept_keyword("LIKE")) {
+        node->operation = Operation::like;
+        node->operands[1] = parse_operand();
+        check_kinds(*node, 2u);
+        if (Kind::string != node->operands[0].kind) {
+          throw std::invalid_argument("LIKE applies to strings only");
+        }
+      } else if (accept_keyword("BETWEEN")) {
+        node->operation = Operation::between;
+        node->operands[1] = parse_operand();
+        if (!accept_keyword("AND")) {
+          throw std::invalid_argument("expected AND instead of '" + peek().text + "'");
+        }
+        node->operands[2] = parse_operand();
+        check_kinds(*node, 3u);
+      } else {
+        throw std::invalid_argument("expected an operator instead of '" + peek().text + "'");
+      }
+    }
+    return node;
+  }
+
+  // Check that predicate operands are of the same kind, and that at least
+  // one of them is a field.
+  void check_kinds(const Node & node, size_t operand_count)
+  {
+    bool has_field = false;
+    for (size_t i = 0u; i < operand_count; ++i) {
+      has_field = has_field || Load::literal != node.operands[i].load;
+      if (node.operands[i].kind != node.operands[0].kind) {
+        throw std::invalid_argument(
+                std::string("cannot compare a ") + get_kind_name(node.operands[0].kind) +
+                " with a " + get_kind_name(node.operands[i].kind));
+      }
+    }
+    if (!has_field) {
+      throw std::invalid_argument("predicates must refer to at least one field");
+    }
+  }
+
+  Operand parse_operand()
+  {
+    const Token token = peek();
+    ++position_;
+    switch (token.type) {
+      case TokenType::identifier:
+        if (equals_ignoring_case(token.text, "TRUE") || equals_ignoring_case(token.text, "FALSE")) {
+          return parse_literal(token.text);
+        }
+        if (is_keyword(token.text)) {
+          break;
+        }
+        return parse_field(token.text);
+      case TokenType::number:
+        return parse_literal(token.text);
+      case TokenType::string:
+        {
+          Operand operand;
+          operand.kind = Kind::string;
+          operand.string = token.text;
+          return operand;
+        }
+      case TokenType::parameter:
+        {
+          const size_t index = std::strtoul(token.text.c_str(), nullptr, 10);
+          if (index >= parameters_.size()) {
+            throw std::invalid_argument("missing parameter %" + token.text);
+          }
+          return parse_literal(parameters_[index]);
+        }
+      default:
+        break;
+    }
+    throw std::invalid_argument(
+            "expected a field, a literal or a parameter instead of '" + token.text + "'");
+  }
+
+  // Resolve fields once and for all, so that evaluation reads them at
+  // precomputed offsets instead of looking them up by name.
+  Operand parse_field(const std::string & name)
+  {
+    Operand operand;
+    Members members = members_;
+    Member member{};
+    size_t start = 0u;
+    while (start <= name.size()) {
+      const size_t end = std::min(name.find('.', start), name.size());
+      const std::string field_name = name.substr(start, end - start);
+      if (!members.message_members || !find_member(members, field_name, member)) {
+        throw std::invalid_argument("no field named '" + name + "'");
+      }
+      if (member.is_array) {
+        throw std::invalid_argument("array field '" + name + "' is not supported");
+      }
+      const bool is_last = end == name.size();
+      if (!is_last && rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE != member.type_id) {
+        throw std::invalid_argument("no field named '" + name + "'");
+      }
+      if (is_last && !get_load(member.type_id, members_.language, operand.load, operand.kind)) {
+        throw std::invalid_argument("type of field '" + name + "' is not supported");
+      }
+      operand.offset += member.offset;
+      members = member.nested;
+      start = end + 1u;
+    }
+    return operand;
+  }
+
+  const Members members_;
+  const std::vector<Token> tokens_;
+  const std::vector<std::string> & parameters_;
+  size_t position_{0u};
+};
+
+bool
+matches_like_pattern(std::string_view text, std::string_view pattern)
+{
+  // Classic wildcard matching, backtracking to the last '%' upon mismatch.
+  size_t t = 0u;
+  size_t p = 0u;
+  size_t star = std::string_view::npos;
+  size_t star_t = 0u;
+  while (t < text.size()) {
+    if (p < pattern.size() && ('_' == pattern[p] || text[t] == pattern[p])) {
+      ++t;
+      ++p;
+    } else if (p < pattern.size() && '%' == pattern[p]) {
+      star = p++;
+      star_t = t;
+    } else if (std::string_view::npos != star) {
+      p = star + 1u;
+      t = ++star_t;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && '%' == pattern[p]) {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+template<typename T>
+inline T
+load_field(const char * field)
+{
+  return *reinterpret_cast<const T *>(field);
+}
+
+// Booleans are compared as unsigned integers, and floating point numbers of
+// any precision as doubles.
+inline Number
+load_number(const Operand & operand, const char * message)
+{
+  const char * field = message + operand.offset;
+  switch (operand.load) {
+    case Load::boolean:
+      return make_number(static_cast<uint64_t>(load_field<bool>(field)));
+    case Load::float32:
+      return make_number(static_cast<double>(load_field<float>(field)));
+    case Load::float64:
+      return make_number(load_field<double>(field));
+    case Load::long_double:
+      return make_number(static_cast<double>(load_field<long double>(field)));
+    case Load::signed_char:
+      return make_number(static_cast<int64_t>(load_field<signed char>(field)));
+    case Load::unsigned_char:
+      return make_number(static_cast<uint64_t>(load_field<unsigned char>(field)));
+    case Load::uint8:
+      return make_number(static_cast<uint64_t>(load_field<uint8_t>(field)));
+    case Load::int8:
+      return make_number(static_cast<int64_t>(load_field<int8_t>(field)));
+    case Load::uint16:
+      return make_number(static_cast<uint64_t>(load_field<uint16_t>(field)));
+    case Load::int16:
+      return make_number(static_cast<int64_t>(load_field<int16_t>(field)));
+    case Load::uint32:
+      return make_number(static_cast<uint64_t>(load_field<uint32_t>(field)));
+    case Load::int32:
+      return make_number(static_cast<int64_t>(load_field<int32_t>(field)));
+    case Load::uint64:
+      return make_number(load_field<uint64_t>(field));
+    case Load::int64:
+      return make_number(load_field<int64_t>(field));
+    default:
+      return operand.number;
+  }
+}
+
+// Result of comparing two numbers, unordered if either is NaN.
+enum class Ordering : int8_t
+{
+  less = -1,
+  equal = 0,
+  greater = 1,
+  unordered = 2
+};
+
+template<typename T>
+inline Ordering
+compare(const T & left, const T & right)
+{
+  return left < right ? Ordering::less : (right < left ? Ordering::greater : Ordering::equal);
+}
+
+inline Ordering
+reverse(Ordering ordering)
+{
+  switch (ordering) {
+    case Ordering::less:
+      return Ordering::greater;
+    case Ordering::greater:
+      return Ordering::less;
+    default:
+      return ordering;
+  }
+}
+
+// Compare a floating point number with an integer without rounding the
+// latter, given the range of the integer type as [low, high).
+template<typename Integer>
+inline Ordering
+compare(double left, Integer right, double low, double high)
+{
+  if (std::isnan(left)) {
+    return Ordering::unordered;
+  }
+  if (left < low) {
+    return Ordering::less;
+  }
+  if (left >= high) {
+    return Ordering::greater;
+  }
+  // Truncation is exact in range, and so is the conversion back.
+  const Integer truncated = static_cast<Integer>(left);
+  if (truncated != right) {
+    return compare(truncated, right);
+  }
+  return compare(left, static_cast<double>(truncated));
+}
+
+inline Ordering
+compare(double left, int64_t right)
+{
+  return compare(left, right, -9223372036854775808.0, 9223372036854775808.0);
+}
+
+inline Ordering
+compare(double left, uint64_t right)
+{
+  return compare(left, right, 0.0, 18446744073709551616.0);
+}
+
+inline Ordering
+compare(int64_t left, uint64_t right)
+{
+  return left < 0 ? Ordering::less : compare(static_cast<uint64_t>(left), right);
+}
+
+inline Ordering
+compare_numbers(const Number & left, const Number & right)
+{
+  using Type = Number::Type;
+  switch (left.type) {
+    case Type::signed_integer:
+      switch (right.type) {
+        case Type::signed_integer:
+          return compare(left.signed_integer, right.signed_integer);
+        case Type::unsigned_integer:
+          return compare(left.signed_integer, right.unsigned_integer);
+        default:
+          return reverse(compare(right.floating_point, left.signed_integer));
+      }
+    case Type::unsigned_integer:
+      switch (right.type) {
+        case Type::signed_integer:
+          return reverse(compare(right.signed_integer, left.unsigned_integer));
+        case Type::unsigned_integer:
+          return compare(left.unsigned_integer, right.unsigned_integer);
+        default:
+          return reverse(compare(right.floating_point, left.unsigned_integer));
+      }
+    default:
+      switch (right.type) {
+        case Type::signed_integer:
+          return compare(left.floating_point, right.signed_integer);
+        case Type::unsigned_integer:
+          return compare(left.floating_point, right.unsigned_integer);
+        default:
+          if (std::isnan(left.floating_point) || std::isnan(right.floating_point)) {
+            return Ordering::unordered;
+          }
+          return compare(left.floating_point, right.floating_point);
+      }
+  }
+}
+
+inline bool
+evaluate_comparison(Operation operation, Ordering ordering)
+{
+  switch (operation) {
+    case Operation::equal:
+      return Ordering::equal == ordering;
+    case Operation::not_equal:
+      return Ordering::equal != ordering;
+    case Operation::less:
+      return Ordering::less == ordering;
+    case Operation::less_equal:
+      return Ordering::less == ordering || Ordering::equal == ordering;
+    case Operation::greater:
+      return Ordering::greater == ordering;
+    default:
+      return Ordering::greater == ordering || Ordering::equal == ordering;
+  }
+}
+
+inline std::string_view
+load_string(const Operand & operand, const char * message)
+{
+  const char * field = message + operand.offset;
+  switch (operand.load) {
+    case Load::c_string:
+      {
+        const auto string = reinterpret_cast<const rosidl_runtime_c__String *>(field);
+        return std::string_view(string->data ? string->data : "", string->size);
+      }
+    case Load::cpp_string:
+      return *reinterpret_cast<const std::string *>(field);
+    default:
+      return operand.string;
+  }
+}
+
+// A predicate, with operands of the same kind.
+struct Predicate
+{
+  Operation operation{Operation::equal};
+  bool negated{false};
+  Kind kind{Kind::number};
+  Operand operands[3];
+};
+
+enum class OpCode : uint8_t
+{
+  // Evaluate the predicate at the given index into the result register.
+  test,
+  // Jump to the given instruction if the result is false, or true.
+  jump_if_false,
+  jump_if_true,
+  // Negate the result.
+  negate
+};
+
+struct Instruction
+{
+  OpCode op_code;
+  uint32_t argument;
+};
+
+template<typename T>
+inline bool
+evaluate_comparison(Operation operation, const T & left, const T & right)
+{
+  switch (operation) {
+    case Operation::equal:
+      return left == right;
+    case Operation::not_equal:
+      return left != right;
+    case Operation::less:
+      return left < right;
+    case Operation::less_equal:
+      return left <= right;
+    case Operation::greater:
+      return left > right;
+    default:
+      return left >= right;
+  }
+}
+
+inline bool
+evaluate_predicate(const Predicate & predicate, const char * message)
+{
+  if (Kind::string == predicate.kind) {
+    const std::string_view left = load_string(predicate.operands[0], message);
+    const std::string_view right = load_string(predicate.operands[1], message);
+    if (Operation::like == predicate.operation) {
+      return predicate.negated != matches_like_pattern(left, right);
+    }
+    if (Operation::between == predicate.operation) {
+      const std::string_view high = load_string(predicate.operands[2], message);
+      return predicate.negated != (left >= right && left <= high);
+    }
+    return evaluate_comparison(predicate.operation, left, right);
+  }
+  const Number left = load_number(predicate.operands[0], message);
+  const Number right = load_number(predicate.operands[1], message);
+  if (Operation::between == predicate.operation) {
+    const Number high = load_number(predicate.operands[2], message);
+    return predicate.negated != (
+      evaluate_comparison(Operation::greater_equal, compare_numbers(left, right)) &&
+      evaluate_comparison(Operation::less_equal, compare_numbers(left, high)));
+  }
+  return evaluate_comparison(predicate.operation, compare_numbers(left, right));
+}
+
+}  // namespace
+
+// Expressions are compiled into a flat program over a table of predicates,
+// in which AND and OR short-circuit through conditional jumps, so that
+// evaluating them involves neither recursion nor field lookups.
+struct ContentFilter::Impl
+{
+  void compile(Node & node)
+  {
+    switch (node.operation) {
+      case Operation::logical_and:
+      case Operation::logical_or:
+        {
+          compile(*node.left);
+          const OpCode op_code = Operation::logical_and == node.operation ?
+            OpCode::jump_if_false : OpCode::jump_if_true;
+          const size_t jump = program.size();
+          program.push_back({op_code, 0u});
+          compile(*node.right);
+          program[jump].argument = static_cast<uint32_t>(program.size());
+          break;
+        }
+      case Operation::logical_not:
+        compile(*node.left);
+        program.push_back({OpCode::negate, 0u});
+        break;
+      default:
+        {
+          program.push_back({OpCode::test, static_cast<uint32_t>(predicates.size())});
+          Predicate & predicate = predicates.emplace_back();
+          predicate.operation = node.operation;
+          predicate.negated = node.negated;
+          predicate.kind = node.operands[0].kind;
+          for (size_t i = 0u; i < 3u; ++i) {
+            predicate.operands[i] = std::move(node.operands[i]);
+          }
+          break;
+        }
+    }
+  }
+
+  bool evaluate(const char * message) const
+  {
+    bool result = false;
+    const size_t size = program.size();
+    for (size_t pc = 0u; pc < size; ) {
+      const Instruction & instruction = program[pc++];
+      switch (instruction.op_code) {
+        case OpCode::test:
+          result = evaluate_predicate(predicates[instruction.argument], message);
+          break;
+        case OpCode::jump_if_false:
+          if (!result) {
+            pc = instruction.argument;
+          }
+          break;
+        case OpCode::jump_if_true:
+          if (result) {
+            pc = instruction.argument;
+          }
+          break;
+        case OpCode::negate:
+          result = !result;
+          break;
+      }
+    }
+    return result;
+  }
+
+  std::vector<Predicate> predicates;
+  std::vector<Instruction> program;
+};
+
+ContentFilter::ContentFilter(
+  const rosidl_message_type_support_t * type_support,
+  const std::string & expression,
+  const std::vector<std::string> & parameters)
+: expression_(expression), parameters_(parameters), impl_(std::make_unique<Impl>())
+{
+  if (!type_support) {
+    throw std::invalid_argument("message type support is null");
+  }
+  std::unique_ptr<Node> root = Parser(get_members(type_support), expression, parameters).parse();
+  impl_->compile(*root);
+}
+
+ContentFilter::~ContentFilter() = default;
+
+bool
+ContentFilter::matches(const void * message) const
+{
+  return impl_->evaluate(static_cast<const char *>(message));
+}
+
+ContentFilterFallback
+get_requested_content_filter_fallback()
+{
+  std::string value;
+  try {
+    value = rcpputils::get_env_var("RMW_IMPLEMENTATION_CONTENT_FILTER_FALLBACK");
+  } catch (const std::exception &) {
+    return ContentFilterFallback::disabled;
+  }
+  if ("1" == value) {
+    return ContentFilterFallback::when_unsupported;
+  }
+  if ("always" == value) {
+    return ContentFilterFallback::always;
+  }
+  return ContentFilterFallback::disabled;
+}
+
+namespace
+{
+
+struct FilterableSubscription
+{
+  const rosidl_message_type_support_t * type_support;
+  std::shared_ptr<const ContentFilter> filter;
+};
+
+struct Registry
+{
+  std::mutex mutex;
+  std::unordered_map<const rmw_subscription_t *, FilterableSubscription> subscriptions;
+};
+
+Registry &
+get_registry()
+{
+  // Never destroyed, as subscriptions may outlive static destruction.
+  static Registry * registry = new Registry();
+  return *registry;
+}
+
+// Number of subscriptions with a content filter, letting takes on other
+// subscriptions skip the registry while there are none.
+std::atomic<size_t> g_filter_count{0u};
+
+}  // namespace
+
+void
+register_filterable_subscription(
+  const rmw_subscription_t * subscription, const rosidl_message_type_support_t * type_support)
+{
+  Registry & registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  try {
+    registry.subscriptions[subscription] = {type_support, nullptr};
+  } catch (const std::bad_alloc &) {
+    // content filters will be left to the RMW implementation
+  }
+}
+
+void
+unregister_filterable_subscription(const rmw_subscription_t * subscription)
+{
+  Registry & registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.subscriptions.find(subscription);
+  if (it == registry.subscriptions.end()) {
+    return;
+  }
+  if (it->second.filter) {
+    g_filter_count.fetch_sub(1u, std::memory_order_relaxed);
+  }
+  registry.subscriptions.erase(it);
+}
+
+bool
+is_filterable_subscription(const rmw_subscription_t * subscription)
+{
+  Registry & registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  return registry.subscriptions.count(subscription) != 0u;
+}
+
+rmw_ret_t
+set_fallback_content_filter(
+  rmw_subscription_t * subscription, const rmw_subscription_content_filter_options_t * options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(options, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(options->filter_expression, RMW_RET_INVALID_ARGUMENT);
+
+  Registry & registry = get_registry();
+  const rosidl_message_type_support_t * type_support = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.subscriptions.find(subscription);
+    if (it == registry.subscriptions.end()) {
+      RMW_SET_ERROR_MSG("subscription is unknown");
+      return RMW_RET_INVALID_ARGUMENT;
+    }
+    type_support = it->second.type_support;
+  }
+
+  std::shared_ptr<const ContentFilter> filter;
+  if ('\0' != options->filter_expression[0]) {
+    try {
+      std::vector<std::string> parameters;
+      const rcutils_string_array_t & expression_parameters = options->expression_parameters;
+      for (size_t i = 0u; i < expression_parameters.size; ++i) {
+        const char * parameter = expression_parameters.data[i];
+        parameters.emplace_back(parameter ? parameter : "");
+      }
+      filter = std::make_shared<const ContentFilter>(
+        type_support, options->filter_expression, parameters);
+    } catch (const std::invalid_argument & e) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING("invalid content filter: %s", e.what());
+      return RMW_RET_INVALID_ARGUMENT;
+    } catch (const std::bad_alloc &) {
+      RMW_SET_ERROR_MSG("failed to allocate content filter");
+      return RMW_RET_BAD_ALLOC;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.subscriptions.find(subscription);
+    if (it == registry.subscriptions.end()) {
+      RMW_SET_ERROR_MSG("subscription is unknown");
+      return RMW_RET_INVALID_ARGUMENT;
+    }
+    if (filter && !it->second.filter) {
+      g_filter_count.fetch_add(1u, std::memory_order_relaxed);
+    } else if (!filter && it->second.filter) {
+      g_filter_count.fetch_sub(1u, std::memory_order_relaxed);
+    }
+    it->second.filter = filter;
+  }
+  subscription->is_cft_enabled = static_cast<bool>(filter);
+  return RMW_RET_OK;
+}
+
+std::shared_ptr<const ContentFilter>
+get_fallback_content_filter(const rmw_subscription_t * subscription)
+{
+  // Content filters are always flagged on subscriptions they are set on, so
+  // that takes on any other subscription never get to the registry.
+  if (!subscription || !subscription->is_cft_enabled) {
+    return nullptr;
+  }
+  if (0u == g_filter_count.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  Registry & registry = get_registry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto it = registry.subscriptions.find(subscription);
+  return it != registry.subscriptions.end() ? it->second.filter : nullptr;
+}
+
+rmw_ret_t
+get_fallback_content_filter_options(
+  const rmw_subscription_t * subscription,
+  rcutils_allocator_t * allocator,
+  rmw_subscription_content_filter_options_t * options)
+{
+  std::shared_ptr<const ContentFilter> filter = get_fallback_content_filter(subscription);
+  if (!filter) {
+    return RMW_RET_UNSUPPORTED;
+  }
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator argument is invalid", return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(options, RMW_RET_INVALID_ARGUMENT);
+
+  std::vector<const char *> parameters;
+  try {
+    for (const std::string & parameter : filter->parameters()) {
+      parameters.push_back(parameter.c_str());
+    }
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate content filter parameters");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return rmw_subscription_content_filter_options_init(
+    filter->expression().c_str(), parameters.size(), parameters.data(), allocator, options);
+}
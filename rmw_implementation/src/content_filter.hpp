@@ -0,0 +1,146 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CONTENT_FILTER_HPP_
+#define CONTENT_FILTER_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rcutils/allocator.h"
+
+#include "rmw/subscription_content_filter_options.h"
+#include "rmw/types.h"
+
+#include "rosidl_runtime_c/message_type_support_struct.h"
+
+#include "rmw_implementation/visibility_control.h"
+
+// Content filters are evaluated against taken messages on behalf of RMW
+// implementations that do not support content filtering, when the
+// RMW_IMPLEMENTATION_CONTENT_FILTER_FALLBACK environment variable is set to 1
+// by the time the RMW implementation is loaded, or on behalf of all RMW
+// implementations when it is set to "always".
+// Filtered out messages are dropped upon rmw_take(), rmw_take_with_info()
+// and rmw_take_sequence(), whereas loaned and serialized messages are handed
+// over unfiltered.
+
+/// How content filters are to be evaluated by this library.
+enum class ContentFilterFallback
+{
+  /// Leave content filtering to the RMW implementation.
+  disabled,
+  /// Evaluate content filters the RMW implementation does not support.
+  when_unsupported,
+  /// Evaluate all content filters.
+  always
+};
+
+/// Get how content filters are to be evaluated, as requested via the environment.
+ContentFilterFallback
+get_requested_content_filter_fallback();
+
+/// A filter expression, evaluated against messages of a given type.
+/**
+ * Expressions follow the grammar of DDS content filtered topics:
+ * predicates comparing message fields to literals, expression parameters or
+ * other fields using `=`, `<>`, `!=`, `<`, `<=`, `>` and `>=`, `LIKE`
+ * patterns and `BETWEEN` ranges, combined with `AND`, `OR`, `NOT` and
+ * parentheses.
+ * Fields of nested messages are referred to as `field.nested_field`.
+ * Only scalar boolean, numeric and string fields are supported.
+ *
+ * Expressions are compiled along with their parameters upon construction,
+ * resolving fields to offsets into messages, so that evaluating them reads
+ * fields directly.
+ */
+class ContentFilter
+{
+public:
+  /// Parse an expression for messages of the given type.
+  /**
+   * \throws std::invalid_argument if the expression is malformed, refers to
+   *   unsupported fields or missing parameters, or if the type support does
+   *   not provide introspection.
+   */
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  ContentFilter(
+    const rosidl_message_type_support_t * type_support,
+    const std::string & expression,
+    const std::vector<std::string> & parameters);
+
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  ~ContentFilter();
+
+  /// Check whether a message passes the filter.
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  bool
+  matches(const void * message) const;
+
+  const std::string & expression() const
+  {
+    return expression_;
+  }
+
+  const std::vector<std::string> & parameters() const
+  {
+    return parameters_;
+  }
+
+  struct Impl;
+
+private:
+  std::string expression_;
+  std::vector<std::string> parameters_;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// Keep track of a subscription, for content filters to be set on it later.
+void
+register_filterable_subscription(
+  const rmw_subscription_t * subscription, const rosidl_message_type_support_t * type_support);
+
+/// Forget about a subscription, along with its content filter.
+void
+unregister_filterable_subscription(const rmw_subscription_t * subscription);
+
+/// Check whether a subscription is kept track of.
+bool
+is_filterable_subscription(const rmw_subscription_t * subscription);
+
+/// Set or, given an empty expression, reset the content filter of a subscription.
+rmw_ret_t
+set_fallback_content_filter(
+  rmw_subscription_t * subscription, const rmw_subscription_content_filter_options_t * options);
+
+/// Get the content filter of a subscription, if any.
+/**
+ * Subscriptions with no content filter enabled are answered without any
+ * lookup nor locking.
+ */
+std::shared_ptr<const ContentFilter>
+get_fallback_content_filter(const rmw_subscription_t * subscription);
+
+/// Copy the expression and parameters of the content filter of a subscription.
+/**
+ * \return `RMW_RET_UNSUPPORTED` if the subscription has no content filter.
+ */
+rmw_ret_t
+get_fallback_content_filter_options(
+  const rmw_subscription_t * subscription,
+  rcutils_allocator_t * allocator,
+  rmw_subscription_content_filter_options_t * options);
+
+#endif  // CONTENT_FILTER_HPP_
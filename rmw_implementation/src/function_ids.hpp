@@ -0,0 +1,33 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef FUNCTION_IDS_HPP_
+#define FUNCTION_IDS_HPP_
+
+#include <cstddef>
+
+/// Index of every function listed in rmw_interface.def.
+enum FunctionId : size_t
+{
+#define RMW_INTERFACE_FN(name, ...) function_id_ ## name,
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+  function_count
+};
+
+/// Get the name of a function given its index.
+const char *
+get_function_name(size_t function_id);
+
+#endif  // FUNCTION_IDS_HPP_
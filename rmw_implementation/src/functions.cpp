@@ -14,11 +14,27 @@
 
 #include "functions.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <condition_variable>
 #include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "ament_index_cpp/get_resources.hpp"
 
@@ -40,47 +56,133 @@
 #include "rmw/names_and_types.h"
 #include "rmw/rmw.h"
 
+#include "rmw_implementation/publish_batch.h"
+
+#include "./call_statistics.hpp"
+#include "./content_filter.hpp"
+#include "./function_ids.hpp"
+#include "./graph_cache.hpp"
+#include "./handle_registry.hpp"
+#include "./load_cache.hpp"
+#include "./routing.hpp"
+#include "./tracepoints.hpp"
+
 #define STRINGIFY_(s) #s
 #define STRINGIFY(s) STRINGIFY_(s)
 
 static std::shared_ptr<rcpputils::SharedLibrary> g_rmw_lib = nullptr;
 
+static std::shared_ptr<rcpputils::SharedLibrary>
+attempt_to_load_one_library(const std::string & library_name)
+{
+  std::shared_ptr<rcpputils::SharedLibrary> ret = nullptr;
+
+  try {
+    ret = std::make_shared<rcpputils::SharedLibrary>(library_name);
+  } catch (const std::exception & e) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to load shared library '%s' due to %s",
+      library_name.c_str(), e.what());
+    ret = nullptr;
+  }
+
+  return ret;
+}
+
 static std::shared_ptr<rcpputils::SharedLibrary>
 attempt_to_load_one_rmw(const std::string & library)
 {
   std::string library_name;
-  std::shared_ptr<rcpputils::SharedLibrary> ret = nullptr;
 
   try {
     library_name = rcpputils::get_platform_library_name(library);
   } catch (const std::exception & e) {
     RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
       "failed to compute shared library name due to %s", e.what());
-    return ret;
+    return nullptr;
   }
 
+  return attempt_to_load_one_library(library_name);
+}
+
+// Look for the shared library of an RMW implementation in its install prefix,
+// returning its path if found or an empty string otherwise.
+static std::string
+find_rmw_library(const std::string & library, const std::string & prefix)
+{
   try {
-    ret = std::make_shared<rcpputils::SharedLibrary>(library_name);
-  } catch (const std::exception & e) {
-    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
-      "failed to load shared library '%s' due to %s",
-      library_name.c_str(), e.what());
-    ret = nullptr;
+#ifdef _WIN32
+    const char * library_directory = "bin";
+#else
+    const char * library_directory = "lib";
+#endif
+    const std::filesystem::path library_path =
+      std::filesystem::path(prefix) / library_directory /
+      rcpputils::get_platform_library_name(library);
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(library_path, ec)) {
+      return library_path.string();
+    }
+  } catch (const std::exception &) {
   }
+  return {};
+}
 
-  return ret;
+// Load any RMW available but the default one.
+static std::shared_ptr<rcpputils::SharedLibrary>
+search_and_load_rmw(const std::string & default_rmw_implementation)
+{
+  std::shared_ptr<rcpputils::SharedLibrary> ret;
+  const std::map<std::string, std::string> packages_with_prefixes = ament_index_cpp::get_resources(
+    "rmw_typesupport");
+  for (const auto & package_prefix_pair : packages_with_prefixes) {
+    // rmw_loopback_cpp talks to nothing outside this process, so it is only
+    // loaded when requested explicitly.
+    if (
+      package_prefix_pair.first == "rmw_implementation" ||
+      package_prefix_pair.first == "rmw_loopback_cpp" ||
+      package_prefix_pair.first == default_rmw_implementation)
+    {
+      continue;
+    }
+    const std::string library_path =
+      find_rmw_library(package_prefix_pair.first, package_prefix_pair.second);
+    if (!library_path.empty()) {
+      ret = attempt_to_load_one_library(library_path);
+    } else {
+      // not where expected, let the dynamic loader search for it
+      ret = attempt_to_load_one_rmw(package_prefix_pair.first);
+    }
+    if (ret != nullptr) {
+      return ret;
+    }
+    rmw_reset_error();
+  }
+
+  // If we made it here, we couldn't find an rmw to load.
+
+  RMW_SET_ERROR_MSG("failed to load any RMW implementations");
+
+  return nullptr;
 }
 
 std::shared_ptr<rcpputils::SharedLibrary>
-load_library()
+load_library(const std::string & default_rmw_implementation)
 {
   // The logic to pick the RMW library to load goes as follows:
   //
   // 1. If the user specified the library to use via the RMW_IMPLEMENTATION
   //    environment variable, try to load only that library.
   // 2. Otherwise, try to load the default RMW implementation.
-  // 3. If that fails, try loading all other implementations available in turn
-  //    until one succeeds or we run out of options.
+  // 3. If that fails and the load cache is enabled, try to load the library
+  //    that was loaded instead last time, from the same environment.
+  // 4. Otherwise, try loading all other implementations available in turn
+  //    until one succeeds or we run out of options, and record the one that
+  //    does in the load cache.
+  //
+  // As the default RMW implementation is always tried first, the load cache
+  // never keeps a fallback on once the default becomes loadable again, and
+  // costs nothing while it is loadable.
 
   std::string env_var;
   try {
@@ -97,34 +199,42 @@ load_library()
     return attempt_to_load_one_rmw(env_var);
   }
 
-  // User didn't specify, so next try to load the default RMW
-  std::shared_ptr<rcpputils::SharedLibrary> ret;
-
-  ret = attempt_to_load_one_rmw(STRINGIFY(DEFAULT_RMW_IMPLEMENTATION));
+  // User didn't specify, so try the default RMW
+  std::shared_ptr<rcpputils::SharedLibrary> ret =
+    attempt_to_load_one_rmw(default_rmw_implementation);
   if (ret != nullptr) {
     return ret;
   }
-
-  // OK, we failed to load the default RMW.  Fetch all of the ones we can
-  // find and attempt to load them one-by-one.
   rmw_reset_error();
-  const std::map<std::string, std::string> packages_with_prefixes = ament_index_cpp::get_resources(
-    "rmw_typesupport");
-  for (const auto & package_prefix_pair : packages_with_prefixes) {
-    if (package_prefix_pair.first != "rmw_implementation") {
-      ret = attempt_to_load_one_rmw(package_prefix_pair.first);
-      if (ret != nullptr) {
-        return ret;
-      }
-      rmw_reset_error();
+
+  // OK, we failed to load the default RMW.  Try the one that was loaded in
+  // its stead last time, if any.
+  const std::string cache_key = compute_load_cache_key(default_rmw_implementation);
+  const std::string cached_library_path = lookup_load_cache(cache_key);
+  if (!cached_library_path.empty()) {
+    ret = attempt_to_load_one_library(cached_library_path);
+    if (ret != nullptr) {
+      return ret;
     }
+    rmw_reset_error();
   }
 
-  // If we made it here, we couldn't find an rmw to load.
-
-  RMW_SET_ERROR_MSG("failed to load any RMW implementations");
+  // Fetch all of the ones we can find and attempt to load them one-by-one.
+  ret = search_and_load_rmw(default_rmw_implementation);
+  if (ret != nullptr) {
+    try {
+      update_load_cache(cache_key, ret->get_library_path());
+    } catch (const std::exception &) {
+      // the cache is only an optimization
+    }
+  }
+  return ret;
+}
 
-  return nullptr;
+std::shared_ptr<rcpputils::SharedLibrary>
+load_library()
+{
+  return load_library(STRINGIFY(DEFAULT_RMW_IMPLEMENTATION));
 }
 
 std::shared_ptr<rcpputils::SharedLibrary>
@@ -175,11 +285,6 @@ get_symbol(const char * symbol_name)
   }
 }
 
-#ifdef __cplusplus
-extern "C"
-{
-#endif
-
 #define EXPAND(x) x
 
 #define ARG_TYPES(...) __VA_ARGS__
@@ -202,805 +307,2477 @@ extern "C"
 #define ARGS_6(t6, ...) t6 v6, EXPAND(ARGS_5(__VA_ARGS__))
 #define ARGS_7(t7, ...) t7 v7, EXPAND(ARGS_6(__VA_ARGS__))
 
-#define CALL_SYMBOL(symbol_name, ReturnType, error_value, ArgTypes, arg_values) \
-  if (!symbol_ ## symbol_name) { \
-    /* only necessary for functions called before rmw_init */ \
-    symbol_ ## symbol_name = get_symbol(#symbol_name); \
-  } \
-  if (!symbol_ ## symbol_name) { \
-    /* error message set by get_symbol() */ \
+#define FIRST_ARG_VALUE_0
+#define FIRST_ARG_VALUE_1 v1
+#define FIRST_ARG_VALUE_2 v2
+#define FIRST_ARG_VALUE_3 v3
+#define FIRST_ARG_VALUE_4 v4
+#define FIRST_ARG_VALUE_5 v5
+#define FIRST_ARG_VALUE_6 v6
+#define FIRST_ARG_VALUE_7 v7
+
+// Assumed size of a cache line, used to keep the dispatch table from sharing
+// a line with unrelated and possibly frequently written data.
+static constexpr size_t cache_line_size = 64;
+
+// Entry points of the loaded RMW implementation, one per function listed
+// in rmw_interface.def.
+struct alignas(cache_line_size) DispatchTable
+{
+// cppcheck-suppress preprocessorErrorDirective
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  ReturnType (* name)(__VA_ARGS__);
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+static const DispatchTable * resolve_dispatch_table();
+
+// Entry points used until the dispatch table has been resolved, e.g. for
+// functions called before rmw_init(). They resolve the whole table and then
+// forward the call.
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  static ReturnType lazy_ ## name(EXPAND(ARGS_ ## _NR(__VA_ARGS__))) \
+  { \
+    const DispatchTable * table = resolve_dispatch_table(); \
+    if (!table) { \
+      /* error message set by resolve_dispatch_table() */ \
+      return error_value; \
+    } \
+    return table->name(EXPAND(ARG_VALUES_ ## _NR(__VA_ARGS__))); \
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+
+// Entry points used for functions the loaded RMW implementation lacks.
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  static ReturnType unresolved_ ## name(__VA_ARGS__) \
+  { \
+    /* sets the error message */ \
+    get_symbol(#name); \
     return error_value; \
-  } \
-  typedef ReturnType (* FunctionSignature)(ArgTypes); \
-  FunctionSignature func = reinterpret_cast<FunctionSignature>(symbol_ ## symbol_name); \
-  return func(arg_values);
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
 
-// cppcheck-suppress preprocessorErrorDirective
+// Error messages for functions the loaded RMW implementation lacks, formatted
+// upon resolution when binding all functions up front.
+static std::array<std::string, function_count> g_missing_function_errors;
+
+// Entry points used instead of the above when binding all functions up front,
+// so that calls to missing functions do not format any error message.
 #define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
-  void * symbol_ ## name = nullptr; \
-  ReturnType name(EXPAND(ARGS_ ## _NR(__VA_ARGS__))) \
+  static ReturnType missing_ ## name(__VA_ARGS__) \
   { \
-    CALL_SYMBOL( \
-      name, ReturnType, error_value, ARG_TYPES(__VA_ARGS__), \
-      EXPAND(ARG_VALUES_ ## _NR(__VA_ARGS__))); \
+    RMW_SET_ERROR_MSG(g_missing_function_errors[function_id_ ## name].c_str()); \
+    return error_value; \
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+
+static const DispatchTable g_lazy_dispatch_table = {
+#define RMW_INTERFACE_FN(name, ...) lazy_ ## name,
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+static const DispatchTable g_unresolved_dispatch_table = {
+#define RMW_INTERFACE_FN(name, ...) unresolved_ ## name,
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+static const DispatchTable g_missing_dispatch_table = {
+#define RMW_INTERFACE_FN(name, ...) missing_ ## name,
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+static DispatchTable g_resolved_dispatch_table;
+
+// Entry points of the loaded RMW implementation replaced in the resolved
+// dispatch table when caching graph queries.
+static DispatchTable g_uncached_dispatch_table;
+
+// Entry points used for functions changing the graph when caching graph
+// queries, invalidating cached results.
+template<typename FunctionT, FunctionT DispatchTable::* entry>
+struct GraphChangingEntryPoint;
+
+template<
+  typename ReturnType, typename ... Args,
+  ReturnType(* DispatchTable::* entry)(Args...)>
+struct GraphChangingEntryPoint<ReturnType (*)(Args...), entry>
+{
+  static ReturnType call(Args... args)
+  {
+    ReturnType ret = (g_uncached_dispatch_table.*entry)(args...);
+    invalidate_graph_cache();
+    return ret;
   }
+};
 
-RMW_INTERFACE_FN(
-  rmw_get_implementation_identifier,
-  const char *, nullptr,
-  0, ARG_TYPES(void))
-
-RMW_INTERFACE_FN(
-  rmw_init_options_init,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(rmw_init_options_t *, rcutils_allocator_t))
-
-RMW_INTERFACE_FN(
-  rmw_init_options_copy,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_init_options_t *, rmw_init_options_t *))
-
-RMW_INTERFACE_FN(
-  rmw_init_options_fini,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_init_options_t *))
-
-RMW_INTERFACE_FN(
-  rmw_shutdown,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_context_t *))
-
-RMW_INTERFACE_FN(
-  rmw_context_fini,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_context_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_serialization_format,
-  const char *, nullptr,
-  0, ARG_TYPES(void))
-
-RMW_INTERFACE_FN(
-  rmw_create_node,
-  rmw_node_t *, nullptr,
-  3, ARG_TYPES(
-    rmw_context_t *, const char *, const char *))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_node,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_node_t *))
-
-RMW_INTERFACE_FN(
-  rmw_node_get_graph_guard_condition,
-  const rmw_guard_condition_t *, nullptr,
-  1, ARG_TYPES(const rmw_node_t *))
-
-RMW_INTERFACE_FN(
-  rmw_init_publisher_allocation,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rosidl_message_type_support_t *,
-    const rosidl_runtime_c__Sequence__bound *,
-    rmw_publisher_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_fini_publisher_allocation,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_publisher_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_create_publisher,
-  rmw_publisher_t *, nullptr,
-  5, ARG_TYPES(
-    const rmw_node_t *, const rosidl_message_type_support_t *, const char *,
-    const rmw_qos_profile_t *, const rmw_publisher_options_t *))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_publisher,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(rmw_node_t *, rmw_publisher_t *))
-
-RMW_INTERFACE_FN(
-  rmw_borrow_loaned_message,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rmw_publisher_t *,
-    const rosidl_message_type_support_t *,
-    void **))
-
-RMW_INTERFACE_FN(
-  rmw_return_loaned_message_from_publisher,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_publisher_t *, void *))
-
-RMW_INTERFACE_FN(
-  rmw_publish,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_publisher_t *, const void *, rmw_publisher_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_publish_loaned_message,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_publisher_t *, void *, rmw_publisher_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_publisher_count_matched_subscriptions,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_publisher_t *, size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_publisher_get_actual_qos,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_publisher_t *, rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_publisher_event_init,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(rmw_event_t *, const rmw_publisher_t *, rmw_event_type_t))
-
-RMW_INTERFACE_FN(
-  rmw_publish_serialized_message,
-  rmw_ret_t, RMW_RET_ERROR,
-  3,
-  ARG_TYPES(
-    const rmw_publisher_t *, const rmw_serialized_message_t *,
-    rmw_publisher_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_serialized_message_size,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rosidl_message_type_support_t *,
-    const rosidl_runtime_c__Sequence__bound *,
-    size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_publisher_assert_liveliness,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(const rmw_publisher_t *))
-
-RMW_INTERFACE_FN(
-  rmw_publisher_wait_for_all_acked,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_publisher_t *, rmw_time_t))
-
-RMW_INTERFACE_FN(
-  rmw_serialize,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const void *, const rosidl_message_type_support_t *, rmw_serialized_message_t *))
-
-RMW_INTERFACE_FN(
-  rmw_deserialize,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_serialized_message_t *, const rosidl_message_type_support_t *, void *))
-
-RMW_INTERFACE_FN(
-  rmw_init_subscription_allocation,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rosidl_message_type_support_t *,
-    const rosidl_runtime_c__Sequence__bound *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_fini_subscription_allocation,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_create_subscription,
-  rmw_subscription_t *, nullptr,
-  5, ARG_TYPES(
-    const rmw_node_t *, const rosidl_message_type_support_t *, const char *,
-    const rmw_qos_profile_t *, const rmw_subscription_options_t *))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_subscription,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(rmw_node_t *, rmw_subscription_t *))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_count_matched_publishers,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_subscription_t *, size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_get_actual_qos,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_subscription_t *, rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_event_init,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(rmw_event_t *, const rmw_subscription_t *, rmw_event_type_t))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_set_content_filter,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(
-    rmw_subscription_t *, const rmw_subscription_content_filter_options_t *))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_get_content_filter,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rmw_subscription_t *, rcutils_allocator_t *,
-    rmw_subscription_content_filter_options_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(const rmw_subscription_t *, void *, bool *, rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_sequence,
-  rmw_ret_t, RMW_RET_ERROR,
-  6, ARG_TYPES(
-    const rmw_subscription_t *, size_t, rmw_message_sequence_t *,
-    rmw_message_info_sequence_t *, size_t *, rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_with_info,
-  rmw_ret_t, RMW_RET_ERROR,
-  5,
-  ARG_TYPES(
-    const rmw_subscription_t *, void *, bool *, rmw_message_info_t *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_serialized_message,
-  rmw_ret_t, RMW_RET_ERROR,
-  4,
-  ARG_TYPES(
-    const rmw_subscription_t *, rmw_serialized_message_t *, bool *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_serialized_message_with_info,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_subscription_t *, rmw_serialized_message_t *, bool *, rmw_message_info_t *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_loaned_message,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(
-    const rmw_subscription_t *, void **, bool *, rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_loaned_message_with_info,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_subscription_t *, void **, bool *, rmw_message_info_t *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_return_loaned_message_from_subscription,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_subscription_t *, void *))
-
-RMW_INTERFACE_FN(
-  rmw_create_client,
-  rmw_client_t *, nullptr,
-  4, ARG_TYPES(
-    const rmw_node_t *, const rosidl_service_type_support_t *, const char *,
-    const rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_client,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(rmw_node_t *, rmw_client_t *))
-
-RMW_INTERFACE_FN(
-  rmw_send_request,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_client_t *, const void *, int64_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_response,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(const rmw_client_t *, rmw_service_info_t *, void *, bool *))
-
-RMW_INTERFACE_FN(
-  rmw_client_request_publisher_get_actual_qos,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_client_t *, rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_client_response_subscription_get_actual_qos,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_client_t *, rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_create_service,
-  rmw_service_t *, nullptr,
-  4, ARG_TYPES(
-    const rmw_node_t *, const rosidl_service_type_support_t *, const char *,
-    const rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_service,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(rmw_node_t *, rmw_service_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_request,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(const rmw_service_t *, rmw_service_info_t *, void *, bool *))
-
-RMW_INTERFACE_FN(
-  rmw_send_response,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_service_t *, rmw_request_id_t *, void *))
-
-RMW_INTERFACE_FN(
-  rmw_service_response_publisher_get_actual_qos,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_service_t *, rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_service_request_subscription_get_actual_qos,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_service_t *, rmw_qos_profile_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_event,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_event_t *, void *, bool *))
-
-RMW_INTERFACE_FN(
-  rmw_create_guard_condition,
-  rmw_guard_condition_t *, nullptr,
-  1, ARG_TYPES(rmw_context_t *))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_guard_condition,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_guard_condition_t *))
-
-RMW_INTERFACE_FN(
-  rmw_trigger_guard_condition,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(const rmw_guard_condition_t *))
-
-RMW_INTERFACE_FN(
-  rmw_create_wait_set,
-  rmw_wait_set_t *, nullptr,
-  2, ARG_TYPES(rmw_context_t *, size_t))
-
-RMW_INTERFACE_FN(
-  rmw_destroy_wait_set,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_wait_set_t *))
-
-RMW_INTERFACE_FN(
-  rmw_wait,
-  rmw_ret_t, RMW_RET_ERROR,
-  7, ARG_TYPES(
-    rmw_subscriptions_t *, rmw_guard_conditions_t *, rmw_services_t *, rmw_clients_t *,
-    rmw_events_t *, rmw_wait_set_t *, const rmw_time_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_publisher_names_and_types_by_node,
-  rmw_ret_t, RMW_RET_ERROR,
-  6, ARG_TYPES(
-    const rmw_node_t *, rcutils_allocator_t *, const char *, const char *, bool,
-    rmw_names_and_types_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_subscriber_names_and_types_by_node,
-  rmw_ret_t, RMW_RET_ERROR,
-  6, ARG_TYPES(
-    const rmw_node_t *, rcutils_allocator_t *, const char *, const char *, bool,
-    rmw_names_and_types_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_service_names_and_types_by_node,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_node_t *, rcutils_allocator_t *, const char *, const char *,
-    rmw_names_and_types_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_client_names_and_types_by_node,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_node_t *, rcutils_allocator_t *, const char *, const char *,
-    rmw_names_and_types_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_topic_names_and_types,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(
-    const rmw_node_t *, rcutils_allocator_t *, bool,
-    rmw_names_and_types_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_service_names_and_types,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rmw_node_t *, rcutils_allocator_t *,
-    rmw_names_and_types_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_node_names,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_node_t *, rcutils_string_array_t *, rcutils_string_array_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_node_names_with_enclaves,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(
-    const rmw_node_t *, rcutils_string_array_t *,
-    rcutils_string_array_t *, rcutils_string_array_t *))
-
-RMW_INTERFACE_FN(
-  rmw_count_publishers,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_node_t *, const char *, size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_count_subscribers,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_node_t *, const char *, size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_count_clients,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_node_t *, const char *, size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_count_services,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_node_t *, const char *, size_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_gid_for_client,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_client_t *, rmw_gid_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_gid_for_publisher,
-  rmw_ret_t, RMW_RET_ERROR,
-  2, ARG_TYPES(const rmw_publisher_t *, rmw_gid_t *))
-
-RMW_INTERFACE_FN(
-  rmw_compare_gids_equal,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_gid_t *, const rmw_gid_t *, bool *))
-
-RMW_INTERFACE_FN(
-  rmw_service_server_is_available,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(const rmw_node_t *, const rmw_client_t *, bool *))
-
-RMW_INTERFACE_FN(
-  rmw_set_log_severity,
-  rmw_ret_t, RMW_RET_ERROR,
-  1, ARG_TYPES(rmw_log_severity_t))
-
-RMW_INTERFACE_FN(
-  rmw_get_publishers_info_by_topic,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_node_t *,
-    rcutils_allocator_t *,
-    const char *,
-    bool,
-    rmw_topic_endpoint_info_array_t *))
-
-RMW_INTERFACE_FN(
-  rmw_get_subscriptions_info_by_topic,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_node_t *,
-    rcutils_allocator_t *,
-    const char *,
-    bool,
-    rmw_topic_endpoint_info_array_t *))
-
-RMW_INTERFACE_FN(
-  rmw_qos_profile_check_compatible,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_qos_profile_t,
-    const rmw_qos_profile_t,
-    rmw_qos_compatibility_type_t *,
-    char *,
-    size_t))
-
-RMW_INTERFACE_FN(
-  rmw_publisher_get_network_flow_endpoints,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rmw_publisher_t *,
-    rcutils_allocator_t *,
-    rmw_network_flow_endpoint_array_t *))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_get_network_flow_endpoints,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const rmw_subscription_t *,
-    rcutils_allocator_t *,
-    rmw_network_flow_endpoint_array_t *))
-
-RMW_INTERFACE_FN(
-  rmw_subscription_set_on_new_message_callback,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    rmw_subscription_t *, rmw_event_callback_t, const void *))
-
-RMW_INTERFACE_FN(
-  rmw_service_set_on_new_request_callback,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    rmw_service_t *, rmw_event_callback_t, const void *))
-
-RMW_INTERFACE_FN(
-  rmw_client_set_on_new_response_callback,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    rmw_client_t *, rmw_event_callback_t, const void *))
-
-RMW_INTERFACE_FN(
-  rmw_event_set_callback,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    rmw_event_t *, rmw_event_callback_t, const void *))
-
-RMW_INTERFACE_FN(
-  rmw_feature_supported,
-  bool, false,
-  1, ARG_TYPES(
-    rmw_feature_t))
-
-RMW_INTERFACE_FN(
-  rmw_take_dynamic_message,
-  rmw_ret_t, RMW_RET_ERROR,
-  4, ARG_TYPES(
-    const rmw_subscription_t *,
-    rosidl_dynamic_typesupport_dynamic_data_t *,
-    bool *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_take_dynamic_message_with_info,
-  rmw_ret_t, RMW_RET_ERROR,
-  5, ARG_TYPES(
-    const rmw_subscription_t *,
-    rosidl_dynamic_typesupport_dynamic_data_t *,
-    bool *,
-    rmw_message_info_t *,
-    rmw_subscription_allocation_t *))
-
-RMW_INTERFACE_FN(
-  rmw_serialization_support_init,
-  rmw_ret_t, RMW_RET_ERROR,
-  3, ARG_TYPES(
-    const char *, rcutils_allocator_t *, rosidl_dynamic_typesupport_serialization_support_t *))
-
-
-#define GET_SYMBOL(x) symbol_ ## x = get_symbol(#x);
+// Run cleanup code without losing the error message set by a prior failure.
+template<typename CleanupT>
+static void
+cleanup_preserving_error(CleanupT cleanup)
+{
+  if (!rmw_error_is_set()) {
+    cleanup();
+    rmw_reset_error();
+    return;
+  }
+  rmw_error_state_t error_state = *rmw_get_error_state();
+  rmw_reset_error();
+  cleanup();
+  rmw_reset_error();
+  rmw_set_error_state(error_state.message, error_state.file, error_state.line_number);
+}
 
-void prefetch_symbols(void)
+// Entry points used for creating and destroying nodes when caching graph
+// queries, keeping track of their graph guard conditions, and for rmw_wait(),
+// invalidating cached results when any of those is ready.
+static rmw_node_t *
+cached_rmw_create_node(rmw_context_t * context, const char * name, const char * namespace_)
 {
-  // get all symbols to avoid race conditions later since the passed
-  // symbol name is expected to be a std::string which requires allocation
-  GET_SYMBOL(rmw_get_implementation_identifier)
-  GET_SYMBOL(rmw_init_options_init)
-  GET_SYMBOL(rmw_init_options_copy)
-  GET_SYMBOL(rmw_init_options_fini)
-  GET_SYMBOL(rmw_shutdown)
-  GET_SYMBOL(rmw_context_fini)
-  GET_SYMBOL(rmw_get_serialization_format)
-  GET_SYMBOL(rmw_create_node)
-  GET_SYMBOL(rmw_destroy_node)
-  GET_SYMBOL(rmw_node_get_graph_guard_condition)
-  GET_SYMBOL(rmw_init_publisher_allocation)
-  GET_SYMBOL(rmw_fini_publisher_allocation)
-  GET_SYMBOL(rmw_create_publisher)
-  GET_SYMBOL(rmw_destroy_publisher)
-  GET_SYMBOL(rmw_borrow_loaned_message)
-  GET_SYMBOL(rmw_return_loaned_message_from_publisher)
-  GET_SYMBOL(rmw_publish)
-  GET_SYMBOL(rmw_publish_loaned_message)
-  GET_SYMBOL(rmw_publisher_count_matched_subscriptions)
-  GET_SYMBOL(rmw_publisher_get_actual_qos)
-  GET_SYMBOL(rmw_publisher_event_init)
-  GET_SYMBOL(rmw_publish_serialized_message)
-  GET_SYMBOL(rmw_publisher_assert_liveliness)
-  GET_SYMBOL(rmw_publisher_wait_for_all_acked)
-  GET_SYMBOL(rmw_get_serialized_message_size)
-  GET_SYMBOL(rmw_serialize)
-  GET_SYMBOL(rmw_deserialize)
-  GET_SYMBOL(rmw_init_subscription_allocation)
-  GET_SYMBOL(rmw_fini_subscription_allocation)
-  GET_SYMBOL(rmw_create_subscription)
-  GET_SYMBOL(rmw_destroy_subscription)
-  GET_SYMBOL(rmw_subscription_count_matched_publishers)
-  GET_SYMBOL(rmw_subscription_get_actual_qos)
-  GET_SYMBOL(rmw_subscription_event_init)
-  GET_SYMBOL(rmw_subscription_set_content_filter)
-  GET_SYMBOL(rmw_subscription_get_content_filter)
-  GET_SYMBOL(rmw_take)
-  GET_SYMBOL(rmw_take_with_info)
-  GET_SYMBOL(rmw_take_serialized_message)
-  GET_SYMBOL(rmw_take_serialized_message_with_info)
-  GET_SYMBOL(rmw_take_loaned_message)
-  GET_SYMBOL(rmw_take_loaned_message_with_info)
-  GET_SYMBOL(rmw_return_loaned_message_from_subscription)
-  GET_SYMBOL(rmw_create_client)
-  GET_SYMBOL(rmw_destroy_client)
-  GET_SYMBOL(rmw_send_request)
-  GET_SYMBOL(rmw_take_response)
-  GET_SYMBOL(rmw_create_service)
-  GET_SYMBOL(rmw_destroy_service)
-  GET_SYMBOL(rmw_take_request)
-  GET_SYMBOL(rmw_send_response)
-  GET_SYMBOL(rmw_take_event)
-  GET_SYMBOL(rmw_create_guard_condition)
-  GET_SYMBOL(rmw_destroy_guard_condition)
-  GET_SYMBOL(rmw_trigger_guard_condition)
-  GET_SYMBOL(rmw_create_wait_set)
-  GET_SYMBOL(rmw_destroy_wait_set)
-  GET_SYMBOL(rmw_wait)
-  GET_SYMBOL(rmw_get_publisher_names_and_types_by_node)
-  GET_SYMBOL(rmw_get_subscriber_names_and_types_by_node)
-  GET_SYMBOL(rmw_get_service_names_and_types_by_node)
-  GET_SYMBOL(rmw_get_client_names_and_types_by_node)
-  GET_SYMBOL(rmw_get_topic_names_and_types)
-  GET_SYMBOL(rmw_get_service_names_and_types)
-  GET_SYMBOL(rmw_get_node_names)
-  GET_SYMBOL(rmw_get_node_names_with_enclaves)
-  GET_SYMBOL(rmw_count_publishers)
-  GET_SYMBOL(rmw_count_subscribers)
-  GET_SYMBOL(rmw_count_clients)
-  GET_SYMBOL(rmw_count_services)
-  GET_SYMBOL(rmw_get_gid_for_client)
-  GET_SYMBOL(rmw_get_gid_for_publisher)
-  GET_SYMBOL(rmw_compare_gids_equal)
-  GET_SYMBOL(rmw_service_response_publisher_get_actual_qos)
-  GET_SYMBOL(rmw_service_request_subscription_get_actual_qos)
-  GET_SYMBOL(rmw_service_server_is_available)
-  GET_SYMBOL(rmw_set_log_severity)
-  GET_SYMBOL(rmw_get_publishers_info_by_topic)
-  GET_SYMBOL(rmw_get_subscriptions_info_by_topic)
-  GET_SYMBOL(rmw_qos_profile_check_compatible)
-  GET_SYMBOL(rmw_publisher_get_network_flow_endpoints)
-  GET_SYMBOL(rmw_subscription_get_network_flow_endpoints)
-  GET_SYMBOL(rmw_client_request_publisher_get_actual_qos)
-  GET_SYMBOL(rmw_client_response_subscription_get_actual_qos)
-  GET_SYMBOL(rmw_subscription_set_on_new_message_callback)
-  GET_SYMBOL(rmw_service_set_on_new_request_callback)
-  GET_SYMBOL(rmw_client_set_on_new_response_callback)
-  GET_SYMBOL(rmw_event_set_callback)
-  GET_SYMBOL(rmw_feature_supported)
-  GET_SYMBOL(rmw_take_dynamic_message)
-  GET_SYMBOL(rmw_take_dynamic_message_with_info)
-  GET_SYMBOL(rmw_serialization_support_init)
-}
-
-void * symbol_rmw_init = nullptr;
+  rmw_node_t * node = g_uncached_dispatch_table.rmw_create_node(context, name, namespace_);
+  invalidate_graph_cache();
+  if (!node) {
+    return nullptr;
+  }
+  const rmw_guard_condition_t * graph_guard_condition =
+    g_uncached_dispatch_table.rmw_node_get_graph_guard_condition(node);
+  if (graph_guard_condition) {
+    try {
+      register_graph_guard_condition(graph_guard_condition->data);
+    } catch (const std::bad_alloc &) {
+      RMW_SET_ERROR_MSG("failed to keep track of the graph guard condition of the node");
+      cleanup_preserving_error([&]() {g_uncached_dispatch_table.rmw_destroy_node(node);});
+      return nullptr;
+    }
+  }
+  return node;
+}
 
-rmw_ret_t
-rmw_init(const rmw_init_options_t * options, rmw_context_t * context)
+static rmw_ret_t
+cached_rmw_destroy_node(rmw_node_t * node)
 {
-  prefetch_symbols();
-  if (!symbol_rmw_init) {
-    symbol_rmw_init = get_symbol("rmw_init");
+  if (node) {
+    const rmw_guard_condition_t * graph_guard_condition =
+      g_uncached_dispatch_table.rmw_node_get_graph_guard_condition(node);
+    if (graph_guard_condition) {
+      unregister_graph_guard_condition(graph_guard_condition->data);
+    }
   }
-  if (!symbol_rmw_init) {
-    return RMW_RET_ERROR;
+  rmw_ret_t ret = g_uncached_dispatch_table.rmw_destroy_node(node);
+  invalidate_graph_cache();
+  return ret;
+}
+
+static rmw_ret_t
+cached_rmw_wait(
+  rmw_subscriptions_t * subscriptions, rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services, rmw_clients_t * clients, rmw_events_t * events,
+  rmw_wait_set_t * wait_set, const rmw_time_t * wait_timeout)
+{
+  rmw_ret_t ret = g_uncached_dispatch_table.rmw_wait(
+    subscriptions, guard_conditions, services, clients, events, wait_set, wait_timeout);
+  if (RMW_RET_OK == ret) {
+    invalidate_graph_cache_on_ready(guard_conditions);
   }
+  return ret;
+}
 
-  typedef rmw_ret_t (* FunctionSignature)(const rmw_init_options_t *, rmw_context_t *);
-  FunctionSignature func = reinterpret_cast<FunctionSignature>(symbol_rmw_init);
-  return func(options, context);
+// Cached results are only used for the loaded RMW implementation's nodes,
+// letting it handle any bad argument otherwise.
+static bool
+is_cacheable_graph_query(const rmw_node_t * node)
+{
+  return node && node->implementation_identifier ==
+         g_uncached_dispatch_table.rmw_get_implementation_identifier();
 }
 
-#ifdef __cplusplus
+static bool
+is_zero_initialized(const rmw_names_and_types_t * names_and_types)
+{
+  return names_and_types && !names_and_types->names.data && 0u == names_and_types->names.size &&
+         !names_and_types->types;
 }
-#endif
 
-void
-unload_library()
+static bool
+is_zero_initialized(const rcutils_string_array_t * array)
 {
-  symbol_rmw_get_implementation_identifier = nullptr;
-  symbol_rmw_init_options_init = nullptr;
-  symbol_rmw_init_options_copy = nullptr;
-  symbol_rmw_init_options_fini = nullptr;
-  symbol_rmw_shutdown = nullptr;
-  symbol_rmw_context_fini = nullptr;
-  symbol_rmw_get_serialization_format = nullptr;
-  symbol_rmw_create_node = nullptr;
-  symbol_rmw_destroy_node = nullptr;
-  symbol_rmw_node_get_graph_guard_condition = nullptr;
-  symbol_rmw_init_publisher_allocation = nullptr;
-  symbol_rmw_fini_publisher_allocation = nullptr;
-  symbol_rmw_create_publisher = nullptr;
-  symbol_rmw_destroy_publisher = nullptr;
-  symbol_rmw_borrow_loaned_message = nullptr;
-  symbol_rmw_return_loaned_message_from_publisher = nullptr;
-  symbol_rmw_publish = nullptr;
-  symbol_rmw_publish_loaned_message = nullptr;
-  symbol_rmw_publisher_count_matched_subscriptions = nullptr;
-  symbol_rmw_publisher_get_actual_qos = nullptr;
-  symbol_rmw_publisher_event_init = nullptr;
-  symbol_rmw_publish_serialized_message = nullptr;
-  symbol_rmw_get_serialized_message_size = nullptr;
-  symbol_rmw_publisher_assert_liveliness = nullptr;
-  symbol_rmw_publisher_wait_for_all_acked = nullptr;
-  symbol_rmw_serialize = nullptr;
-  symbol_rmw_deserialize = nullptr;
-  symbol_rmw_init_subscription_allocation = nullptr;
-  symbol_rmw_fini_subscription_allocation = nullptr;
-  symbol_rmw_create_subscription = nullptr;
-  symbol_rmw_destroy_subscription = nullptr;
-  symbol_rmw_subscription_count_matched_publishers = nullptr;
-  symbol_rmw_subscription_get_actual_qos = nullptr;
-  symbol_rmw_subscription_event_init = nullptr;
-  symbol_rmw_subscription_set_content_filter = nullptr;
-  symbol_rmw_subscription_get_content_filter = nullptr;
-  symbol_rmw_take = nullptr;
-  symbol_rmw_take_sequence = nullptr;
-  symbol_rmw_take_with_info = nullptr;
-  symbol_rmw_take_serialized_message = nullptr;
-  symbol_rmw_take_serialized_message_with_info = nullptr;
-  symbol_rmw_take_loaned_message = nullptr;
-  symbol_rmw_take_loaned_message_with_info = nullptr;
-  symbol_rmw_return_loaned_message_from_subscription = nullptr;
-  symbol_rmw_create_client = nullptr;
-  symbol_rmw_destroy_client = nullptr;
-  symbol_rmw_client_request_publisher_get_actual_qos = nullptr;
-  symbol_rmw_client_response_subscription_get_actual_qos = nullptr;
-  symbol_rmw_send_request = nullptr;
-  symbol_rmw_take_response = nullptr;
-  symbol_rmw_create_service = nullptr;
-  symbol_rmw_destroy_service = nullptr;
-  symbol_rmw_service_response_publisher_get_actual_qos = nullptr;
-  symbol_rmw_service_request_subscription_get_actual_qos = nullptr;
-  symbol_rmw_take_request = nullptr;
-  symbol_rmw_send_response = nullptr;
-  symbol_rmw_take_event = nullptr;
-  symbol_rmw_create_guard_condition = nullptr;
-  symbol_rmw_destroy_guard_condition = nullptr;
-  symbol_rmw_trigger_guard_condition = nullptr;
-  symbol_rmw_create_wait_set = nullptr;
-  symbol_rmw_destroy_wait_set = nullptr;
-  symbol_rmw_wait = nullptr;
-  symbol_rmw_get_publisher_names_and_types_by_node = nullptr;
-  symbol_rmw_get_subscriber_names_and_types_by_node = nullptr;
-  symbol_rmw_get_service_names_and_types_by_node = nullptr;
-  symbol_rmw_get_client_names_and_types_by_node = nullptr;
-  symbol_rmw_get_topic_names_and_types = nullptr;
-  symbol_rmw_get_service_names_and_types = nullptr;
-  symbol_rmw_get_node_names = nullptr;
-  symbol_rmw_get_node_names_with_enclaves = nullptr;
-  symbol_rmw_count_publishers = nullptr;
-  symbol_rmw_count_subscribers = nullptr;
-  symbol_rmw_count_clients = nullptr;
-  symbol_rmw_count_services = nullptr;
-  symbol_rmw_get_gid_for_client = nullptr;
-  symbol_rmw_get_gid_for_publisher = nullptr;
-  symbol_rmw_compare_gids_equal = nullptr;
-  symbol_rmw_service_server_is_available = nullptr;
-  symbol_rmw_set_log_severity = nullptr;
-  symbol_rmw_get_publishers_info_by_topic = nullptr;
-  symbol_rmw_get_subscriptions_info_by_topic = nullptr;
-  symbol_rmw_qos_profile_check_compatible = nullptr;
-  symbol_rmw_publisher_get_network_flow_endpoints = nullptr;
-  symbol_rmw_subscription_get_network_flow_endpoints = nullptr;
-  symbol_rmw_init = nullptr;
-  symbol_rmw_subscription_set_on_new_message_callback = nullptr;
-  symbol_rmw_service_set_on_new_request_callback = nullptr;
-  symbol_rmw_client_set_on_new_response_callback = nullptr;
-  symbol_rmw_event_set_callback = nullptr;
-  symbol_rmw_feature_supported = nullptr;
-  symbol_rmw_take_dynamic_message = nullptr;
-  symbol_rmw_take_dynamic_message_with_info = nullptr;
-  symbol_rmw_serialization_support_init = nullptr;
-  g_rmw_lib.reset();
+  return array && !array->data && 0u == array->size;
+}
+
+static bool
+is_zero_initialized(const rmw_topic_endpoint_info_array_t * endpoints_info)
+{
+  return endpoints_info && !endpoints_info->info_array && 0u == endpoints_info->size;
+}
+
+// Entry points used for graph queries when caching them.
+static rmw_ret_t
+cached_rmw_get_topic_names_and_types(
+  const rmw_node_t * node, rcutils_allocator_t * allocator, bool no_demangle,
+  rmw_names_and_types_t * tnat)
+{
+  auto query = [&]() {
+      return g_uncached_dispatch_table.rmw_get_topic_names_and_types(
+        node, allocator, no_demangle, tnat);
+    };
+  if (
+    !is_cacheable_graph_query(node) || !rcutils_allocator_is_valid(allocator) ||
+    !is_zero_initialized(tnat))
+  {
+    return query();
+  }
+  return cached_names_and_types_query(
+    make_graph_query_key("rmw_get_topic_names_and_types", node, no_demangle),
+    allocator, tnat, query);
+}
+
+static rmw_ret_t
+cached_rmw_get_service_names_and_types(
+  const rmw_node_t * node, rcutils_allocator_t * allocator, rmw_names_and_types_t * snat)
+{
+  auto query = [&]() {
+      return g_uncached_dispatch_table.rmw_get_service_names_and_types(node, allocator, snat);
+    };
+  if (
+    !is_cacheable_graph_query(node) || !rcutils_allocator_is_valid(allocator) ||
+    !is_zero_initialized(snat))
+  {
+    return query();
+  }
+  return cached_names_and_types_query(
+    make_graph_query_key("rmw_get_service_names_and_types", node), allocator, snat, query);
+}
+
+static rmw_ret_t
+cached_rmw_get_node_names(
+  const rmw_node_t * node, rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces)
+{
+  auto query = [&]() {
+      return g_uncached_dispatch_table.rmw_get_node_names(node, node_names, node_namespaces);
+    };
+  if (
+    !is_cacheable_graph_query(node) || !is_zero_initialized(node_names) ||
+    !is_zero_initialized(node_namespaces))
+  {
+    return query();
+  }
+  return cached_node_names_query(
+    make_graph_query_key("rmw_get_node_names", node), node_names, node_namespaces, nullptr,
+    query);
+}
+
+static rmw_ret_t
+cached_rmw_get_node_names_with_enclaves(
+  const rmw_node_t * node, rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces, rcutils_string_array_t * enclaves)
+{
+  auto query = [&]() {
+      return g_uncached_dispatch_table.rmw_get_node_names_with_enclaves(
+        node, node_names, node_namespaces, enclaves);
+    };
+  if (
+    !is_cacheable_graph_query(node) || !is_zero_initialized(node_names) ||
+    !is_zero_initialized(node_namespaces) || !is_zero_initialized(enclaves))
+  {
+    return query();
+  }
+  return cached_node_names_query(
+    make_graph_query_key("rmw_get_node_names_with_enclaves", node), node_names, node_namespaces,
+    enclaves, query);
+}
+
+#define CACHED_COUNT_ENTRY_POINT(name) \
+  static rmw_ret_t cached_ ## name(const rmw_node_t * node, const char * name_arg, size_t * count) \
+  { \
+    auto query = [&]() { \
+        return g_uncached_dispatch_table.name(node, name_arg, count); \
+      }; \
+    if (!is_cacheable_graph_query(node) || !name_arg || !count) { \
+      return query(); \
+    } \
+    return cached_count_query(make_graph_query_key(#name, node, name_arg), count, query); \
+  }
+
+CACHED_COUNT_ENTRY_POINT(rmw_count_publishers)
+CACHED_COUNT_ENTRY_POINT(rmw_count_subscribers)
+CACHED_COUNT_ENTRY_POINT(rmw_count_clients)
+CACHED_COUNT_ENTRY_POINT(rmw_count_services)
+
+#define CACHED_ENDPOINT_INFO_ENTRY_POINT(name) \
+  static rmw_ret_t cached_ ## name( \
+    const rmw_node_t * node, rcutils_allocator_t * allocator, const char * topic_name, \
+    bool no_mangle, rmw_topic_endpoint_info_array_t * endpoints_info) \
+  { \
+    auto query = [&]() { \
+        return g_uncached_dispatch_table.name( \
+          node, allocator, topic_name, no_mangle, endpoints_info); \
+      }; \
+    if ( \
+      !is_cacheable_graph_query(node) || !rcutils_allocator_is_valid(allocator) || \
+      !topic_name || !is_zero_initialized(endpoints_info)) \
+    { \
+      return query(); \
+    } \
+    return cached_endpoint_info_query( \
+      make_graph_query_key(#name, node, topic_name, no_mangle), allocator, endpoints_info, \
+      query); \
+  }
+
+CACHED_ENDPOINT_INFO_ENTRY_POINT(rmw_get_publishers_info_by_topic)
+CACHED_ENDPOINT_INFO_ENTRY_POINT(rmw_get_subscriptions_info_by_topic)
+
+// Route graph queries through the graph cache, and calls changing the graph
+// through entry points invalidating it.
+static void
+install_graph_cache(DispatchTable * table)
+{
+  g_uncached_dispatch_table = *table;
+  invalidate_graph_cache();
+
+#define INVALIDATE_GRAPH_CACHE_ON(name) \
+  table->name = &GraphChangingEntryPoint<decltype(DispatchTable::name), &DispatchTable::name>::call
+  INVALIDATE_GRAPH_CACHE_ON(rmw_create_publisher);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_destroy_publisher);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_create_subscription);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_destroy_subscription);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_create_client);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_destroy_client);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_create_service);
+  INVALIDATE_GRAPH_CACHE_ON(rmw_destroy_service);
+#undef INVALIDATE_GRAPH_CACHE_ON
+  table->rmw_create_node = cached_rmw_create_node;
+  table->rmw_destroy_node = cached_rmw_destroy_node;
+  table->rmw_wait = cached_rmw_wait;
+
+  table->rmw_get_topic_names_and_types = cached_rmw_get_topic_names_and_types;
+  table->rmw_get_service_names_and_types = cached_rmw_get_service_names_and_types;
+  table->rmw_get_node_names = cached_rmw_get_node_names;
+  table->rmw_get_node_names_with_enclaves = cached_rmw_get_node_names_with_enclaves;
+  table->rmw_count_publishers = cached_rmw_count_publishers;
+  table->rmw_count_subscribers = cached_rmw_count_subscribers;
+  table->rmw_count_clients = cached_rmw_count_clients;
+  table->rmw_count_services = cached_rmw_count_services;
+  table->rmw_get_publishers_info_by_topic = cached_rmw_get_publishers_info_by_topic;
+  table->rmw_get_subscriptions_info_by_topic = cached_rmw_get_subscriptions_info_by_topic;
+}
+
+// Entry points used when collecting call statistics, forwarding calls to the
+// resolved ones.
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  static ReturnType instrumented_ ## name(EXPAND(ARGS_ ## _NR(__VA_ARGS__))) \
+  { \
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now(); \
+    ReturnType ret = g_resolved_dispatch_table.name(EXPAND(ARG_VALUES_ ## _NR(__VA_ARGS__))); \
+    record_call( \
+      function_id_ ## name, std::chrono::steady_clock::now() - start, is_error_return(ret)); \
+    return ret; \
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+
+static const DispatchTable g_instrumented_dispatch_table = {
+#define RMW_INTERFACE_FN(name, ...) instrumented_ ## name,
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+// Name and location in the dispatch table of every symbol to resolve.
+struct DispatchTableEntry
+{
+  const char * symbol_name;
+  size_t offset;
+};
+
+static constexpr DispatchTableEntry g_dispatch_table_entries[] = {
+#define RMW_INTERFACE_FN(name, ...) {#name, offsetof(DispatchTable, name)},
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+static_assert(
+  sizeof(void *) == sizeof(void (*)(void)),
+  "symbols must be storable as function pointers");
+
+const char *
+get_function_name(size_t function_id)
+{
+  return g_dispatch_table_entries[function_id].symbol_name;
+}
+
+// Whether each function was found in the loaded RMW implementation.
+static std::bitset<function_count> g_available_functions;
+
+// Entry point used for rmw_take_sequence() when the loaded RMW implementation
+// lacks it, taking messages one by one.
+static rmw_ret_t
+emulated_rmw_take_sequence(
+  const rmw_subscription_t * subscription, size_t count,
+  rmw_message_sequence_t * message_sequence, rmw_message_info_sequence_t * message_info_sequence,
+  size_t * taken, rmw_subscription_allocation_t * allocation)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_sequence, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_info_sequence, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  if (0u == count) {
+    RMW_SET_ERROR_MSG("count cannot be 0");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (count > message_sequence->capacity) {
+    RMW_SET_ERROR_MSG("insufficient capacity in message_sequence");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (count > message_info_sequence->capacity) {
+    RMW_SET_ERROR_MSG("insufficient capacity in message_info_sequence");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  *taken = 0u;
+  rmw_ret_t ret = RMW_RET_OK;
+  while (*taken < count) {
+    bool taken_one = false;
+    ret = g_resolved_dispatch_table.rmw_take_with_info(
+      subscription, message_sequence->data[*taken], &taken_one,
+      &message_info_sequence->data[*taken], allocation);
+    if (RMW_RET_OK != ret || !taken_one) {
+      break;
+    }
+    ++*taken;
+  }
+  message_sequence->size = *taken;
+  message_info_sequence->size = *taken;
+  return ret;
+}
+
+// How content filters are evaluated, as requested when resolving entry points.
+static ContentFilterFallback g_content_filter_fallback = ContentFilterFallback::disabled;
+
+// Entry points of the loaded RMW implementation replaced in the resolved
+// dispatch table when evaluating content filters on its behalf.
+static DispatchTable g_unfiltered_dispatch_table;
+
+// Entry points used when evaluating content filters on behalf of the loaded
+// RMW implementation, keeping track of subscriptions and dropping taken
+// messages that do not pass their filters.
+static rmw_subscription_t *
+filtering_rmw_create_subscription(
+  const rmw_node_t * node, const rosidl_message_type_support_t * type_support,
+  const char * topic_name, const rmw_qos_profile_t * qos_profile,
+  const rmw_subscription_options_t * subscription_options)
+{
+  const rmw_subscription_options_t * implementation_options = subscription_options;
+  rmw_subscription_options_t options;
+  if (ContentFilterFallback::always == g_content_filter_fallback && subscription_options) {
+    // keep the filter from the RMW implementation
+    options = *subscription_options;
+    options.content_filter_options = nullptr;
+    implementation_options = &options;
+  }
+  rmw_subscription_t * subscription = g_unfiltered_dispatch_table.rmw_create_subscription(
+    node, type_support, topic_name, qos_profile, implementation_options);
+  if (!subscription) {
+    return nullptr;
+  }
+  register_filterable_subscription(subscription, type_support);
+
+  if (
+    subscription_options && subscription_options->content_filter_options &&
+    !subscription->is_cft_enabled && is_filterable_subscription(subscription))
+  {
+    rmw_ret_t ret =
+      set_fallback_content_filter(subscription, subscription_options->content_filter_options);
+    if (RMW_RET_OK != ret) {
+      rmw_error_state_t error_state = *rmw_get_error_state();
+      rmw_reset_error();
+      unregister_filterable_subscription(subscription);
+      g_unfiltered_dispatch_table.rmw_destroy_subscription(
+        const_cast<rmw_node_t *>(node), subscription);
+      rmw_reset_error();
+      rmw_set_error_state(error_state.message, error_state.file, error_state.line_number);
+      return nullptr;
+    }
+  }
+  return subscription;
+}
+
+static rmw_ret_t
+filtering_rmw_destroy_subscription(rmw_node_t * node, rmw_subscription_t * subscription)
+{
+  unregister_filterable_subscription(subscription);
+  return g_unfiltered_dispatch_table.rmw_destroy_subscription(node, subscription);
 }
+
+static rmw_ret_t
+filtering_rmw_subscription_set_content_filter(
+  rmw_subscription_t * subscription, const rmw_subscription_content_filter_options_t * options)
+{
+  if (!is_filterable_subscription(subscription)) {
+    return g_unfiltered_dispatch_table.rmw_subscription_set_content_filter(subscription, options);
+  }
+  if (ContentFilterFallback::always == g_content_filter_fallback) {
+    return set_fallback_content_filter(subscription, options);
+  }
+  rmw_ret_t ret =
+    g_unfiltered_dispatch_table.rmw_subscription_set_content_filter(subscription, options);
+  if (RMW_RET_UNSUPPORTED != ret) {
+    return ret;
+  }
+  rmw_reset_error();
+  return set_fallback_content_filter(subscription, options);
+}
+
+static rmw_ret_t
+filtering_rmw_subscription_get_content_filter(
+  const rmw_subscription_t * subscription, rcutils_allocator_t * allocator,
+  rmw_subscription_content_filter_options_t * options)
+{
+  rmw_ret_t ret = get_fallback_content_filter_options(subscription, allocator, options);
+  if (RMW_RET_UNSUPPORTED != ret) {
+    return ret;
+  }
+  return g_unfiltered_dispatch_table.rmw_subscription_get_content_filter(
+    subscription, allocator, options);
+}
+
+static rmw_ret_t
+filtering_rmw_take(
+  const rmw_subscription_t * subscription, void * ros_message, bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  std::shared_ptr<const ContentFilter> filter = get_fallback_content_filter(subscription);
+  while (true) {
+    rmw_ret_t ret =
+      g_unfiltered_dispatch_table.rmw_take(subscription, ros_message, taken, allocation);
+    if (!filter || RMW_RET_OK != ret || !*taken || filter->matches(ros_message)) {
+      return ret;
+    }
+  }
+}
+
+static rmw_ret_t
+filtering_rmw_take_with_info(
+  const rmw_subscription_t * subscription, void * ros_message, bool * taken,
+  rmw_message_info_t * message_info, rmw_subscription_allocation_t * allocation)
+{
+  std::shared_ptr<const ContentFilter> filter = get_fallback_content_filter(subscription);
+  while (true) {
+    rmw_ret_t ret = g_unfiltered_dispatch_table.rmw_take_with_info(
+      subscription, ros_message, taken, message_info, allocation);
+    if (!filter || RMW_RET_OK != ret || !*taken || filter->matches(ros_message)) {
+      return ret;
+    }
+  }
+}
+
+static rmw_ret_t
+filtering_rmw_take_sequence(
+  const rmw_subscription_t * subscription, size_t count,
+  rmw_message_sequence_t * message_sequence, rmw_message_info_sequence_t * message_info_sequence,
+  size_t * taken, rmw_subscription_allocation_t * allocation)
+{
+  if (!get_fallback_content_filter(subscription)) {
+    return g_unfiltered_dispatch_table.rmw_take_sequence(
+      subscription, count, message_sequence, message_info_sequence, taken, allocation);
+  }
+  // take messages one by one through the filtering entry point
+  return emulated_rmw_take_sequence(
+    subscription, count, message_sequence, message_info_sequence, taken, allocation);
+}
+
+static void
+install_content_filter_fallback(DispatchTable * table)
+{
+  g_unfiltered_dispatch_table = *table;
+  table->rmw_create_subscription = filtering_rmw_create_subscription;
+  table->rmw_destroy_subscription = filtering_rmw_destroy_subscription;
+  table->rmw_subscription_set_content_filter = filtering_rmw_subscription_set_content_filter;
+  table->rmw_subscription_get_content_filter = filtering_rmw_subscription_get_content_filter;
+  table->rmw_take = filtering_rmw_take;
+  table->rmw_take_with_info = filtering_rmw_take_with_info;
+  table->rmw_take_sequence = filtering_rmw_take_sequence;
+}
+
+// Most RMW implementations calls may be routed to, the loaded one included.
+static constexpr size_t max_routed_backends = 8u;
+
+// Handles of the same entity in every RMW implementation calls are routed to,
+// for entities all of them need, e.g. contexts or nodes, indexed like
+// g_routed_backends.
+using SiblingHandles = std::array<void *, max_routed_backends>;
+
+// Entry points used for functions an RMW implementation calls are routed to
+// lacks.
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  static ReturnType unavailable_ ## name(__VA_ARGS__) \
+  { \
+    RMW_SET_ERROR_MSG( \
+      "function '" #name "' is unavailable in the RMW implementation the call was routed to"); \
+    return error_value; \
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+
+static const DispatchTable g_unavailable_dispatch_table = {
+#define RMW_INTERFACE_FN(name, ...) unavailable_ ## name,
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+};
+
+// Entry points of the loaded RMW implementation replaced in the resolved
+// dispatch table when routing calls.
+static DispatchTable g_unrouted_dispatch_table;
+
+// An RMW implementation calls are routed to.
+struct RoutedBackend
+{
+  size_t index;
+  std::string name;
+  std::shared_ptr<rcpputils::SharedLibrary> lib;
+  const char * identifier;
+  // Points to g_unrouted_dispatch_table for the loaded RMW implementation.
+  const DispatchTable * table;
+  DispatchTable own_table;
+};
+
+// RMW implementations calls are routed to, the loaded one first, and the
+// index of the one each routing rule names.
+// Only modified while resolving the dispatch table.
+static std::vector<std::unique_ptr<RoutedBackend>> g_routed_backends;
+static std::vector<RoutingRule> g_routing_rules;
+static std::vector<size_t> g_routing_rule_backends;
+
+// Siblings of a wait set created by the loaded RMW implementation, and the
+// guard conditions waking each of them up, added to the wait set of the RMW
+// implementation that blocks in rmw_wait() when several are involved.
+struct RoutedWaitSet
+{
+  SiblingHandles wait_sets;
+  SiblingHandles wakers;
+};
+
+// Siblings of contexts, nodes, guard conditions and wait sets created by the
+// loaded RMW implementation, by handle but for guard conditions, which are
+// found by implementation data as that is what rmw_wait() gets.
+static HandleMap<SiblingHandles> g_routed_contexts;
+static HandleMap<SiblingHandles> g_routed_nodes;
+static HandleMap<SiblingHandles> g_routed_guard_conditions;
+static HandleMap<RoutedWaitSet> g_routed_wait_sets;
+
+// Set as the callback of entities created by RMW implementations other than
+// the loaded one, forwarding their events to any callback set on them through
+// this library, and waking up the RMW implementation that blocks in
+// rmw_wait() while they are waited on.
+// Only one wait at a time is woken up, as RMW implementations do not support
+// waiting on the same entity from several wait sets at once either.
+class RoutedListener
+{
+public:
+  static void on_event(const void * user_data, size_t number_of_events)
+  {
+    auto listener = static_cast<RoutedListener *>(const_cast<void *>(user_data));
+    std::lock_guard<std::mutex> lock(listener->mutex_);
+    if (listener->callback_) {
+      listener->callback_(listener->user_data_, number_of_events);
+    } else {
+      listener->unread_ += number_of_events;
+    }
+    if (listener->waker_) {
+      listener->waker_table_->rmw_trigger_guard_condition(listener->waker_);
+    }
+  }
+
+  // Set the callback of the entity, calling it right away if events occurred
+  // while it had none, as RMW implementations do.
+  void set_callback(rmw_event_callback_t callback, const void * user_data)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = callback;
+    user_data_ = user_data;
+    if (callback_ && unread_ > 0u) {
+      callback_(user_data_, unread_);
+      unread_ = 0u;
+    }
+  }
+
+  // Set the guard condition to trigger upon events, and the dispatch table of
+  // the RMW implementation that created it, or unset it given nullptr.
+  void set_waker(const DispatchTable * table, const rmw_guard_condition_t * waker)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    waker_table_ = table;
+    waker_ = waker;
+  }
+
+private:
+  std::mutex mutex_;
+  rmw_event_callback_t callback_ = nullptr;
+  const void * user_data_ = nullptr;
+  size_t unread_ = 0u;
+  const DispatchTable * waker_table_ = nullptr;
+  const rmw_guard_condition_t * waker_ = nullptr;
+};
+
+// A subscription, service, client or event created by an RMW implementation
+// other than the loaded one.
+struct RoutedEntity
+{
+  size_t backend;
+  // Null if the RMW implementation does not support callbacks.
+  std::shared_ptr<RoutedListener> listener;
+  // For events, the publisher or subscription they were initialized for,
+  // and a copy of them to unset their callback should they be initialized
+  // anew without their parent being destroyed first.
+  const void * parent;
+  rmw_event_t event;
+};
+
+// Subscriptions, services and clients created by RMW implementations other
+// than the loaded one by implementation data, and events by handle, as that
+// is what rmw_wait() gets.
+static HandleMap<RoutedEntity> g_routed_entities;
+
+// Number of publishers, subscriptions, services and clients created by RMW
+// implementations other than the loaded one, letting rmw_wait() skip any
+// lookup while there are none.
+static std::atomic<size_t> g_routed_entity_count{0u};
+
+// RMW implementation that created each handle, when dispatching calls on
+// handles that way rather than by implementation identifier.
+static bool g_handle_dispatch = false;
+static HandleRegistry g_handle_backends;
+
+static void
+register_handle(const void * handle, size_t backend) noexcept
+{
+  if (g_handle_dispatch && handle) {
+    try {
+      g_handle_backends.insert(handle, g_routed_backends[backend].get());
+    } catch (const std::bad_alloc &) {
+      // calls on it fall back to its implementation identifier
+    }
+  }
+}
+
+static void
+unregister_handle(const void * handle)
+{
+  if (g_handle_dispatch && handle) {
+    g_handle_backends.erase(handle);
+  }
+}
+
+// Index of the RMW implementation with the given identifier, comparing
+// pointers first as every handle an RMW implementation creates usually
+// refers to the same identifier string.
+static size_t
+find_routed_backend(const char * identifier)
+{
+  const size_t count = g_routed_backends.size();
+  for (size_t i = 0u; i < count; ++i) {
+    if (g_routed_backends[i]->identifier == identifier) {
+      return i;
+    }
+  }
+  if (identifier) {
+    for (size_t i = 0u; i < count; ++i) {
+      const char * backend_identifier = g_routed_backends[i]->identifier;
+      if (backend_identifier && std::strcmp(backend_identifier, identifier) == 0) {
+        return i;
+      }
+    }
+  }
+  return 0u;
+}
+
+// Index of the RMW implementation that created a handle.
+template<typename HandleT>
+static size_t
+find_handle_backend(const HandleT * handle)
+{
+  if (!handle) {
+    return 0u;
+  }
+  if (g_handle_dispatch) {
+    auto backend = static_cast<const RoutedBackend *>(g_handle_backends.find(handle));
+    if (backend) {
+      return backend->index;
+    }
+  }
+  return find_routed_backend(handle->implementation_identifier);
+}
+
+// Index of the RMW implementation a topic or service name is routed to.
+static size_t
+route_name(const char * name)
+{
+  if (name) {
+    const size_t count = g_routing_rules.size();
+    for (size_t i = 0u; i < count; ++i) {
+      if (matches_routing_pattern(name, g_routing_rules[i].pattern)) {
+        return g_routing_rule_backends[i];
+      }
+    }
+  }
+  return 0u;
+}
+
+// Sibling of a node created by the loaded RMW implementation, setting the
+// error message if there is none, i.e. the node is unknown.
+static rmw_node_t *
+find_routed_node(const rmw_node_t * node, size_t backend)
+{
+  if (0u == backend || !node) {
+    // let the RMW implementation handle any bad argument
+    return const_cast<rmw_node_t *>(node);
+  }
+  SiblingHandles nodes;
+  if (!g_routed_nodes.find(node, nodes)) {
+    RMW_SET_ERROR_MSG("node was not created by the RMW implementation calls are routed from");
+    return nullptr;
+  }
+  return static_cast<rmw_node_t *>(nodes[backend]);
+}
+
+// Create the siblings of an entity the loaded RMW implementation created,
+// given how to create and destroy them, destroying all of them on failure
+// but the one passed in.
+template<typename CreateT, typename DestroyT>
+static bool
+create_siblings(SiblingHandles & siblings, CreateT create, DestroyT destroy)
+{
+  const size_t count = g_routed_backends.size();
+  for (size_t i = 1u; i < count; ++i) {
+    siblings[i] = create(*g_routed_backends[i]->table, i);
+    if (!siblings[i]) {
+      cleanup_preserving_error(
+        [&]() {
+          for (size_t j = 1u; j < i; ++j) {
+            destroy(*g_routed_backends[j]->table, siblings[j]);
+          }
+        });
+      return false;
+    }
+  }
+  return true;
+}
+
+// Call a function on every sibling of an entity, returning the first failure.
+template<typename FunctionT>
+static rmw_ret_t
+for_each_sibling(const SiblingHandles & siblings, FunctionT function)
+{
+  rmw_ret_t ret = RMW_RET_OK;
+  const size_t count = g_routed_backends.size();
+  for (size_t i = 1u; i < count; ++i) {
+    if (siblings[i]) {
+      rmw_ret_t sibling_ret = function(*g_routed_backends[i]->table, siblings[i]);
+      if (RMW_RET_OK == ret) {
+        ret = sibling_ret;
+      }
+    }
+  }
+  return ret;
+}
+
+template<typename T, typename = void>
+struct HasImplementationIdentifier : std::false_type {};
+
+template<typename T>
+struct HasImplementationIdentifier<
+  T, std::void_t<decltype(std::declval<T &>().implementation_identifier)>>
+  : std::true_type {};
+
+// Dispatch table of the RMW implementation that created the handle passed as
+// first argument, if any, or of the loaded one otherwise.
+template<typename ... Args>
+static const DispatchTable *
+find_routed_table(Args...)
+{
+  return &g_unrouted_dispatch_table;
+}
+
+template<typename FirstT, typename ... Args>
+static const DispatchTable *
+find_routed_table(FirstT * first, Args...)
+{
+  if constexpr (HasImplementationIdentifier<FirstT>::value) {
+    if (first) {
+      if (g_handle_dispatch) {
+        auto backend = static_cast<const RoutedBackend *>(g_handle_backends.find(first));
+        if (backend) {
+          return backend->table;
+        }
+      }
+      return g_routed_backends[find_routed_backend(first->implementation_identifier)]->table;
+    }
+  } else {
+    static_cast<void>(first);
+  }
+  return &g_unrouted_dispatch_table;
+}
+
+// Entry points used for functions that need no special handling when routing
+// calls, dispatching them based on their first argument.
+template<typename FunctionT, FunctionT DispatchTable::* entry>
+struct RoutedEntryPoint;
+
+template<
+  typename ReturnType, typename ... Args,
+  ReturnType(* DispatchTable::* entry)(Args...)>
+struct RoutedEntryPoint<ReturnType (*)(Args...), entry>
+{
+  static ReturnType call(Args... args)
+  {
+    return (find_routed_table(args ...)->*entry)(args ...);
+  }
+};
+
+// Forwards the graph changes an RMW implementation calls are routed to sees
+// to the graph guard conditions of the nodes of the loaded one, which are
+// those callers wait on, triggering them whenever the graph guard condition
+// of one of their siblings is, from a thread waiting on the latter.
+class RoutedGraphWatcher
+{
+public:
+  // Start watching with a context of the given RMW implementation, returning
+  // nullptr and setting the error message on failure.
+  static std::unique_ptr<RoutedGraphWatcher>
+  start(size_t backend, rmw_context_t * context)
+  {
+    std::unique_ptr<RoutedGraphWatcher> watcher(new (std::nothrow) RoutedGraphWatcher());
+    if (!watcher) {
+      RMW_SET_ERROR_MSG("failed to allocate graph watcher");
+      return nullptr;
+    }
+    watcher->table_ = g_routed_backends[backend]->table;
+    watcher->wait_set_ = watcher->table_->rmw_create_wait_set(context, 0u);
+    if (!watcher->wait_set_) {
+      return nullptr;
+    }
+    watcher->control_ = watcher->table_->rmw_create_guard_condition(context);
+    if (!watcher->control_) {
+      return nullptr;
+    }
+    try {
+      watcher->thread_ = std::thread(&RoutedGraphWatcher::run, watcher.get());
+    } catch (const std::system_error & e) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING("failed to start graph watcher due to %s", e.what());
+      return nullptr;
+    }
+    return watcher;
+  }
+
+  ~RoutedGraphWatcher()
+  {
+    if (thread_.joinable()) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+      }
+      table_->rmw_trigger_guard_condition(control_);
+      thread_.join();
+    }
+    cleanup_preserving_error(
+      [this]() {
+        if (control_) {
+          table_->rmw_destroy_guard_condition(control_);
+        }
+        if (wait_set_) {
+          table_->rmw_destroy_wait_set(wait_set_);
+        }
+      });
+  }
+
+  /// \throws std::bad_alloc if the set of watched guard conditions cannot grow.
+  void watch(
+    const rmw_guard_condition_t * sibling, const rmw_guard_condition_t * graph_guard_condition)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      watched_.emplace_back(sibling, graph_guard_condition);
+      ++generation_;
+    }
+    table_->rmw_trigger_guard_condition(control_);
+  }
+
+  // Stop watching a guard condition, returning once the thread no longer
+  // waits on it, nor triggers the one it forwards to.
+  void unwatch(const rmw_guard_condition_t * sibling)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = std::find_if(
+      watched_.begin(), watched_.end(), [sibling](const auto & watched) {
+        return watched.first == sibling;
+      });
+    if (it == watched_.end()) {
+      return;
+    }
+    watched_.erase(it);
+    const uint64_t generation = ++generation_;
+    lock.unlock();
+    table_->rmw_trigger_guard_condition(control_);
+    lock.lock();
+    seen_.wait(lock, [this, generation]() {return stopped_ || seen_generation_ >= generation;});
+  }
+
+private:
+  RoutedGraphWatcher() = default;
+
+  void run()
+  {
+    std::vector<std::pair<const rmw_guard_condition_t *, const rmw_guard_condition_t *>> watched;
+    std::vector<void *> guard_conditions;
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_) {
+      try {
+        watched = watched_;
+        guard_conditions.resize(watched.size() + 1u);
+      } catch (const std::bad_alloc &) {
+        break;
+      }
+      seen_generation_ = generation_;
+      seen_.notify_all();
+      lock.unlock();
+
+      guard_conditions[0] = control_->data;
+      for (size_t i = 0u; i < watched.size(); ++i) {
+        guard_conditions[i + 1u] = watched[i].first->data;
+      }
+      rmw_subscriptions_t subscriptions{0u, nullptr};
+      rmw_guard_conditions_t ready{guard_conditions.size(), guard_conditions.data()};
+      rmw_services_t services{0u, nullptr};
+      rmw_clients_t clients{0u, nullptr};
+      rmw_events_t events{0u, nullptr};
+      rmw_ret_t ret = table_->rmw_wait(
+        &subscriptions, &ready, &services, &clients, &events, wait_set_, nullptr);
+      if (RMW_RET_OK == ret) {
+        for (size_t i = 0u; i < watched.size(); ++i) {
+          if (guard_conditions[i + 1u]) {
+            g_unrouted_dispatch_table.rmw_trigger_guard_condition(watched[i].second);
+          }
+        }
+      }
+      rmw_reset_error();
+
+      lock.lock();
+      if (RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret) {
+        break;
+      }
+    }
+    stopped_ = true;
+    seen_.notify_all();
+  }
+
+  const DispatchTable * table_ = nullptr;
+  rmw_wait_set_t * wait_set_ = nullptr;
+  // Triggered whenever the watched guard conditions change, and to stop.
+  rmw_guard_condition_t * control_ = nullptr;
+  std::mutex mutex_;
+  std::condition_variable seen_;
+  // Sibling graph guard conditions, and those of the loaded RMW
+  // implementation to trigger along, plus the number of changes to them
+  // and how many of these the thread has seen.
+  std::vector<std::pair<const rmw_guard_condition_t *, const rmw_guard_condition_t *>> watched_;
+  uint64_t generation_ = 0u;
+  uint64_t seen_generation_ = 0u;
+  bool stopping_ = false;
+  bool stopped_ = false;
+  std::thread thread_;
+};
+
+// Graph watchers of each context created by the loaded RMW implementation,
+// indexed like g_routed_backends.
+using RoutedGraphWatchers = std::array<std::unique_ptr<RoutedGraphWatcher>, max_routed_backends>;
+static HandleMap<std::shared_ptr<RoutedGraphWatchers>> g_routed_graph_watchers;
+
+// Entry points used for other functions when routing calls.
+static rmw_ret_t
+routed_rmw_init(const rmw_init_options_t * options, rmw_context_t * context)
+{
+  rmw_ret_t ret = g_unrouted_dispatch_table.rmw_init(options, context);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+
+  SiblingHandles contexts{};
+  const size_t count = g_routed_backends.size();
+  for (size_t i = 1u; i < count && RMW_RET_OK == ret; ++i) {
+    // initialize with the same options, but those the RMW implementation owns
+    const DispatchTable & table = *g_routed_backends[i]->table;
+    rmw_init_options_t own_options = rmw_get_zero_initialized_init_options();
+    ret = table.rmw_init_options_init(&own_options, options->allocator);
+    if (RMW_RET_OK != ret) {
+      break;
+    }
+    rmw_init_options_t routed_options = *options;
+    routed_options.implementation_identifier = own_options.implementation_identifier;
+    routed_options.impl = own_options.impl;
+    auto routed_context = new (std::nothrow) rmw_context_t(rmw_get_zero_initialized_context());
+    if (!routed_context) {
+      RMW_SET_ERROR_MSG("failed to allocate context");
+      ret = RMW_RET_BAD_ALLOC;
+    } else {
+      ret = table.rmw_init(&routed_options, routed_context);
+      if (RMW_RET_OK == ret) {
+        contexts[i] = routed_context;
+      } else {
+        delete routed_context;
+      }
+    }
+    cleanup_preserving_error([&]() {table.rmw_init_options_fini(&own_options);});
+  }
+
+  std::shared_ptr<RoutedGraphWatchers> graph_watchers;
+  if (RMW_RET_OK == ret && count > 1u) {
+    try {
+      graph_watchers = std::make_shared<RoutedGraphWatchers>();
+      for (size_t i = 1u; i < count && RMW_RET_OK == ret; ++i) {
+        (*graph_watchers)[i] =
+          RoutedGraphWatcher::start(i, static_cast<rmw_context_t *>(contexts[i]));
+        if (!(*graph_watchers)[i]) {
+          ret = RMW_RET_ERROR;
+        }
+      }
+      if (RMW_RET_OK == ret) {
+        g_routed_graph_watchers.insert(context, graph_watchers);
+      }
+    } catch (const std::bad_alloc &) {
+      RMW_SET_ERROR_MSG("failed to allocate graph watchers");
+      ret = RMW_RET_BAD_ALLOC;
+    }
+  }
+  if (RMW_RET_OK == ret) {
+    try {
+      g_routed_contexts.insert(context, contexts);
+      register_handle(context, 0u);
+    } catch (const std::bad_alloc &) {
+      RMW_SET_ERROR_MSG("failed to allocate context siblings");
+      ret = RMW_RET_BAD_ALLOC;
+    }
+  }
+  if (RMW_RET_OK != ret) {
+    cleanup_preserving_error(
+      [&]() {
+        g_routed_graph_watchers.erase(context);
+        graph_watchers.reset();
+        for_each_sibling(
+          contexts, [](const DispatchTable & table, void * sibling) {
+            auto routed_context = static_cast<rmw_context_t *>(sibling);
+            table.rmw_shutdown(routed_context);
+            rmw_ret_t fini_ret = table.rmw_context_fini(routed_context);
+            delete routed_context;
+            return fini_ret;
+          });
+        g_unrouted_dispatch_table.rmw_shutdown(context);
+        g_unrouted_dispatch_table.rmw_context_fini(context);
+      });
+  }
+  return ret;
+}
+
+static rmw_ret_t
+routed_rmw_shutdown(rmw_context_t * context)
+{
+  SiblingHandles contexts;
+  rmw_ret_t ret = RMW_RET_OK;
+  if (context && g_routed_contexts.find(context, contexts)) {
+    // stop watching the graph before the contexts the watchers use go away
+    std::shared_ptr<RoutedGraphWatchers> graph_watchers;
+    if (g_routed_graph_watchers.find(context, graph_watchers)) {
+      g_routed_graph_watchers.erase(context);
+      graph_watchers.reset();
+    }
+    ret = for_each_sibling(
+      contexts, [](const DispatchTable & table, void * sibling) {
+        return table.rmw_shutdown(static_cast<rmw_context_t *>(sibling));
+      });
+  }
+  rmw_ret_t own_ret = g_unrouted_dispatch_table.rmw_shutdown(context);
+  return RMW_RET_OK != own_ret ? own_ret : ret;
+}
+
+static rmw_ret_t
+routed_rmw_context_fini(rmw_context_t * context)
+{
+  unregister_handle(context);
+  rmw_ret_t own_ret = g_unrouted_dispatch_table.rmw_context_fini(context);
+  SiblingHandles contexts;
+  if (RMW_RET_OK != own_ret || !context || !g_routed_contexts.find(context, contexts)) {
+    return own_ret;
+  }
+  g_routed_contexts.erase(context);
+  return for_each_sibling(
+    contexts, [](const DispatchTable & table, void * sibling) {
+      auto routed_context = static_cast<rmw_context_t *>(sibling);
+      rmw_ret_t ret = table.rmw_context_fini(routed_context);
+      delete routed_context;
+      return ret;
+    });
+}
+
+// Have the graph guard condition of a node triggered along with those of its
+// siblings, or stop doing so.
+static void
+watch_routed_graph(
+  const rmw_context_t * context, const rmw_node_t * node, const SiblingHandles & nodes,
+  bool watch)
+{
+  std::shared_ptr<RoutedGraphWatchers> graph_watchers;
+  if (!g_routed_graph_watchers.find(context, graph_watchers)) {
+    return;
+  }
+  const rmw_guard_condition_t * graph_guard_condition =
+    g_unrouted_dispatch_table.rmw_node_get_graph_guard_condition(node);
+  const size_t count = g_routed_backends.size();
+  for (size_t i = 1u; i < count && graph_guard_condition; ++i) {
+    const rmw_guard_condition_t * sibling =
+      g_routed_backends[i]->table->rmw_node_get_graph_guard_condition(
+      static_cast<rmw_node_t *>(nodes[i]));
+    if (!sibling) {
+      continue;
+    }
+    if (watch) {
+      (*graph_watchers)[i]->watch(sibling, graph_guard_condition);
+    } else {
+      (*graph_watchers)[i]->unwatch(sibling);
+    }
+  }
+  // graph changes of the RMW implementations lacking one are not forwarded
+  rmw_reset_error();
+}
+
+static rmw_node_t *
+routed_rmw_create_node(rmw_context_t * context, const char * name, const char * namespace_)
+{
+  rmw_node_t * node = g_unrouted_dispatch_table.rmw_create_node(context, name, namespace_);
+  SiblingHandles contexts;
+  if (!node || !g_routed_contexts.find(context, contexts)) {
+    return node;
+  }
+  SiblingHandles nodes{};
+  nodes[0] = node;
+  auto destroy = [](const DispatchTable & table, void * sibling) {
+      return table.rmw_destroy_node(static_cast<rmw_node_t *>(sibling));
+    };
+  bool created = create_siblings(
+    nodes, [&](const DispatchTable & table, size_t i) {
+      return table.rmw_create_node(static_cast<rmw_context_t *>(contexts[i]), name, namespace_);
+    }, destroy);
+  if (created) {
+    try {
+      watch_routed_graph(context, node, nodes, true);
+      g_routed_nodes.insert(node, nodes);
+      register_handle(node, 0u);
+      return node;
+    } catch (const std::bad_alloc &) {
+      RMW_SET_ERROR_MSG("failed to allocate node siblings");
+      cleanup_preserving_error(
+        [&]() {
+          watch_routed_graph(context, node, nodes, false);
+          for_each_sibling(nodes, destroy);
+        });
+    }
+  }
+  cleanup_preserving_error([&]() {g_unrouted_dispatch_table.rmw_destroy_node(node);});
+  return nullptr;
+}
+
+static rmw_ret_t
+routed_rmw_destroy_node(rmw_node_t * node)
+{
+  SiblingHandles nodes;
+  rmw_ret_t ret = RMW_RET_OK;
+  unregister_handle(node);
+  if (node && g_routed_nodes.find(node, nodes)) {
+    g_routed_nodes.erase(node);
+    watch_routed_graph(node->context, node, nodes, false);
+    ret = for_each_sibling(
+      nodes, [](const DispatchTable & table, void * sibling) {
+        return table.rmw_destroy_node(static_cast<rmw_node_t *>(sibling));
+      });
+  }
+  rmw_ret_t own_ret = g_unrouted_dispatch_table.rmw_destroy_node(node);
+  return RMW_RET_OK != own_ret ? own_ret : ret;
+}
+
+// Forget the events of a publisher or subscription once it is destroyed.
+static void
+forget_routed_events(const void * parent)
+{
+  g_routed_entities.erase_if(
+    [parent](const RoutedEntity & routed) {return routed.parent == parent;});
+}
+
+static rmw_publisher_t *
+routed_rmw_create_publisher(
+  const rmw_node_t * node, const rosidl_message_type_support_t * type_support,
+  const char * topic_name, const rmw_qos_profile_t * qos_profile,
+  const rmw_publisher_options_t * publisher_options)
+{
+  const size_t backend = route_name(topic_name);
+  const rmw_node_t * routed_node = find_routed_node(node, backend);
+  if (node && !routed_node) {
+    return nullptr;
+  }
+  rmw_publisher_t * publisher = g_routed_backends[backend]->table->rmw_create_publisher(
+    routed_node, type_support, topic_name, qos_profile, publisher_options);
+  register_handle(publisher, backend);
+  if (publisher && 0u != backend) {
+    g_routed_entity_count.fetch_add(1u, std::memory_order_release);
+  }
+  return publisher;
+}
+
+static rmw_ret_t
+routed_rmw_destroy_publisher(rmw_node_t * node, rmw_publisher_t * publisher)
+{
+  const size_t backend = find_handle_backend(publisher);
+  rmw_node_t * routed_node = find_routed_node(node, backend);
+  if (node && !routed_node) {
+    return RMW_RET_ERROR;
+  }
+  unregister_handle(publisher);
+  if (0u == backend) {
+    return g_routed_backends[backend]->table->rmw_destroy_publisher(routed_node, publisher);
+  }
+  g_routed_entity_count.fetch_sub(1u, std::memory_order_relaxed);
+  rmw_ret_t ret = g_routed_backends[backend]->table->rmw_destroy_publisher(routed_node, publisher);
+  forget_routed_events(publisher);
+  return ret;
+}
+
+// Listen to the events of an entity created by an RMW implementation other
+// than the loaded one, returning nullptr if it does not support callbacks.
+template<typename EntityT, typename SetCallbackT>
+static std::shared_ptr<RoutedListener>
+listen_routed_entity(size_t backend, EntityT * entity, SetCallbackT DispatchTable::* set_callback)
+{
+  auto listener = std::make_shared<RoutedListener>();
+  rmw_ret_t ret = (g_routed_backends[backend]->table->*set_callback)(
+    entity, RoutedListener::on_event, listener.get());
+  if (RMW_RET_OK != ret) {
+    // rmw_wait() polls it instead
+    rmw_reset_error();
+    return nullptr;
+  }
+  return listener;
+}
+
+// Keep track of which RMW implementation created an entity rmw_wait() may
+// get, and listen to its events, destroying it if that fails.
+template<typename EntityT, typename DestroyT, typename SetCallbackT>
+static EntityT *
+register_routed_entity(
+  rmw_node_t * node, EntityT * entity, size_t backend, DestroyT destroy,
+  SetCallbackT set_callback)
+{
+  if (!entity || 0u == backend) {
+    register_handle(entity, backend);
+    return entity;
+  }
+  // outlives the entity if it is destroyed
+  std::shared_ptr<RoutedListener> listener;
+  try {
+    listener = listen_routed_entity(backend, entity, set_callback);
+    g_routed_entities.insert(entity->data, RoutedEntity{backend, listener, nullptr, {}});
+    register_handle(entity, backend);
+    g_routed_entity_count.fetch_add(1u, std::memory_order_release);
+    return entity;
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to keep track of the RMW implementation calls are routed to");
+    cleanup_preserving_error(
+      [&]() {(g_routed_backends[backend]->table->*destroy)(node, entity);});
+    return nullptr;
+  }
+}
+
+static rmw_subscription_t *
+routed_rmw_create_subscription(
+  const rmw_node_t * node, const rosidl_message_type_support_t * type_support,
+  const char * topic_name, const rmw_qos_profile_t * qos_profile,
+  const rmw_subscription_options_t * subscription_options)
+{
+  const size_t backend = route_name(topic_name);
+  rmw_node_t * routed_node = find_routed_node(node, backend);
+  if (node && !routed_node) {
+    return nullptr;
+  }
+  rmw_subscription_t * subscription = g_routed_backends[backend]->table->rmw_create_subscription(
+    routed_node, type_support, topic_name, qos_profile, subscription_options);
+  return register_routed_entity(
+    routed_node, subscription, backend, &DispatchTable::rmw_destroy_subscription,
+    &DispatchTable::rmw_subscription_set_on_new_message_callback);
+}
+
+static rmw_client_t *
+routed_rmw_create_client(
+  const rmw_node_t * node, const rosidl_service_type_support_t * type_support,
+  const char * service_name, const rmw_qos_profile_t * qos_profile)
+{
+  const size_t backend = route_name(service_name);
+  rmw_node_t * routed_node = find_routed_node(node, backend);
+  if (node && !routed_node) {
+    return nullptr;
+  }
+  rmw_client_t * client = g_routed_backends[backend]->table->rmw_create_client(
+    routed_node, type_support, service_name, qos_profile);
+  return register_routed_entity(
+    routed_node, client, backend, &DispatchTable::rmw_destroy_client,
+    &DispatchTable::rmw_client_set_on_new_response_callback);
+}
+
+static rmw_service_t *
+routed_rmw_create_service(
+  const rmw_node_t * node, const rosidl_service_type_support_t * type_support,
+  const char * service_name, const rmw_qos_profile_t * qos_profile)
+{
+  const size_t backend = route_name(service_name);
+  rmw_node_t * routed_node = find_routed_node(node, backend);
+  if (node && !routed_node) {
+    return nullptr;
+  }
+  rmw_service_t * service = g_routed_backends[backend]->table->rmw_create_service(
+    routed_node, type_support, service_name, qos_profile);
+  return register_routed_entity(
+    routed_node, service, backend, &DispatchTable::rmw_destroy_service,
+    &DispatchTable::rmw_service_set_on_new_request_callback);
+}
+
+// Callbacks are unset before destroying entities, so that none is running
+// once their listener is gone.
+#define ROUTED_DESTROY_ENTRY_POINT(name, EntityT, set_callback) \
+  static rmw_ret_t \
+  routed_ ## name(rmw_node_t * node, EntityT * entity) \
+  { \
+    const size_t backend = find_handle_backend(entity); \
+    rmw_node_t * routed_node = find_routed_node(node, backend); \
+    if (node && !routed_node) { \
+      return RMW_RET_ERROR; \
+    } \
+    unregister_handle(entity); \
+    const DispatchTable * table = g_routed_backends[backend]->table; \
+    if (0u == backend) { \
+      return table->name(routed_node, entity); \
+    } \
+    RoutedEntity routed; \
+    if (g_routed_entities.find(entity->data, routed) && routed.listener) { \
+      table->set_callback(entity, nullptr, nullptr); \
+      rmw_reset_error(); \
+    } \
+    g_routed_entities.erase(entity->data); \
+    g_routed_entity_count.fetch_sub(1u, std::memory_order_relaxed); \
+    rmw_ret_t ret = table->name(routed_node, entity); \
+    forget_routed_events(entity); \
+    return ret; \
+  }
+
+ROUTED_DESTROY_ENTRY_POINT(
+  rmw_destroy_subscription, rmw_subscription_t, rmw_subscription_set_on_new_message_callback)
+ROUTED_DESTROY_ENTRY_POINT(
+  rmw_destroy_client, rmw_client_t, rmw_client_set_on_new_response_callback)
+ROUTED_DESTROY_ENTRY_POINT(
+  rmw_destroy_service, rmw_service_t, rmw_service_set_on_new_request_callback)
+
+// Initialize an event, listening to it if it is one of an entity created by
+// an RMW implementation other than the loaded one.
+template<typename ParentT, typename InitT>
+static rmw_ret_t
+init_routed_event(
+  rmw_event_t * rmw_event, const ParentT * parent, rmw_event_type_t event_type, InitT init)
+{
+  const size_t backend = find_handle_backend(parent);
+  const DispatchTable * table = g_routed_backends[backend]->table;
+  RoutedEntity previous;
+  if (rmw_event && g_routed_entities.find(rmw_event, previous)) {
+    // finalized and initialized anew, while its former parent lives on
+    if (previous.listener) {
+      g_routed_backends[previous.backend]->table->rmw_event_set_callback(
+        &previous.event, nullptr, nullptr);
+      rmw_reset_error();
+    }
+    g_routed_entities.erase(rmw_event);
+  }
+  rmw_ret_t ret = (table->*init)(rmw_event, parent, event_type);
+  if (RMW_RET_OK != ret || 0u == backend) {
+    return ret;
+  }
+  std::shared_ptr<RoutedListener> listener;
+  try {
+    listener = listen_routed_entity(backend, rmw_event, &DispatchTable::rmw_event_set_callback);
+    g_routed_entities.insert(rmw_event, RoutedEntity{backend, listener, parent, *rmw_event});
+  } catch (const std::bad_alloc &) {
+    // rmw_wait() polls it instead
+    if (listener) {
+      table->rmw_event_set_callback(rmw_event, nullptr, nullptr);
+      rmw_reset_error();
+    }
+  }
+  return RMW_RET_OK;
+}
+
+static rmw_ret_t
+routed_rmw_publisher_event_init(
+  rmw_event_t * rmw_event, const rmw_publisher_t * publisher, rmw_event_type_t event_type)
+{
+  return init_routed_event(
+    rmw_event, publisher, event_type, &DispatchTable::rmw_publisher_event_init);
+}
+
+static rmw_ret_t
+routed_rmw_subscription_event_init(
+  rmw_event_t * rmw_event, const rmw_subscription_t * subscription, rmw_event_type_t event_type)
+{
+  return init_routed_event(
+    rmw_event, subscription, event_type, &DispatchTable::rmw_subscription_event_init);
+}
+
+// Set the callback of an entity, on its listener if it has one.
+template<typename EntityT, typename SetCallbackT>
+static rmw_ret_t
+set_routed_callback(
+  const void * key, EntityT * entity, rmw_event_callback_t callback, const void * user_data,
+  SetCallbackT DispatchTable::* set_callback)
+{
+  RoutedEntity routed;
+  if (
+    0u != find_handle_backend(entity) && g_routed_entities.find(key, routed) && routed.listener)
+  {
+    routed.listener->set_callback(callback, user_data);
+    return RMW_RET_OK;
+  }
+  return (find_routed_table(entity)->*set_callback)(entity, callback, user_data);
+}
+
+static rmw_ret_t
+routed_rmw_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription, rmw_event_callback_t callback, const void * user_data)
+{
+  return set_routed_callback(
+    subscription ? subscription->data : nullptr, subscription, callback, user_data,
+    &DispatchTable::rmw_subscription_set_on_new_message_callback);
+}
+
+static rmw_ret_t
+routed_rmw_service_set_on_new_request_callback(
+  rmw_service_t * service, rmw_event_callback_t callback, const void * user_data)
+{
+  return set_routed_callback(
+    service ? service->data : nullptr, service, callback, user_data,
+    &DispatchTable::rmw_service_set_on_new_request_callback);
+}
+
+static rmw_ret_t
+routed_rmw_client_set_on_new_response_callback(
+  rmw_client_t * client, rmw_event_callback_t callback, const void * user_data)
+{
+  return set_routed_callback(
+    client ? client->data : nullptr, client, callback, user_data,
+    &DispatchTable::rmw_client_set_on_new_response_callback);
+}
+
+static rmw_ret_t
+routed_rmw_event_set_callback(
+  rmw_event_t * rmw_event, rmw_event_callback_t callback, const void * user_data)
+{
+  return set_routed_callback(
+    rmw_event, rmw_event, callback, user_data, &DispatchTable::rmw_event_set_callback);
+}
+
+static rmw_ret_t
+routed_rmw_service_server_is_available(
+  const rmw_node_t * node, const rmw_client_t * client, bool * is_available)
+{
+  const size_t backend = find_handle_backend(client);
+  const rmw_node_t * routed_node = find_routed_node(node, backend);
+  if (node && !routed_node) {
+    return RMW_RET_ERROR;
+  }
+  return g_routed_backends[backend]->table->rmw_service_server_is_available(
+    routed_node, client, is_available);
+}
+
+#define ROUTED_COUNT_ENTRY_POINT(name) \
+  static rmw_ret_t routed_ ## name(const rmw_node_t * node, const char * name_arg, size_t * count) \
+  { \
+    const size_t backend = route_name(name_arg); \
+    const rmw_node_t * routed_node = find_routed_node(node, backend); \
+    if (node && !routed_node) { \
+      return RMW_RET_ERROR; \
+    } \
+    return g_routed_backends[backend]->table->name(routed_node, name_arg, count); \
+  }
+
+ROUTED_COUNT_ENTRY_POINT(rmw_count_publishers)
+ROUTED_COUNT_ENTRY_POINT(rmw_count_subscribers)
+ROUTED_COUNT_ENTRY_POINT(rmw_count_clients)
+ROUTED_COUNT_ENTRY_POINT(rmw_count_services)
+
+#define ROUTED_ENDPOINT_INFO_ENTRY_POINT(name) \
+  static rmw_ret_t routed_ ## name( \
+    const rmw_node_t * node, rcutils_allocator_t * allocator, const char * topic_name, \
+    bool no_mangle, rmw_topic_endpoint_info_array_t * endpoints_info) \
+  { \
+    const size_t backend = route_name(topic_name); \
+    const rmw_node_t * routed_node = find_routed_node(node, backend); \
+    if (node && !routed_node) { \
+      return RMW_RET_ERROR; \
+    } \
+    return g_routed_backends[backend]->table->name( \
+      routed_node, allocator, topic_name, no_mangle, endpoints_info); \
+  }
+
+ROUTED_ENDPOINT_INFO_ENTRY_POINT(rmw_get_publishers_info_by_topic)
+ROUTED_ENDPOINT_INFO_ENTRY_POINT(rmw_get_subscriptions_info_by_topic)
+
+static rmw_guard_condition_t *
+routed_rmw_create_guard_condition(rmw_context_t * context)
+{
+  rmw_guard_condition_t * guard_condition =
+    g_unrouted_dispatch_table.rmw_create_guard_condition(context);
+  SiblingHandles contexts;
+  if (!guard_condition || !g_routed_contexts.find(context, contexts)) {
+    return guard_condition;
+  }
+  SiblingHandles guard_conditions{};
+  guard_conditions[0] = guard_condition;
+  auto destroy = [](const DispatchTable & table, void * sibling) {
+      return table.rmw_destroy_guard_condition(static_cast<rmw_guard_condition_t *>(sibling));
+    };
+  bool created = create_siblings(
+    guard_conditions, [&](const DispatchTable & table, size_t i) {
+      return table.rmw_create_guard_condition(static_cast<rmw_context_t *>(contexts[i]));
+    }, destroy);
+  if (created) {
+    try {
+      g_routed_guard_conditions.insert(guard_condition->data, guard_conditions);
+      register_handle(guard_condition, 0u);
+      return guard_condition;
+    } catch (const std::bad_alloc &) {
+      RMW_SET_ERROR_MSG("failed to allocate guard condition siblings");
+      cleanup_preserving_error([&]() {for_each_sibling(guard_conditions, destroy);});
+    }
+  }
+  cleanup_preserving_error(
+    [&]() {g_unrouted_dispatch_table.rmw_destroy_guard_condition(guard_condition);});
+  return nullptr;
+}
+
+static rmw_ret_t
+routed_rmw_destroy_guard_condition(rmw_guard_condition_t * guard_condition)
+{
+  SiblingHandles guard_conditions;
+  rmw_ret_t ret = RMW_RET_OK;
+  unregister_handle(guard_condition);
+  if (guard_condition && g_routed_guard_conditions.find(guard_condition->data, guard_conditions)) {
+    g_routed_guard_conditions.erase(guard_condition->data);
+    ret = for_each_sibling(
+      guard_conditions, [](const DispatchTable & table, void * sibling) {
+        return table.rmw_destroy_guard_condition(static_cast<rmw_guard_condition_t *>(sibling));
+      });
+  }
+  rmw_ret_t own_ret = g_unrouted_dispatch_table.rmw_destroy_guard_condition(guard_condition);
+  return RMW_RET_OK != own_ret ? own_ret : ret;
+}
+
+static rmw_ret_t
+routed_rmw_trigger_guard_condition(const rmw_guard_condition_t * guard_condition)
+{
+  SiblingHandles guard_conditions;
+  rmw_ret_t ret = RMW_RET_OK;
+  if (guard_condition && g_routed_guard_conditions.find(guard_condition->data, guard_conditions)) {
+    ret = for_each_sibling(
+      guard_conditions, [](const DispatchTable & table, void * sibling) {
+        return table.rmw_trigger_guard_condition(static_cast<rmw_guard_condition_t *>(sibling));
+      });
+  }
+  rmw_ret_t own_ret = g_unrouted_dispatch_table.rmw_trigger_guard_condition(guard_condition);
+  return RMW_RET_OK != own_ret ? own_ret : ret;
+}
+
+static rmw_wait_set_t *
+routed_rmw_create_wait_set(rmw_context_t * context, size_t max_conditions)
+{
+  SiblingHandles contexts;
+  if (!context || !g_routed_contexts.find(context, contexts)) {
+    return g_unrouted_dispatch_table.rmw_create_wait_set(context, max_conditions);
+  }
+  if (0u != max_conditions) {
+    // make room for the waker
+    ++max_conditions;
+  }
+  rmw_wait_set_t * wait_set =
+    g_unrouted_dispatch_table.rmw_create_wait_set(context, max_conditions);
+  if (!wait_set) {
+    return nullptr;
+  }
+  RoutedWaitSet routed{};
+  routed.wait_sets[0] = wait_set;
+  auto destroy_wait_set = [](const DispatchTable & table, void * sibling) {
+      return table.rmw_destroy_wait_set(static_cast<rmw_wait_set_t *>(sibling));
+    };
+  auto destroy_waker = [](const DispatchTable & table, void * sibling) {
+      return table.rmw_destroy_guard_condition(static_cast<rmw_guard_condition_t *>(sibling));
+    };
+  bool created = create_siblings(
+    routed.wait_sets, [&](const DispatchTable & table, size_t i) {
+      return table.rmw_create_wait_set(
+        static_cast<rmw_context_t *>(contexts[i]), max_conditions);
+    }, destroy_wait_set);
+  if (created) {
+    routed.wakers[0] = g_unrouted_dispatch_table.rmw_create_guard_condition(context);
+    created = routed.wakers[0] && create_siblings(
+      routed.wakers, [&](const DispatchTable & table, size_t i) {
+        return table.rmw_create_guard_condition(static_cast<rmw_context_t *>(contexts[i]));
+      }, destroy_waker);
+    if (created) {
+      try {
+        g_routed_wait_sets.insert(wait_set, routed);
+        register_handle(wait_set, 0u);
+        return wait_set;
+      } catch (const std::bad_alloc &) {
+        RMW_SET_ERROR_MSG("failed to allocate wait set siblings");
+        cleanup_preserving_error([&]() {for_each_sibling(routed.wakers, destroy_waker);});
+      }
+    }
+    cleanup_preserving_error(
+      [&]() {
+        if (routed.wakers[0]) {
+          destroy_waker(g_unrouted_dispatch_table, routed.wakers[0]);
+        }
+        for_each_sibling(routed.wait_sets, destroy_wait_set);
+      });
+  }
+  cleanup_preserving_error([&]() {g_unrouted_dispatch_table.rmw_destroy_wait_set(wait_set);});
+  return nullptr;
+}
+
+static rmw_ret_t
+routed_rmw_destroy_wait_set(rmw_wait_set_t * wait_set)
+{
+  RoutedWaitSet routed;
+  rmw_ret_t ret = RMW_RET_OK;
+  unregister_handle(wait_set);
+  if (wait_set && g_routed_wait_sets.find(wait_set, routed)) {
+    g_routed_wait_sets.erase(wait_set);
+    ret = for_each_sibling(
+      routed.wait_sets, [](const DispatchTable & table, void * sibling) {
+        return table.rmw_destroy_wait_set(static_cast<rmw_wait_set_t *>(sibling));
+      });
+    auto destroy_waker = [](const DispatchTable & table, void * sibling) {
+        return table.rmw_destroy_guard_condition(static_cast<rmw_guard_condition_t *>(sibling));
+      };
+    rmw_ret_t wakers_ret = for_each_sibling(routed.wakers, destroy_waker);
+    rmw_ret_t waker_ret = destroy_waker(g_unrouted_dispatch_table, routed.wakers[0]);
+    if (RMW_RET_OK == ret) {
+      ret = RMW_RET_OK != wakers_ret ? wakers_ret : waker_ret;
+    }
+  }
+  rmw_ret_t own_ret = g_unrouted_dispatch_table.rmw_destroy_wait_set(wait_set);
+  return RMW_RET_OK != own_ret ? own_ret : ret;
+}
+
+// Subscriptions, guard conditions, services, clients and events, in the
+// order rmw_wait() gets them.
+static constexpr size_t wait_entity_kinds = 5u;
+static constexpr size_t wait_guard_conditions = 1u;
+static constexpr size_t wait_events = 4u;
+
+// Index of entities waited on that were not passed in, i.e. wakers.
+static constexpr size_t waker_index = std::numeric_limits<size_t>::max();
+
+// Entities passed to rmw_wait() one RMW implementation handles, along with
+// their index in the arrays passed in.
+struct RoutedWaitPartition
+{
+  std::array<std::vector<void *>, wait_entity_kinds> entities;
+  std::array<std::vector<size_t>, wait_entity_kinds> indices;
+  // Copy of the above, left with the entities that are ready once waited on.
+  std::array<std::vector<void *>, wait_entity_kinds> ready;
+};
+
+// Wait on the entities of a partition, with the wait set of its RMW
+// implementation.
+static rmw_ret_t
+wait_routed_partition(
+  size_t backend, RoutedWaitPartition & partition, void * wait_set, const rmw_time_t * timeout)
+{
+  for (size_t kind = 0u; kind < wait_entity_kinds; ++kind) {
+    partition.ready[kind] = partition.entities[kind];
+  }
+  rmw_subscriptions_t subscriptions{partition.ready[0].size(), partition.ready[0].data()};
+  rmw_guard_conditions_t guard_conditions{partition.ready[1].size(), partition.ready[1].data()};
+  rmw_services_t services{partition.ready[2].size(), partition.ready[2].data()};
+  rmw_clients_t clients{partition.ready[3].size(), partition.ready[3].data()};
+  rmw_events_t events{partition.ready[4].size(), partition.ready[4].data()};
+  return g_routed_backends[backend]->table->rmw_wait(
+    &subscriptions, &guard_conditions, &services, &clients, &events,
+    static_cast<rmw_wait_set_t *>(wait_set), timeout);
+}
+
+// Whether any entity passed in was left ready in a partition, wakers aside.
+static bool
+has_ready_entity(const RoutedWaitPartition & partition)
+{
+  for (size_t kind = 0u; kind < wait_entity_kinds; ++kind) {
+    for (size_t j = 0u; j < partition.ready[kind].size(); ++j) {
+      if (partition.ready[kind][j] && waker_index != partition.indices[kind][j]) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static rmw_ret_t
+routed_rmw_wait(
+  rmw_subscriptions_t * subscriptions, rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services, rmw_clients_t * clients, rmw_events_t * events,
+  rmw_wait_set_t * wait_set, const rmw_time_t * wait_timeout)
+{
+  // While the loaded RMW implementation created every entity that may be
+  // waited on, it handles the wait on its own: wait sets and guard conditions
+  // with siblings are its own, and nothing needs to be looked up.
+  if (0u == g_routed_entity_count.load(std::memory_order_acquire)) {
+    return g_unrouted_dispatch_table.rmw_wait(
+      subscriptions, guard_conditions, services, clients, events, wait_set, wait_timeout);
+  }
+  RoutedWaitSet routed_wait_set;
+  if (!wait_set || !g_routed_wait_sets.find(wait_set, routed_wait_set)) {
+    return g_unrouted_dispatch_table.rmw_wait(
+      subscriptions, guard_conditions, services, clients, events, wait_set, wait_timeout);
+  }
+  const SiblingHandles & wait_sets = routed_wait_set.wait_sets;
+
+  void ** const entities[wait_entity_kinds] = {
+    subscriptions ? subscriptions->subscribers : nullptr,
+    guard_conditions ? guard_conditions->guard_conditions : nullptr,
+    services ? services->services : nullptr,
+    clients ? clients->clients : nullptr,
+    events ? events->events : nullptr,
+  };
+  const size_t counts[wait_entity_kinds] = {
+    subscriptions ? subscriptions->subscriber_count : 0u,
+    guard_conditions ? guard_conditions->guard_condition_count : 0u,
+    services ? services->service_count : 0u,
+    clients ? clients->client_count : 0u,
+    events ? events->event_count : 0u,
+  };
+
+  // Partition entities by RMW implementation, guard conditions that have
+  // siblings going to the one that blocks, along with the listeners of
+  // entities of the others.
+  thread_local std::array<RoutedWaitPartition, max_routed_backends> partitions;
+  thread_local std::vector<std::pair<size_t, SiblingHandles>> shared_guard_conditions;
+  thread_local std::vector<std::pair<size_t, std::shared_ptr<RoutedListener>>> listeners;
+  const size_t backend_count = g_routed_backends.size();
+  for (size_t backend = 0u; backend < backend_count; ++backend) {
+    for (size_t kind = 0u; kind < wait_entity_kinds; ++kind) {
+      partitions[backend].entities[kind].clear();
+      partitions[backend].indices[kind].clear();
+    }
+  }
+  shared_guard_conditions.clear();
+  listeners.clear();
+  std::bitset<max_routed_backends> involved;
+  size_t blocking_backend = 0u;
+  try {
+    for (size_t kind = 0u; kind < wait_entity_kinds; ++kind) {
+      for (size_t i = 0u; i < counts[kind]; ++i) {
+        void * entity = entities[kind][i];
+        if (!entity) {
+          continue;
+        }
+        size_t backend = 0u;
+        RoutedEntity routed{};
+        if (wait_guard_conditions == kind) {
+          SiblingHandles siblings;
+          if (g_routed_guard_conditions.find(entity, siblings)) {
+            shared_guard_conditions.emplace_back(i, siblings);
+            continue;
+          }
+        } else if (wait_events == kind) {
+          backend = find_routed_backend(
+            static_cast<rmw_event_t *>(entity)->implementation_identifier);
+          if (0u != backend) {
+            g_routed_entities.find(entity, routed);
+          }
+        } else if (g_routed_entities.find(entity, routed)) {
+          backend = routed.backend;
+        }
+        involved.set(backend);
+        partitions[backend].entities[kind].push_back(entity);
+        partitions[backend].indices[kind].push_back(i);
+        if (0u != backend) {
+          listeners.emplace_back(backend, std::move(routed.listener));
+        }
+      }
+    }
+    if (involved.none() || (1u == involved.count() && involved.test(0u))) {
+      // the loaded RMW implementation handles every entity
+      return g_unrouted_dispatch_table.rmw_wait(
+        subscriptions, guard_conditions, services, clients, events, wait_set, wait_timeout);
+    }
+    // Block in the loaded RMW implementation if involved, or else in the
+    // first one involved.
+    while (!involved.test(blocking_backend)) {
+      ++blocking_backend;
+    }
+    RoutedWaitPartition & blocking_partition = partitions[blocking_backend];
+    for (const auto & [index, siblings] : shared_guard_conditions) {
+      void * guard_condition = 0u == blocking_backend ?
+        entities[wait_guard_conditions][index] :
+        static_cast<rmw_guard_condition_t *>(siblings[blocking_backend])->data;
+      blocking_partition.entities[wait_guard_conditions].push_back(guard_condition);
+      blocking_partition.indices[wait_guard_conditions].push_back(index);
+    }
+    if (involved.count() > 1u) {
+      auto waker = static_cast<rmw_guard_condition_t *>(
+        routed_wait_set.wakers[blocking_backend]);
+      blocking_partition.entities[wait_guard_conditions].push_back(waker->data);
+      blocking_partition.indices[wait_guard_conditions].push_back(waker_index);
+    }
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate wait partitions");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  rmw_ret_t ret = RMW_RET_TIMEOUT;
+  if (1u == involved.count()) {
+    ret = wait_routed_partition(
+      blocking_backend, partitions[blocking_backend], wait_sets[blocking_backend], wait_timeout);
+  } else {
+    // RMW implementations cannot wait on entities of one another, so only
+    // one of them blocks, until one of its entities is ready or the callback
+    // of an entity of the others triggers its waker, and the others are
+    // polled without blocking each time it is done.
+    // Entities of RMW implementations that do not support callbacks are
+    // polled every poll_period instead, and may thus be noticed up to
+    // poll_period late.
+    using std::chrono::steady_clock;
+    constexpr std::chrono::nanoseconds poll_period = std::chrono::milliseconds(1);
+    constexpr uint64_t max_timeout_sec = 1000000000u;
+    steady_clock::time_point deadline = steady_clock::time_point::max();
+    if (wait_timeout && wait_timeout->sec < max_timeout_sec) {
+      deadline = steady_clock::now() + std::chrono::seconds(wait_timeout->sec) +
+        std::chrono::nanoseconds(wait_timeout->nsec);
+    }
+    const DispatchTable * blocking_table = g_routed_backends[blocking_backend]->table;
+    auto waker = static_cast<const rmw_guard_condition_t *>(
+      routed_wait_set.wakers[blocking_backend]);
+    bool polling = false;
+    for (const auto & [backend, listener] : listeners) {
+      if (backend == blocking_backend) {
+        continue;
+      }
+      if (listener) {
+        listener->set_waker(blocking_table, waker);
+      } else {
+        polling = true;
+      }
+    }
+
+    while (true) {
+      bool ready = false;
+      for (size_t backend = 0u; backend < backend_count; ++backend) {
+        if (!involved.test(backend) || backend == blocking_backend) {
+          continue;
+        }
+        rmw_time_t no_timeout{0u, 0u};
+        ret = wait_routed_partition(backend, partitions[backend], wait_sets[backend], &no_timeout);
+        if (RMW_RET_OK == ret) {
+          ready = true;
+        } else if (RMW_RET_TIMEOUT != ret) {
+          break;
+        }
+      }
+      if (RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret) {
+        break;
+      }
+
+      rmw_time_t timeout{0u, 0u};
+      const rmw_time_t * blocking_timeout = &timeout;
+      if (!ready) {
+        if (steady_clock::time_point::max() == deadline && !polling) {
+          blocking_timeout = nullptr;
+        } else {
+          std::chrono::nanoseconds remaining = poll_period;
+          if (steady_clock::time_point::max() != deadline) {
+            remaining = deadline - steady_clock::now();
+            if (polling) {
+              remaining = std::min(remaining, poll_period);
+            }
+          }
+          if (remaining > std::chrono::nanoseconds::zero()) {
+            const auto sec = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+            timeout.sec = static_cast<uint64_t>(sec.count());
+            timeout.nsec = static_cast<uint64_t>((remaining - sec).count());
+          }
+        }
+      }
+      ret = wait_routed_partition(
+        blocking_backend, partitions[blocking_backend], wait_sets[blocking_backend],
+        blocking_timeout);
+      if (RMW_RET_OK == ret) {
+        // the waker alone being ready only means polling the others again
+        ready = ready || has_ready_entity(partitions[blocking_backend]);
+      } else if (RMW_RET_TIMEOUT != ret) {
+        break;
+      }
+      if (ready) {
+        ret = RMW_RET_OK;
+        break;
+      }
+      ret = RMW_RET_TIMEOUT;
+      if (steady_clock::now() >= deadline) {
+        break;
+      }
+    }
+
+    for (const auto & [backend, listener] : listeners) {
+      if (listener && backend != blocking_backend) {
+        listener->set_waker(nullptr, nullptr);
+      }
+    }
+  }
+  listeners.clear();
+  if (RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret) {
+    return ret;
+  }
+
+  // Leave only entities that are ready, as the RMW implementations did.
+  thread_local std::array<std::vector<void *>, wait_entity_kinds> originals;
+  for (size_t kind = 0u; kind < wait_entity_kinds; ++kind) {
+    if (!entities[kind]) {
+      continue;
+    }
+    originals[kind].assign(entities[kind], entities[kind] + counts[kind]);
+    std::fill(entities[kind], entities[kind] + counts[kind], nullptr);
+    for (size_t backend = 0u; backend < backend_count; ++backend) {
+      if (!involved.test(backend)) {
+        continue;
+      }
+      const RoutedWaitPartition & partition = partitions[backend];
+      for (size_t j = 0u; j < partition.ready[kind].size(); ++j) {
+        const size_t index = partition.indices[kind][j];
+        if (partition.ready[kind][j] && waker_index != index) {
+          entities[kind][index] = originals[kind][index];
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+static rmw_ret_t
+routed_rmw_set_log_severity(rmw_log_severity_t severity)
+{
+  rmw_ret_t ret = g_unrouted_dispatch_table.rmw_set_log_severity(severity);
+  const size_t count = g_routed_backends.size();
+  for (size_t i = 1u; i < count; ++i) {
+    rmw_ret_t backend_ret = g_routed_backends[i]->table->rmw_set_log_severity(severity);
+    if (RMW_RET_OK == ret) {
+      ret = backend_ret;
+    }
+  }
+  return ret;
+}
+
+// Load every RMW implementation the routing configuration names, if any,
+// besides the loaded one, setting the error message on failure.
+static bool
+load_routed_backends(const std::string & config_path)
+{
+  std::vector<RoutingRule> rules;
+  try {
+    if (!config_path.empty()) {
+      rules = load_routing_rules(config_path);
+    }
+  } catch (const std::exception & e) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to load routing configuration due to %s", e.what());
+    return false;
+  }
+
+  auto loaded = std::make_unique<RoutedBackend>();
+  loaded->index = 0u;
+  loaded->lib = g_rmw_lib;
+  loaded->identifier = g_unrouted_dispatch_table.rmw_get_implementation_identifier();
+  loaded->name = loaded->identifier ? loaded->identifier : "";
+  loaded->table = &g_unrouted_dispatch_table;
+  g_routed_backends.push_back(std::move(loaded));
+
+  for (const RoutingRule & rule : rules) {
+    size_t index = 0u;
+    while (index < g_routed_backends.size() &&
+      g_routed_backends[index]->name != rule.rmw_implementation)
+    {
+      ++index;
+    }
+    if (index == g_routed_backends.size()) {
+      auto backend = std::make_unique<RoutedBackend>();
+      backend->name = rule.rmw_implementation;
+      backend->lib = attempt_to_load_one_rmw(rule.rmw_implementation);
+      if (!backend->lib) {
+        // error message set by attempt_to_load_one_rmw()
+        return false;
+      }
+
+      // Resolve every symbol of the RMW implementation, as for the loaded one.
+      backend->own_table = g_unavailable_dispatch_table;
+      bool has_take_sequence = false;
+      char * table_storage = reinterpret_cast<char *>(&backend->own_table);
+      for (size_t id = 0; id < function_count; ++id) {
+        const DispatchTableEntry & entry = g_dispatch_table_entries[id];
+        void * symbol = nullptr;
+        try {
+          symbol = backend->lib->get_symbol(entry.symbol_name);
+        } catch (const std::exception &) {
+          continue;
+        }
+        std::memcpy(table_storage + entry.offset, &symbol, sizeof(symbol));
+        has_take_sequence = has_take_sequence || function_id_rmw_take_sequence == id;
+      }
+      if (!has_take_sequence) {
+        backend->own_table.rmw_take_sequence = emulated_rmw_take_sequence;
+      }
+      backend->table = &backend->own_table;
+      backend->identifier = backend->own_table.rmw_get_implementation_identifier();
+
+      // Rules may name the loaded RMW implementation by its library name.
+      index = find_routed_backend(backend->identifier);
+      if (
+        !backend->identifier || !g_routed_backends[index]->identifier ||
+        std::strcmp(backend->identifier, g_routed_backends[index]->identifier) != 0)
+      {
+        if (g_routed_backends.size() == max_routed_backends) {
+          RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+            "cannot route calls to more than %zu RMW implementations", max_routed_backends);
+          return false;
+        }
+        index = g_routed_backends.size();
+        backend->index = index;
+        g_routed_backends.push_back(std::move(backend));
+      }
+    }
+    g_routing_rules.push_back(rule);
+    g_routing_rule_backends.push_back(index);
+  }
+  return true;
+}
+
+static void
+clear_routing()
+{
+  g_routed_graph_watchers.clear();
+  g_routed_contexts.clear();
+  g_routed_nodes.clear();
+  g_routed_guard_conditions.clear();
+  g_routed_wait_sets.clear();
+  g_routed_entities.clear();
+  g_routed_entity_count.store(0u, std::memory_order_relaxed);
+  g_handle_backends.clear();
+  g_handle_dispatch = false;
+  g_routing_rules.clear();
+  g_routing_rule_backends.clear();
+  g_routed_backends.clear();
+}
+
+// Route calls to the RMW implementations the given routing configuration
+// names, if any, setting the error message on failure.
+static bool
+install_routing(DispatchTable * table, const std::string & config_path)
+{
+  clear_routing();
+  g_unrouted_dispatch_table = *table;
+  g_handle_dispatch = handle_dispatch_requested();
+  try {
+    if (!load_routed_backends(config_path)) {
+      clear_routing();
+      return false;
+    }
+  } catch (const std::bad_alloc &) {
+    clear_routing();
+    RMW_SET_ERROR_MSG("failed to allocate routing state");
+    return false;
+  }
+
+#define RMW_INTERFACE_FN(name, ...) \
+  table->name = &RoutedEntryPoint<decltype(DispatchTable::name), &DispatchTable::name>::call;
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+  table->rmw_init = routed_rmw_init;
+  table->rmw_shutdown = routed_rmw_shutdown;
+  table->rmw_context_fini = routed_rmw_context_fini;
+  table->rmw_create_node = routed_rmw_create_node;
+  table->rmw_destroy_node = routed_rmw_destroy_node;
+  table->rmw_create_publisher = routed_rmw_create_publisher;
+  table->rmw_destroy_publisher = routed_rmw_destroy_publisher;
+  table->rmw_create_subscription = routed_rmw_create_subscription;
+  table->rmw_destroy_subscription = routed_rmw_destroy_subscription;
+  table->rmw_create_client = routed_rmw_create_client;
+  table->rmw_destroy_client = routed_rmw_destroy_client;
+  table->rmw_create_service = routed_rmw_create_service;
+  table->rmw_destroy_service = routed_rmw_destroy_service;
+  table->rmw_publisher_event_init = routed_rmw_publisher_event_init;
+  table->rmw_subscription_event_init = routed_rmw_subscription_event_init;
+  table->rmw_subscription_set_on_new_message_callback =
+    routed_rmw_subscription_set_on_new_message_callback;
+  table->rmw_service_set_on_new_request_callback = routed_rmw_service_set_on_new_request_callback;
+  table->rmw_client_set_on_new_response_callback = routed_rmw_client_set_on_new_response_callback;
+  table->rmw_event_set_callback = routed_rmw_event_set_callback;
+  table->rmw_service_server_is_available = routed_rmw_service_server_is_available;
+  table->rmw_count_publishers = routed_rmw_count_publishers;
+  table->rmw_count_subscribers = routed_rmw_count_subscribers;
+  table->rmw_count_clients = routed_rmw_count_clients;
+  table->rmw_count_services = routed_rmw_count_services;
+  table->rmw_get_publishers_info_by_topic = routed_rmw_get_publishers_info_by_topic;
+  table->rmw_get_subscriptions_info_by_topic = routed_rmw_get_subscriptions_info_by_topic;
+  table->rmw_create_guard_condition = routed_rmw_create_guard_condition;
+  table->rmw_destroy_guard_condition = routed_rmw_destroy_guard_condition;
+  table->rmw_trigger_guard_condition = routed_rmw_trigger_guard_condition;
+  table->rmw_create_wait_set = routed_rmw_create_wait_set;
+  table->rmw_destroy_wait_set = routed_rmw_destroy_wait_set;
+  table->rmw_wait = routed_rmw_wait;
+  table->rmw_set_log_severity = routed_rmw_set_log_severity;
+  return true;
+}
+
+// Batched publish function of the loaded RMW implementation, if it has one.
+static decltype(&rmw_implementation_publish_batch) g_native_publish_batch = nullptr;
+
+// Published with release semantics once g_resolved_dispatch_table has been
+// populated, so that a single acquire load on the hot path suffices.
+// Points to g_instrumented_dispatch_table instead when collecting call
+// statistics.
+static std::atomic<const DispatchTable *> g_dispatch_table{&g_lazy_dispatch_table};
+
+static std::mutex g_dispatch_table_mutex;
+
+static bool
+bind_now_requested()
+{
+  try {
+    return rcpputils::get_env_var("RMW_IMPLEMENTATION_BIND_NOW") == "1";
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+static const DispatchTable *
+resolve_dispatch_table()
+{
+  std::lock_guard<std::mutex> lock(g_dispatch_table_mutex);
+  const DispatchTable * table = g_dispatch_table.load(std::memory_order_acquire);
+  if (table != &g_lazy_dispatch_table) {
+    return table;
+  }
+
+  std::shared_ptr<rcpputils::SharedLibrary> lib;
+  try {
+    lib = get_library();
+  } catch (const std::exception & e) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "failed to load RMW implementation due to %s", e.what());
+    return nullptr;
+  }
+  if (!lib) {
+    // error message set by load_library()
+    return nullptr;
+  }
+
+  const bool bind_now = bind_now_requested();
+  std::string library_path;
+  if (bind_now) {
+    try {
+      library_path = lib->get_library_path();
+    } catch (const std::exception &) {
+      library_path = "<unknown>";
+    }
+  }
+
+  // Resolve every symbol with a single lookup and without any allocation,
+  // leaving the stubs in place for those that are missing.
+  g_resolved_dispatch_table = bind_now ? g_missing_dispatch_table : g_unresolved_dispatch_table;
+  g_available_functions.reset();
+  char * table_storage = reinterpret_cast<char *>(&g_resolved_dispatch_table);
+  for (size_t id = 0; id < function_count; ++id) {
+    const DispatchTableEntry & entry = g_dispatch_table_entries[id];
+    void * symbol = nullptr;
+    try {
+      symbol = lib->get_symbol(entry.symbol_name);
+    } catch (const std::exception &) {
+      if (bind_now) {
+        g_missing_function_errors[id] = std::string("failed to resolve symbol '") +
+          entry.symbol_name + "' in shared library '" + library_path + "'";
+      }
+      continue;
+    }
+    std::memcpy(table_storage + entry.offset, &symbol, sizeof(symbol));
+    g_available_functions.set(id);
+  }
+
+  if (!g_available_functions.test(function_id_rmw_take_sequence)) {
+    g_resolved_dispatch_table.rmw_take_sequence = emulated_rmw_take_sequence;
+  }
+
+  if (graph_cache_requested()) {
+    install_graph_cache(&g_resolved_dispatch_table);
+  }
+
+  g_content_filter_fallback = get_requested_content_filter_fallback();
+  if (ContentFilterFallback::disabled != g_content_filter_fallback) {
+    install_content_filter_fallback(&g_resolved_dispatch_table);
+  }
+
+  g_native_publish_batch = nullptr;
+  try {
+    if (lib->has_symbol("rmw_publish_batch")) {
+      g_native_publish_batch = reinterpret_cast<decltype(&rmw_implementation_publish_batch)>(
+        lib->get_symbol("rmw_publish_batch"));
+    }
+  } catch (const std::exception &) {
+    // publish one message at a time instead
+  }
+
+  const std::string routing_config = get_requested_routing_config();
+  if (!routing_config.empty() || handle_dispatch_requested()) {
+    if (!install_routing(&g_resolved_dispatch_table, routing_config)) {
+      // error message set by install_routing()
+      return nullptr;
+    }
+    // publishers may belong to any RMW implementation calls are routed to
+    g_native_publish_batch = nullptr;
+  }
+
+  const bool collect_call_statistics = call_statistics_requested();
+  set_call_statistics_enabled(collect_call_statistics);
+  table = collect_call_statistics ? &g_instrumented_dispatch_table : &g_resolved_dispatch_table;
+  g_dispatch_table.store(table, std::memory_order_release);
+  return table;
+}
+
+#ifdef RMW_IMPLEMENTATION_HAS_SDT
+// Is-enabled semaphores of the probes, incremented by tracers while attached.
+extern "C"
+{
+__attribute__((section(".probes"), visibility("hidden")))
+unsigned short rmw_implementation_function_entry_semaphore = 0;
+__attribute__((section(".probes"), visibility("hidden")))
+unsigned short rmw_implementation_function_exit_semaphore = 0;
+}
+#endif
+
+// Entry points used while a tracer is attached to the probes, firing them
+// around the call.
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  static ReturnType traced_ ## name(EXPAND(ARGS_ ## _NR(__VA_ARGS__))) \
+  { \
+    const void * handle = get_traced_handle(FIRST_ARG_VALUE_ ## _NR); \
+    static_cast<void>(handle); \
+    RMW_IMPLEMENTATION_TRACEPOINT_ENTRY(function_id_ ## name, #name, handle); \
+    ReturnType ret = g_dispatch_table.load(std::memory_order_acquire)->name( \
+      EXPAND(ARG_VALUES_ ## _NR(__VA_ARGS__))); \
+    RMW_IMPLEMENTATION_TRACEPOINT_EXIT( \
+      function_id_ ## name, #name, handle, get_traced_return_value(ret)); \
+    return ret; \
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define RMW_INTERFACE_FN(name, ReturnType, error_value, _NR, ...) \
+  ReturnType name(EXPAND(ARGS_ ## _NR(__VA_ARGS__))) \
+  { \
+    if (RMW_IMPLEMENTATION_TRACEPOINTS_ENABLED()) { \
+      return traced_ ## name(EXPAND(ARG_VALUES_ ## _NR(__VA_ARGS__))); \
+    } \
+    return g_dispatch_table.load(std::memory_order_acquire)->name( \
+      EXPAND(ARG_VALUES_ ## _NR(__VA_ARGS__))); \
+  }
+#include "./rmw_interface.def"
+#undef RMW_INTERFACE_FN
+
+void prefetch_symbols(void)
+{
+  // resolve all symbols at once to avoid any lookup later on
+  resolve_dispatch_table();
+}
+
+rmw_ret_t
+rmw_implementation_publish_batch(
+  const rmw_implementation_publish_batch_entry_t * entries,
+  size_t count,
+  size_t * published_count)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(published_count, RMW_RET_INVALID_ARGUMENT);
+  *published_count = 0u;
+  if (!entries && count != 0u) {
+    RMW_SET_ERROR_MSG("entries argument is null");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  const DispatchTable * table = g_dispatch_table.load(std::memory_order_acquire);
+  if (table == &g_lazy_dispatch_table) {
+    table = resolve_dispatch_table();
+    if (!table) {
+      // error message set by resolve_dispatch_table()
+      return RMW_RET_ERROR;
+    }
+  }
+  if (g_native_publish_batch) {
+    return g_native_publish_batch(entries, count, published_count);
+  }
+  for (size_t i = 0u; i < count; ++i) {
+    rmw_ret_t ret =
+      table->rmw_publish(entries[i].publisher, entries[i].ros_message, entries[i].allocation);
+    if (RMW_RET_OK != ret) {
+      return ret;
+    }
+    ++*published_count;
+  }
+  return RMW_RET_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+bool
+is_function_available(const char * function_name)
+{
+  if (!resolve_dispatch_table()) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(g_dispatch_table_mutex);
+  for (size_t id = 0; id < function_count; ++id) {
+    if (std::strcmp(g_dispatch_table_entries[id].symbol_name, function_name) == 0) {
+      return g_available_functions.test(id);
+    }
+  }
+  return false;
+}
+
+void
+unload_library()
+{
+  std::lock_guard<std::mutex> lock(g_dispatch_table_mutex);
+  g_dispatch_table.store(&g_lazy_dispatch_table, std::memory_order_release);
+  g_available_functions.reset();
+  set_call_statistics_enabled(false);
+  invalidate_graph_cache();
+  g_native_publish_batch = nullptr;
+  clear_routing();
+  g_rmw_lib.reset();
+}
+
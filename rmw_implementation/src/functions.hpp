@@ -20,11 +20,16 @@
 
 #include "rcpputils/shared_library.hpp"
 
-#include "./visibility_control.h"
+#include "rmw_implementation/visibility_control.h"
 
 RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
 std::shared_ptr<rcpputils::SharedLibrary> load_library();
 
+/// Load the RMW library like load_library(), given the default RMW implementation.
+RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+std::shared_ptr<rcpputils::SharedLibrary> load_library(
+  const std::string & default_rmw_implementation);
+
 RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
 void * lookup_symbol(
   std::shared_ptr<rcpputils::SharedLibrary> lib,
@@ -42,6 +47,13 @@ void prefetch_symbols(void);
 }
 #endif
 
+/// Check whether the loaded RMW implementation provides the given function.
+/**
+ * The RMW implementation is loaded first, if need be.
+ */
+RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+bool is_function_available(const char * function_name);
+
 RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
 void unload_library();
 
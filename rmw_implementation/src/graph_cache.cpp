@@ -0,0 +1,447 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "graph_cache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/env.hpp"
+
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/topic_endpoint_info.h"
+
+namespace
+{
+
+// Beyond this many entries, a cache is emptied rather than grown, so that
+// queries with ever changing arguments do not make it grow unbounded.
+constexpr size_t max_entry_count = 4096u;
+
+std::atomic<uint64_t> g_generation{0u};
+
+// Implementation data of the graph guard conditions of nodes, as rmw_wait()
+// gets them, along with their count so that rmw_wait() need not lock when
+// there are none.
+std::mutex g_graph_guard_conditions_mutex;
+std::vector<const void *> g_graph_guard_conditions;
+std::atomic<size_t> g_graph_guard_condition_count{0u};
+
+// Maximum age of cached results, if any was requested, or zero.
+std::chrono::steady_clock::duration
+get_max_age()
+{
+  static const std::chrono::steady_clock::duration max_age = []() {
+      try {
+        const std::string value =
+          rcpputils::get_env_var("RMW_IMPLEMENTATION_GRAPH_CACHE_MAX_AGE_MS");
+        if (!value.empty()) {
+          return std::chrono::steady_clock::duration(
+            std::chrono::milliseconds(std::stoul(value)));
+        }
+      } catch (const std::exception &) {
+      }
+      return std::chrono::steady_clock::duration::zero();
+    }();
+  return max_age;
+}
+
+// Results of one kind of graph query, keyed by query.
+template<typename T>
+class QueryCache
+{
+public:
+  std::shared_ptr<const T>
+  lookup(const std::string & key)
+  {
+    const uint64_t generation = g_generation.load(std::memory_order_acquire);
+    const std::chrono::steady_clock::duration max_age = get_max_age();
+    std::chrono::steady_clock::time_point now;
+    if (max_age != std::chrono::steady_clock::duration::zero()) {
+      now = std::chrono::steady_clock::now();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      return nullptr;
+    }
+    if (
+      it->second.generation != generation ||
+      (max_age != std::chrono::steady_clock::duration::zero() &&
+      now - it->second.stored_at > max_age))
+    {
+      entries_.erase(it);
+      return nullptr;
+    }
+    return it->second.value;
+  }
+
+  // To be called with the generation loaded before querying, so that results
+  // racing with an invalidation are never stored as current.
+  void
+  store(const std::string & key, uint64_t generation, T value)
+  {
+    Entry entry{generation, std::chrono::steady_clock::now(),
+      std::make_shared<const T>(std::move(value))};
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.size() >= max_entry_count) {
+      entries_.clear();
+    }
+    entries_[key] = std::move(entry);
+  }
+
+private:
+  struct Entry
+  {
+    uint64_t generation;
+    std::chrono::steady_clock::time_point stored_at;
+    std::shared_ptr<const T> value;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, Entry> entries_;
+};
+
+using NamesAndTypes = std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+struct NodeNames
+{
+  std::vector<std::string> names;
+  std::vector<std::string> namespaces;
+  std::vector<std::string> enclaves;
+};
+
+struct EndpointInfo
+{
+  // with all strings left null
+  rmw_topic_endpoint_info_t info;
+  std::string node_name;
+  std::string node_namespace;
+  std::string topic_type;
+};
+
+QueryCache<NamesAndTypes> g_names_and_types_cache;
+QueryCache<NodeNames> g_node_names_cache;
+QueryCache<size_t> g_count_cache;
+QueryCache<std::vector<EndpointInfo>> g_endpoint_info_cache;
+
+std::string
+to_string(const char * str)
+{
+  return str ? str : "";
+}
+
+std::vector<std::string>
+to_strings(const rcutils_string_array_t & array)
+{
+  return std::vector<std::string>(array.data, array.data + array.size);
+}
+
+rmw_ret_t
+to_string_array(
+  const std::vector<std::string> & strings, rcutils_string_array_t * array)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  if (RCUTILS_RET_OK != rcutils_string_array_init(array, strings.size(), &allocator)) {
+    return RMW_RET_BAD_ALLOC;
+  }
+  for (size_t i = 0u; i < strings.size(); ++i) {
+    array->data[i] = rcutils_strdup(strings[i].c_str(), allocator);
+    if (!array->data[i]) {
+      return RMW_RET_BAD_ALLOC;
+    }
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+copy_names_and_types(
+  const NamesAndTypes & cached,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * names_and_types)
+{
+  if (cached.empty()) {
+    return RMW_RET_OK;
+  }
+  rmw_ret_t ret = rmw_names_and_types_init(names_and_types, cached.size(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  for (size_t i = 0u; i < cached.size(); ++i) {
+    names_and_types->names.data[i] = rcutils_strdup(cached[i].first.c_str(), *allocator);
+    if (!names_and_types->names.data[i]) {
+      ret = RMW_RET_BAD_ALLOC;
+      break;
+    }
+    const std::vector<std::string> & types = cached[i].second;
+    rcutils_string_array_t * types_array = &names_and_types->types[i];
+    if (RCUTILS_RET_OK != rcutils_string_array_init(types_array, types.size(), allocator)) {
+      ret = RMW_RET_BAD_ALLOC;
+      break;
+    }
+    for (size_t j = 0u; j < types.size() && RMW_RET_OK == ret; ++j) {
+      types_array->data[j] = rcutils_strdup(types[j].c_str(), *allocator);
+      if (!types_array->data[j]) {
+        ret = RMW_RET_BAD_ALLOC;
+      }
+    }
+    if (RMW_RET_OK != ret) {
+      break;
+    }
+  }
+  if (RMW_RET_OK != ret) {
+    RMW_SET_ERROR_MSG("failed to copy cached names and types");
+    static_cast<void>(rmw_names_and_types_fini(names_and_types));
+  }
+  return ret;
+}
+
+rmw_ret_t
+copy_endpoint_info(
+  const std::vector<EndpointInfo> & cached,
+  rcutils_allocator_t * allocator,
+  rmw_topic_endpoint_info_array_t * endpoints_info)
+{
+  if (cached.empty()) {
+    return RMW_RET_OK;
+  }
+  rmw_ret_t ret =
+    rmw_topic_endpoint_info_array_init_with_size(endpoints_info, cached.size(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  for (size_t i = 0u; i < cached.size() && RMW_RET_OK == ret; ++i) {
+    rmw_topic_endpoint_info_t * info = &endpoints_info->info_array[i];
+    *info = cached[i].info;
+    ret = rmw_topic_endpoint_info_set_node_name(info, cached[i].node_name.c_str(), allocator);
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_node_namespace(
+        info, cached[i].node_namespace.c_str(), allocator);
+    }
+    if (RMW_RET_OK == ret) {
+      ret = rmw_topic_endpoint_info_set_topic_type(info, cached[i].topic_type.c_str(), allocator);
+    }
+  }
+  if (RMW_RET_OK != ret) {
+    static_cast<void>(rmw_topic_endpoint_info_array_fini(endpoints_info, allocator));
+  }
+  return ret;
+}
+
+}  // namespace
+
+bool
+graph_cache_requested()
+{
+  try {
+    return rcpputils::get_env_var("RMW_IMPLEMENTATION_GRAPH_CACHE") == "1";
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+void
+invalidate_graph_cache()
+{
+  g_generation.fetch_add(1u, std::memory_order_acq_rel);
+}
+
+void
+register_graph_guard_condition(const void * data)
+{
+  std::lock_guard<std::mutex> lock(g_graph_guard_conditions_mutex);
+  g_graph_guard_conditions.push_back(data);
+  g_graph_guard_condition_count.store(g_graph_guard_conditions.size(), std::memory_order_release);
+}
+
+void
+unregister_graph_guard_condition(const void * data)
+{
+  std::lock_guard<std::mutex> lock(g_graph_guard_conditions_mutex);
+  auto it = std::find(g_graph_guard_conditions.begin(), g_graph_guard_conditions.end(), data);
+  if (it != g_graph_guard_conditions.end()) {
+    *it = g_graph_guard_conditions.back();
+    g_graph_guard_conditions.pop_back();
+  }
+  g_graph_guard_condition_count.store(g_graph_guard_conditions.size(), std::memory_order_release);
+}
+
+void
+invalidate_graph_cache_on_ready(const rmw_guard_conditions_t * guard_conditions)
+{
+  if (
+    !guard_conditions || 0u == guard_conditions->guard_condition_count ||
+    0u == g_graph_guard_condition_count.load(std::memory_order_acquire))
+  {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(g_graph_guard_conditions_mutex);
+  for (size_t i = 0u; i < guard_conditions->guard_condition_count; ++i) {
+    const void * data = guard_conditions->guard_conditions[i];
+    if (
+      data && std::find(
+        g_graph_guard_conditions.begin(), g_graph_guard_conditions.end(),
+        data) != g_graph_guard_conditions.end())
+    {
+      invalidate_graph_cache();
+      return;
+    }
+  }
+}
+
+rmw_ret_t
+cached_names_and_types_query(
+  const std::string & key,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * names_and_types,
+  const std::function<rmw_ret_t()> & query)
+{
+  std::shared_ptr<const NamesAndTypes> cached = g_names_and_types_cache.lookup(key);
+  if (cached) {
+    return copy_names_and_types(*cached, allocator, names_and_types);
+  }
+  const uint64_t generation = g_generation.load(std::memory_order_acquire);
+  rmw_ret_t ret = query();
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  try {
+    NamesAndTypes result;
+    result.reserve(names_and_types->names.size);
+    for (size_t i = 0u; i < names_and_types->names.size; ++i) {
+      result.emplace_back(
+        names_and_types->names.data[i], to_strings(names_and_types->types[i]));
+    }
+    g_names_and_types_cache.store(key, generation, std::move(result));
+  } catch (const std::exception &) {
+    // the cache is only an optimization
+  }
+  return ret;
+}
+
+rmw_ret_t
+cached_node_names_query(
+  const std::string & key,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  rcutils_string_array_t * enclaves,
+  const std::function<rmw_ret_t()> & query)
+{
+  std::shared_ptr<const NodeNames> cached = g_node_names_cache.lookup(key);
+  if (cached) {
+    rmw_ret_t ret = to_string_array(cached->names, node_names);
+    if (RMW_RET_OK == ret) {
+      ret = to_string_array(cached->namespaces, node_namespaces);
+    }
+    if (RMW_RET_OK == ret && enclaves) {
+      ret = to_string_array(cached->enclaves, enclaves);
+    }
+    if (RMW_RET_OK != ret) {
+      RMW_SET_ERROR_MSG("failed to copy cached node names");
+      static_cast<void>(rcutils_string_array_fini(node_names));
+      static_cast<void>(rcutils_string_array_fini(node_namespaces));
+      if (enclaves) {
+        static_cast<void>(rcutils_string_array_fini(enclaves));
+      }
+    }
+    return ret;
+  }
+  const uint64_t generation = g_generation.load(std::memory_order_acquire);
+  rmw_ret_t ret = query();
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  try {
+    NodeNames result;
+    result.names = to_strings(*node_names);
+    result.namespaces = to_strings(*node_namespaces);
+    if (enclaves) {
+      result.enclaves = to_strings(*enclaves);
+    }
+    g_node_names_cache.store(key, generation, std::move(result));
+  } catch (const std::exception &) {
+    // the cache is only an optimization
+  }
+  return ret;
+}
+
+rmw_ret_t
+cached_count_query(
+  const std::string & key,
+  size_t * count,
+  const std::function<rmw_ret_t()> & query)
+{
+  std::shared_ptr<const size_t> cached = g_count_cache.lookup(key);
+  if (cached) {
+    *count = *cached;
+    return RMW_RET_OK;
+  }
+  const uint64_t generation = g_generation.load(std::memory_order_acquire);
+  rmw_ret_t ret = query();
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  try {
+    g_count_cache.store(key, generation, *count);
+  } catch (const std::exception &) {
+    // the cache is only an optimization
+  }
+  return ret;
+}
+
+rmw_ret_t
+cached_endpoint_info_query(
+  const std::string & key,
+  rcutils_allocator_t * allocator,
+  rmw_topic_endpoint_info_array_t * endpoints_info,
+  const std::function<rmw_ret_t()> & query)
+{
+  std::shared_ptr<const std::vector<EndpointInfo>> cached = g_endpoint_info_cache.lookup(key);
+  if (cached) {
+    return copy_endpoint_info(*cached, allocator, endpoints_info);
+  }
+  const uint64_t generation = g_generation.load(std::memory_order_acquire);
+  rmw_ret_t ret = query();
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  try {
+    std::vector<EndpointInfo> result;
+    result.reserve(endpoints_info->size);
+    for (size_t i = 0u; i < endpoints_info->size; ++i) {
+      const rmw_topic_endpoint_info_t & info = endpoints_info->info_array[i];
+      EndpointInfo endpoint_info{
+        info, to_string(info.node_name), to_string(info.node_namespace),
+        to_string(info.topic_type)};
+      endpoint_info.info.node_name = nullptr;
+      endpoint_info.info.node_namespace = nullptr;
+      endpoint_info.info.topic_type = nullptr;
+      result.push_back(std::move(endpoint_info));
+    }
+    g_endpoint_info_cache.store(key, generation, std::move(result));
+  } catch (const std::exception &) {
+    // the cache is only an optimization
+  }
+  return ret;
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRAPH_CACHE_HPP_
+#define GRAPH_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "rcutils/allocator.h"
+#include "rcutils/types/string_array.h"
+
+#include "rmw/names_and_types.h"
+#include "rmw/topic_endpoint_info_array.h"
+#include "rmw/types.h"
+
+// The graph cache memoizes the results of graph queries, keyed by their
+// arguments, when the RMW_IMPLEMENTATION_GRAPH_CACHE environment variable is
+// set to 1 by the time the RMW implementation is loaded.
+// Cached results are dropped whenever an entity is created or destroyed
+// through this library, and whenever rmw_wait() returns the graph guard
+// condition of a node as ready, which is how changes made by other processes
+// are noticed; both bump the cache generation.
+// Graph guard conditions are only observed on their way out of rmw_wait(),
+// never waited on, so that their triggers still reach their actual users.
+// Setting RMW_IMPLEMENTATION_GRAPH_CACHE_MAX_AGE_MS additionally expires
+// cached results after that many milliseconds, for processes that query the
+// graph without ever waiting on graph guard conditions.
+// Only successful results are cached, and callers get their own copies.
+
+/// Check whether graph query caching was requested via the environment.
+bool
+graph_cache_requested();
+
+/// Drop all cached graph query results.
+void
+invalidate_graph_cache();
+
+/// Have cached results dropped whenever rmw_wait() returns the guard
+/// condition with the given implementation data as ready.
+/**
+ * \throws std::bad_alloc if it cannot be kept track of.
+ */
+void
+register_graph_guard_condition(const void * data);
+
+void
+unregister_graph_guard_condition(const void * data);
+
+/// Drop all cached graph query results if any of the guard conditions left
+/// by rmw_wait() is a registered graph guard condition.
+void
+invalidate_graph_cache_on_ready(const rmw_guard_conditions_t * guard_conditions);
+
+/// Get names and types from the cache, or from `query` and cache them.
+rmw_ret_t
+cached_names_and_types_query(
+  const std::string & key,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * names_and_types,
+  const std::function<rmw_ret_t()> & query);
+
+/// Get node names, namespaces and, if not null, enclaves from the cache, or
+/// from `query` and cache them.
+rmw_ret_t
+cached_node_names_query(
+  const std::string & key,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  rcutils_string_array_t * enclaves,
+  const std::function<rmw_ret_t()> & query);
+
+/// Get a count from the cache, or from `query` and cache it.
+rmw_ret_t
+cached_count_query(
+  const std::string & key,
+  size_t * count,
+  const std::function<rmw_ret_t()> & query);
+
+/// Get endpoint information from the cache, or from `query` and cache it.
+rmw_ret_t
+cached_endpoint_info_query(
+  const std::string & key,
+  rcutils_allocator_t * allocator,
+  rmw_topic_endpoint_info_array_t * endpoints_info,
+  const std::function<rmw_ret_t()> & query);
+
+inline void
+append_graph_query_key_part(std::string & key, const char * arg)
+{
+  key += arg ? arg : "";
+  key += '\0';
+}
+
+inline void
+append_graph_query_key_part(std::string & key, bool arg)
+{
+  key += arg ? '1' : '0';
+}
+
+/// Build the key of a graph query out of the function name and its arguments.
+template<typename ... Args>
+std::string
+make_graph_query_key(const char * function_name, const rmw_node_t * node, Args... args)
+{
+  std::string key(function_name);
+  key += '\0';
+  key += std::to_string(reinterpret_cast<uintptr_t>(node));
+  key += '\0';
+  (append_graph_query_key_part(key, args), ...);
+  return key;
+}
+
+#endif  // GRAPH_CACHE_HPP_
@@ -0,0 +1,331 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "./handle_registry.hpp"
+
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+#include "rcpputils/env.hpp"
+
+// Smallest table, with 64 slots.
+static constexpr unsigned int min_table_bits = 6u;
+
+namespace
+{
+
+// Table a thread is looking up handles in, if any, which must not be freed
+// meanwhile.
+// Hazard pointers are shared by all registries, and only ever reused, never
+// freed, as threads may still exit after static destruction.
+struct HazardPointer
+{
+  std::atomic<const void *> table{nullptr};
+  std::atomic<bool> in_use{false};
+  HazardPointer * next{nullptr};
+};
+
+std::atomic<HazardPointer *> g_hazard_pointers{nullptr};
+
+HazardPointer *
+allocate_hazard_pointer() noexcept
+{
+  HazardPointer * hazard = g_hazard_pointers.load(std::memory_order_acquire);
+  for (; hazard; hazard = hazard->next) {
+    if (!hazard->in_use.load(std::memory_order_relaxed) &&
+      !hazard->in_use.exchange(true, std::memory_order_acquire))
+    {
+      return hazard;
+    }
+  }
+  hazard = new (std::nothrow) HazardPointer();
+  if (!hazard) {
+    return nullptr;
+  }
+  hazard->in_use.store(true, std::memory_order_relaxed);
+  hazard->next = g_hazard_pointers.load(std::memory_order_relaxed);
+  while (!g_hazard_pointers.compare_exchange_weak(
+      hazard->next, hazard, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+  return hazard;
+}
+
+// Whether the hazard pointer of the calling thread was released already.
+// Being trivially destructible, it remains usable by destructors of other
+// thread_local objects which may still look handles up afterwards.
+thread_local bool t_hazard_pointer_released = false;
+
+struct ThreadHazardPointer
+{
+  ~ThreadHazardPointer()
+  {
+    t_hazard_pointer_released = true;
+    if (hazard) {
+      hazard->in_use.store(false, std::memory_order_release);
+    }
+  }
+
+  HazardPointer * hazard{allocate_hazard_pointer()};
+};
+
+HazardPointer *
+get_hazard_pointer() noexcept
+{
+  if (t_hazard_pointer_released) {
+    return nullptr;
+  }
+  thread_local ThreadHazardPointer thread_hazard_pointer;
+  return thread_hazard_pointer.hazard;
+}
+
+bool
+is_hazardous(const void * table) noexcept
+{
+  HazardPointer * hazard = g_hazard_pointers.load(std::memory_order_acquire);
+  for (; hazard; hazard = hazard->next) {
+    if (hazard->table.load(std::memory_order_seq_cst) == table) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+bool
+handle_dispatch_requested()
+{
+  try {
+    return rcpputils::get_env_var("RMW_IMPLEMENTATION_HANDLE_DISPATCH") == "1";
+  } catch (const std::exception &) {
+    return false;
+  }
+}
+
+HandleRegistry::Table::Table(unsigned int table_bits)
+: bits(table_bits), mask((static_cast<size_t>(1u) << table_bits) - 1u),
+  slots(std::make_unique<Slot[]>(mask + 1u))
+{
+}
+
+HandleRegistry::HandleRegistry()
+{
+  tables_.push_back(std::make_unique<Table>(min_table_bits));
+  table_.store(tables_.back().get(), std::memory_order_release);
+}
+
+HandleRegistry::~HandleRegistry() = default;
+
+size_t
+HandleRegistry::home_index(const Table & table, const void * handle) noexcept
+{
+  // Fibonacci hashing, as handles are aligned heap addresses.
+  const uint64_t key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+  return static_cast<size_t>((key * UINT64_C(0x9E3779B97F4A7C15)) >> (64u - table.bits));
+}
+
+void
+HandleRegistry::begin_write() noexcept
+{
+  sequence_.store(sequence_.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+void
+HandleRegistry::end_write() noexcept
+{
+  sequence_.store(sequence_.load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+}
+
+void
+HandleRegistry::grow()
+{
+  const Table & table = *tables_.back();
+  auto grown = std::make_unique<Table>(table.bits + 1u);
+  for (size_t i = 0u; i <= table.mask; ++i) {
+    const void * handle = table.slots[i].handle.load(std::memory_order_relaxed);
+    if (!handle) {
+      continue;
+    }
+    size_t index = home_index(*grown, handle);
+    while (grown->slots[index].handle.load(std::memory_order_relaxed)) {
+      index = (index + 1u) & grown->mask;
+    }
+    grown->slots[index].handle.store(handle, std::memory_order_relaxed);
+    grown->slots[index].value.store(
+      table.slots[i].value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  // The new table is fully populated before being published, and published
+  // before hazard pointers are checked for the outgrown one.
+  tables_.push_back(std::move(grown));
+  table_.store(tables_.back().get(), std::memory_order_seq_cst);
+}
+
+void
+HandleRegistry::reclaim()
+{
+  for (auto it = tables_.begin(); it != tables_.end() - 1; ) {
+    if (is_hazardous(it->get())) {
+      ++it;
+    } else {
+      it = tables_.erase(it);
+    }
+  }
+}
+
+void
+HandleRegistry::insert(const void * handle, const void * value)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (2u * (size_ + 1u) > tables_.back()->mask + 1u) {
+    tables_.reserve(tables_.size() + 1u);
+    grow();
+  }
+  Table & table = *tables_.back();
+  size_t index = home_index(table, handle);
+  const void * current = table.slots[index].handle.load(std::memory_order_relaxed);
+  while (current && current != handle) {
+    index = (index + 1u) & table.mask;
+    current = table.slots[index].handle.load(std::memory_order_relaxed);
+  }
+  begin_write();
+  table.slots[index].value.store(value, std::memory_order_relaxed);
+  table.slots[index].handle.store(handle, std::memory_order_relaxed);
+  end_write();
+  if (!current) {
+    ++size_;
+  }
+  if (tables_.size() > 1u) {
+    reclaim();
+  }
+}
+
+void
+HandleRegistry::erase(const void * handle)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  Table & table = *tables_.back();
+  size_t index = home_index(table, handle);
+  const void * current = table.slots[index].handle.load(std::memory_order_relaxed);
+  while (current && current != handle) {
+    index = (index + 1u) & table.mask;
+    current = table.slots[index].handle.load(std::memory_order_relaxed);
+  }
+  if (!current) {
+    return;
+  }
+
+  // Shift back entries probed past the erased one, so that no lookup stops
+  // short of them, instead of leaving a tombstone.
+  begin_write();
+  size_t hole = index;
+  for (size_t next = (hole + 1u) & table.mask; ; next = (next + 1u) & table.mask) {
+    const void * moved = table.slots[next].handle.load(std::memory_order_relaxed);
+    if (!moved) {
+      break;
+    }
+    const size_t home = home_index(table, moved);
+    // Move the entry unless its home lies cyclically within (hole, next].
+    if (((next - home) & table.mask) >= ((next - hole) & table.mask)) {
+      table.slots[hole].handle.store(moved, std::memory_order_relaxed);
+      table.slots[hole].value.store(
+        table.slots[next].value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      hole = next;
+    }
+  }
+  table.slots[hole].handle.store(nullptr, std::memory_order_relaxed);
+  table.slots[hole].value.store(nullptr, std::memory_order_relaxed);
+  end_write();
+  --size_;
+  if (tables_.size() > 1u) {
+    reclaim();
+  }
+}
+
+const void *
+HandleRegistry::find(const void * handle) const noexcept
+{
+  HazardPointer * hazard = get_hazard_pointer();
+  if (!hazard) {
+    return nullptr;
+  }
+  const void * value = nullptr;
+  for (;;) {
+    const uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    if (sequence & 1u) {
+      // a write is in progress
+      std::this_thread::yield();
+      continue;
+    }
+    // Publish the table about to be probed, and make sure it was not
+    // outgrown meanwhile, lest it be freed under the lookup.
+    const Table * table = table_.load(std::memory_order_relaxed);
+    for (;;) {
+      hazard->table.store(table, std::memory_order_seq_cst);
+      const Table * current_table = table_.load(std::memory_order_seq_cst);
+      if (current_table == table) {
+        break;
+      }
+      table = current_table;
+    }
+    value = nullptr;
+    size_t index = home_index(*table, handle);
+    // Bounded, as slots may change under a concurrent write.
+    for (size_t probes = 0u; probes <= table->mask; ++probes) {
+      const void * current = table->slots[index].handle.load(std::memory_order_relaxed);
+      if (current == handle) {
+        value = table->slots[index].value.load(std::memory_order_relaxed);
+        break;
+      }
+      if (!current) {
+        break;
+      }
+      index = (index + 1u) & table->mask;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) == sequence) {
+      break;
+    }
+  }
+  hazard->table.store(nullptr, std::memory_order_release);
+  return value;
+}
+
+void
+HandleRegistry::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  tables_.erase(tables_.begin(), tables_.end() - 1);
+  Table & table = *tables_.back();
+  begin_write();
+  for (size_t i = 0u; i <= table.mask; ++i) {
+    table.slots[i].handle.store(nullptr, std::memory_order_relaxed);
+    table.slots[i].value.store(nullptr, std::memory_order_relaxed);
+  }
+  end_write();
+  size_ = 0u;
+}
+
+size_t
+HandleRegistry::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
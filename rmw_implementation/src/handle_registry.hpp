@@ -0,0 +1,135 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef HANDLE_REGISTRY_HPP_
+#define HANDLE_REGISTRY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "rmw_implementation/visibility_control.h"
+
+// Calls on handles are dispatched through a registry of the dispatch table
+// each handle was created with, rather than by implementation identifier,
+// when the RMW_IMPLEMENTATION_HANDLE_DISPATCH environment variable is set to 1
+// by the time the RMW implementation is loaded.
+// Handles are registered upon creation and unregistered upon destruction by
+// the routing entry points, which this turns on even without a routing
+// configuration. Lookups that miss fall back to implementation identifiers.
+
+/// Check whether per-handle dispatch was requested via the environment.
+bool
+handle_dispatch_requested();
+
+/// A map from handles to values, e.g. dispatch tables, looked up without
+/// taking any lock.
+/**
+ * Lookups probe an open addressing table guarded by a sequence counter that
+ * insertions and erasures bump, and retry when one of them overlaps.
+ * Lookups publish the table they probe in a hazard pointer of their thread,
+ * and tables outgrown are freed once no hazard pointer refers to them.
+ */
+class HandleRegistry
+{
+public:
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  HandleRegistry();
+
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  ~HandleRegistry();
+
+  HandleRegistry(const HandleRegistry &) = delete;
+  HandleRegistry & operator=(const HandleRegistry &) = delete;
+
+  /// Associate a value, which cannot be null, with a handle.
+  /**
+   * \throws std::bad_alloc if the registry cannot grow.
+   */
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  void
+  insert(const void * handle, const void * value);
+
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  void
+  erase(const void * handle);
+
+  /// Get the value associated with a handle.
+  /**
+   * \return null if there is none, or if the calling thread has no hazard
+   *   pointer, which only happens if one cannot be allocated or while the
+   *   thread exits.
+   */
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  const void *
+  find(const void * handle) const noexcept;
+
+  /// Drop all handles, as well as tables outgrown.
+  /**
+   * Must not overlap with any lookup.
+   */
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  void
+  clear();
+
+  RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+  size_t
+  size() const;
+
+private:
+  struct Slot
+  {
+    std::atomic<const void *> handle{nullptr};
+    std::atomic<const void *> value{nullptr};
+  };
+
+  struct Table
+  {
+    explicit Table(unsigned int table_bits);
+
+    unsigned int bits;
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+  };
+
+  static size_t
+  home_index(const Table & table, const void * handle) noexcept;
+
+  void
+  begin_write() noexcept;
+
+  void
+  end_write() noexcept;
+
+  void
+  grow();
+
+  void
+  reclaim();
+
+  std::atomic<uint64_t> sequence_{0u};
+  std::atomic<Table *> table_{nullptr};
+
+  mutable std::mutex mutex_;
+  size_t size_{0u};
+  // The current table last, preceded by those outgrown that lookups may
+  // still be probing.
+  std::vector<std::unique_ptr<Table>> tables_;
+};
+
+#endif  // HANDLE_REGISTRY_HPP_
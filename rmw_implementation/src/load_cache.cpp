@@ -0,0 +1,151 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "load_cache.hpp"
+
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "ament_index_cpp/get_search_paths.hpp"
+
+#include "rcutils/get_env.h"
+#include "rcutils/process.h"
+
+#include "rcpputils/env.hpp"
+
+static std::filesystem::path
+get_load_cache_path()
+{
+  try {
+    if (rcpputils::get_env_var("RMW_IMPLEMENTATION_LOAD_CACHE") != "1") {
+      return {};
+    }
+    std::filesystem::path ros_home = rcpputils::get_env_var("ROS_HOME");
+    if (ros_home.empty()) {
+      const char * home_dir = rcutils_get_home_dir();
+      if (!home_dir) {
+        return {};
+      }
+      ros_home = std::filesystem::path(home_dir) / ".ros";
+    }
+    return ros_home / "rmw_implementation_load_cache";
+  } catch (const std::exception &) {
+    return {};
+  }
+}
+
+std::string
+compute_load_cache_key(const std::string & candidates)
+{
+  if (get_load_cache_path().empty()) {
+    return {};
+  }
+  try {
+    // The dynamic loader may resolve library names differently depending on
+    // its search path.
+#if defined(_WIN32)
+    const char * library_path_env_var = "PATH";
+#elif defined(__APPLE__)
+    const char * library_path_env_var = "DYLD_LIBRARY_PATH";
+#else
+    const char * library_path_env_var = "LD_LIBRARY_PATH";
+#endif
+    std::string key = candidates;
+    key += ";";
+    key += library_path_env_var;
+    key += "=" + rcpputils::get_env_var(library_path_env_var);
+    for (const std::string & prefix : ament_index_cpp::get_search_paths()) {
+      const std::filesystem::path resource_index =
+        std::filesystem::path(prefix) / "share" / "ament_index" / "resource_index" /
+        "rmw_typesupport";
+      std::error_code ec;
+      const auto mtime = std::filesystem::last_write_time(resource_index, ec);
+      key += ";" + prefix + "@";
+      key += ec ? "-" : std::to_string(mtime.time_since_epoch().count());
+    }
+    return key;
+  } catch (const std::exception &) {
+    return {};
+  }
+}
+
+std::string
+lookup_load_cache(const std::string & key)
+{
+  if (key.empty()) {
+    return {};
+  }
+  try {
+    std::ifstream cache(get_load_cache_path());
+    std::string cached_key;
+    std::string library_path;
+    if (!std::getline(cache, cached_key) || cached_key != key) {
+      return {};
+    }
+    if (!std::getline(cache, library_path)) {
+      return {};
+    }
+    return library_path;
+  } catch (const std::exception &) {
+    return {};
+  }
+}
+
+void
+update_load_cache(const std::string & key, const std::string & library_path)
+{
+  if (key.empty() || library_path.empty()) {
+    return;
+  }
+  try {
+    const std::filesystem::path cache_path = get_load_cache_path();
+    std::error_code ec;
+    std::filesystem::create_directories(cache_path.parent_path(), ec);
+    if (ec) {
+      return;
+    }
+    // Write to a temporary file first and then move it in place, so that
+    // concurrently starting processes never read a partially written cache.
+    // Naming it after the process keeps concurrent writers apart.
+    std::filesystem::path tmp_path = cache_path;
+    tmp_path += "." + std::to_string(rcutils_get_pid());
+    {
+      std::ofstream cache(tmp_path, std::ios::trunc);
+      cache << key << '\n' << library_path << '\n';
+      if (!cache) {
+        cache.close();
+        std::filesystem::remove(tmp_path, ec);
+        return;
+      }
+    }
+    std::filesystem::rename(tmp_path, cache_path, ec);
+    if (ec) {
+      std::filesystem::remove(tmp_path, ec);
+    }
+  } catch (const std::exception &) {
+  }
+}
+
+void
+clear_load_cache()
+{
+  const std::filesystem::path cache_path = get_load_cache_path();
+  if (!cache_path.empty()) {
+    std::error_code ec;
+    std::filesystem::remove(cache_path, ec);
+  }
+}
@@ -0,0 +1,56 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LOAD_CACHE_HPP_
+#define LOAD_CACHE_HPP_
+
+#include <string>
+
+#include "rmw_implementation/visibility_control.h"
+
+// The load cache records, on disk, which RMW library was loaded last time
+// none was requested explicitly and the default one could not be loaded, so
+// that later processes may load it straight away instead of searching for
+// one.
+// It is only looked up once loading the default RMW library failed.
+// It is disabled unless the RMW_IMPLEMENTATION_LOAD_CACHE environment
+// variable is set to 1, in which case it is stored in
+// $ROS_HOME/rmw_implementation_load_cache, with ROS_HOME defaulting to ~/.ros.
+// Failures to read or write the cache are not errors and are silently ignored.
+
+/// Compute the key identifying the current set of available RMW implementations.
+/**
+ * The key covers the ament prefix paths and the modification times of their
+ * RMW implementation resource indices, the search path of the dynamic loader,
+ * plus the given `candidates`.
+ * An empty key is returned if the load cache is disabled or if it cannot
+ * be computed.
+ */
+std::string
+compute_load_cache_key(const std::string & candidates);
+
+/// Get the path of the library recorded for `key`, if any, or an empty string.
+std::string
+lookup_load_cache(const std::string & key);
+
+/// Record `library_path` as the library to load for `key`.
+void
+update_load_cache(const std::string & key, const std::string & library_path);
+
+/// Remove the load cache, if any.
+RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+void
+clear_load_cache();
+
+#endif  // LOAD_CACHE_HPP_
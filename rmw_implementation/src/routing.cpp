@@ -0,0 +1,99 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./routing.hpp"
+
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rcpputils/env.hpp"
+
+std::string
+get_requested_routing_config()
+{
+  try {
+    return rcpputils::get_env_var("RMW_IMPLEMENTATION_ROUTING_CONFIG");
+  } catch (const std::exception &) {
+    return {};
+  }
+}
+
+std::vector<RoutingRule>
+parse_routing_rules(std::istream & input)
+{
+  std::vector<RoutingRule> rules;
+  std::string line;
+  for (size_t line_number = 1u; std::getline(input, line); ++line_number) {
+    std::istringstream fields(line);
+    RoutingRule rule;
+    if (!(fields >> rule.pattern) || '#' == rule.pattern.front()) {
+      continue;
+    }
+    std::string extra;
+    if (!(fields >> rule.rmw_implementation) || (fields >> extra && '#' != extra.front())) {
+      throw std::runtime_error(
+              "line " + std::to_string(line_number) +
+              " is not a pattern followed by an RMW implementation");
+    }
+    rules.push_back(std::move(rule));
+  }
+  return rules;
+}
+
+std::vector<RoutingRule>
+load_routing_rules(const std::string & path)
+{
+  std::ifstream input(path);
+  if (!input) {
+    throw std::runtime_error("cannot open '" + path + "'");
+  }
+  try {
+    return parse_routing_rules(input);
+  } catch (const std::runtime_error & e) {
+    throw std::runtime_error("in '" + path + "', " + e.what());
+  }
+}
+
+bool
+matches_routing_pattern(std::string_view name, std::string_view pattern)
+{
+  // Wildcard matching, backtracking to the last '*' upon mismatch.
+  size_t n = 0u;
+  size_t p = 0u;
+  size_t star = std::string_view::npos;
+  size_t star_n = 0u;
+  while (n < name.size()) {
+    if (p < pattern.size() && name[n] == pattern[p]) {
+      ++n;
+      ++p;
+    } else if (p < pattern.size() && '*' == pattern[p]) {
+      star = p++;
+      star_n = n;
+    } else if (std::string_view::npos != star) {
+      p = star + 1u;
+      n = ++star_n;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && '*' == pattern[p]) {
+    ++p;
+  }
+  return p == pattern.size();
+}
@@ -0,0 +1,126 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ROUTING_HPP_
+#define ROUTING_HPP_
+
+#include <istream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "rmw_implementation/visibility_control.h"
+
+// Several RMW implementations are loaded side by side when the
+// RMW_IMPLEMENTATION_ROUTING_CONFIG environment variable holds the path to a
+// routing configuration file by the time the first one is loaded.
+// Publishers, subscriptions, clients and services are created by the RMW
+// implementation of the first rule matching their topic or service name, or
+// by the one loaded as usual if none does, and calls on them are dispatched
+// to the RMW implementation that created them.
+
+/// A rule routing topics and services to an RMW implementation.
+struct RoutingRule
+{
+  /// Pattern fully qualified names are matched against, in which `*`
+  /// matches any sequence of characters, `/` included.
+  std::string pattern;
+  /// Name of the RMW implementation, e.g. `rmw_cyclonedds_cpp`.
+  std::string rmw_implementation;
+};
+
+/// Get the path of the routing configuration file, as requested via the environment.
+/**
+ * \return an empty string if routing is not requested.
+ */
+std::string
+get_requested_routing_config();
+
+/// Parse routing rules, one per line, as a pattern and an RMW implementation
+/// separated by whitespace.
+/**
+ * Blank lines and lines starting with `#` are ignored.
+ *
+ * \throws std::runtime_error if any line is malformed.
+ */
+RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+std::vector<RoutingRule>
+parse_routing_rules(std::istream & input);
+
+/// Load routing rules from a file.
+/**
+ * \throws std::runtime_error if the file cannot be read or is malformed.
+ */
+RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+std::vector<RoutingRule>
+load_routing_rules(const std::string & path);
+
+/// Check whether a topic or service name matches a routing rule pattern.
+RMW_IMPLEMENTATION_DEFAULT_VISIBILITY
+bool
+matches_routing_pattern(std::string_view name, std::string_view pattern);
+
+/// A thread-safe map from handles to values associated with them.
+template<typename ValueT>
+class HandleMap
+{
+public:
+  /// \throws std::bad_alloc if the map cannot grow.
+  void insert(const void * handle, const ValueT & value)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_[handle] = value;
+  }
+
+  void erase(const void * handle)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.erase(handle);
+  }
+
+  template<typename PredicateT>
+  void erase_if(PredicateT predicate)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = map_.begin(); it != map_.end(); ) {
+      it = predicate(it->second) ? map_.erase(it) : std::next(it);
+    }
+  }
+
+  bool find(const void * handle, ValueT & value) const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = map_.find(handle);
+    if (it == map_.end()) {
+      return false;
+    }
+    value = it->second;
+    return true;
+  }
+
+  void clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    map_.clear();
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::unordered_map<const void *, ValueT> map_;
+};
+
+#endif  // ROUTING_HPP_
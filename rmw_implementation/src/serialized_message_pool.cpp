@@ -0,0 +1,338 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "rmw_implementation/serialized_message_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+namespace
+{
+
+// Buffers of 2^8 bytes, i.e. 256 bytes, to 2^26 bytes, i.e. 64 MiB, are pooled.
+constexpr size_t min_size_class_bits = 8u;
+constexpr size_t max_size_class_bits = 26u;
+constexpr size_t size_class_count = max_size_class_bits - min_size_class_bits + 1u;
+constexpr size_t unpooled = std::numeric_limits<size_t>::max();
+
+// Bytes each thread cache and the shared free list may hold on to, per size
+// class, though the shared free list keeps at least one buffer of every size
+// class, and the number of buffers they may hold on to, per size class.
+constexpr size_t thread_cache_budget = size_t{1u} << 20u;
+constexpr size_t thread_cache_max_buffers = 8u;
+constexpr size_t shared_free_list_budget = size_t{16u} << 20u;
+constexpr size_t shared_free_list_max_buffers = 64u;
+
+// Header preceding every buffer, which keeps payloads maximally aligned.
+struct alignas(alignof(std::max_align_t)) BufferHeader
+{
+  size_t size_class;
+  size_t capacity;
+};
+
+inline size_t
+get_size_class(size_t size)
+{
+  size_t bits = min_size_class_bits;
+  while (bits <= max_size_class_bits && (size_t{1u} << bits) < size) {
+    ++bits;
+  }
+  return bits > max_size_class_bits ? unpooled : bits - min_size_class_bits;
+}
+
+inline size_t
+get_size_class_capacity(size_t size_class)
+{
+  return size_t{1u} << (size_class + min_size_class_bits);
+}
+
+inline BufferHeader *
+get_header(void * pointer)
+{
+  return static_cast<BufferHeader *>(pointer) - 1;
+}
+
+// Lists of free buffers, one per size class, which grow as buffers are
+// returned, up to a few buffers each.
+struct FreeLists
+{
+  FreeLists(size_t budget, size_t min_buffers, size_t max_buffers_per_class)
+  {
+    for (size_t size_class = 0u; size_class < size_class_count; ++size_class) {
+      max_buffers[size_class] = std::min(
+        max_buffers_per_class,
+        std::max(min_buffers, budget / get_size_class_capacity(size_class)));
+    }
+  }
+
+  // Push a buffer, unless the list of its size class is full or cannot grow.
+  bool push(BufferHeader * header)
+  {
+    std::vector<BufferHeader *> & list = lists[header->size_class];
+    if (list.size() >= max_buffers[header->size_class]) {
+      return false;
+    }
+    try {
+      list.push_back(header);
+    } catch (const std::bad_alloc &) {
+      return false;
+    }
+    return true;
+  }
+
+  BufferHeader * pop(size_t size_class)
+  {
+    std::vector<BufferHeader *> & list = lists[size_class];
+    if (list.empty()) {
+      return nullptr;
+    }
+    BufferHeader * header = list.back();
+    list.pop_back();
+    return header;
+  }
+
+  void clear()
+  {
+    for (std::vector<BufferHeader *> & list : lists) {
+      for (BufferHeader * header : list) {
+        std::free(header);
+      }
+      list.clear();
+    }
+  }
+
+  size_t max_buffers[size_class_count];
+  std::vector<BufferHeader *> lists[size_class_count];
+};
+
+struct SharedFreeLists
+{
+  SharedFreeLists()
+  : free_lists(shared_free_list_budget, 1u, shared_free_list_max_buffers)
+  {
+  }
+
+  std::mutex mutex;
+  FreeLists free_lists;
+};
+
+SharedFreeLists &
+get_shared_free_lists()
+{
+  // Never destroyed, as threads may still exit after static destruction.
+  static SharedFreeLists * shared = new SharedFreeLists();
+  return *shared;
+}
+
+// Whether the thread cache of the calling thread was destroyed already.
+// Being trivially destructible, it remains usable by destructors of other
+// thread_local objects which may still deallocate buffers afterwards.
+thread_local bool t_thread_cache_destroyed = false;
+
+// Buffers cached by a thread, handed over to the shared free list as the
+// thread exits.
+struct ThreadCache
+{
+  ThreadCache()
+  : free_lists(thread_cache_budget, 0u, thread_cache_max_buffers)
+  {
+  }
+
+  ~ThreadCache()
+  {
+    t_thread_cache_destroyed = true;
+    SharedFreeLists & shared = get_shared_free_lists();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (std::vector<BufferHeader *> & list : free_lists.lists) {
+      for (BufferHeader * header : list) {
+        if (!shared.free_lists.push(header)) {
+          std::free(header);
+        }
+      }
+      list.clear();
+    }
+  }
+
+  FreeLists free_lists;
+};
+
+// Get the thread cache of the calling thread, or null once it is destroyed,
+// in which case the shared free list is used instead.
+ThreadCache *
+get_thread_cache()
+{
+  if (t_thread_cache_destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadCache cache;
+  return &cache;
+}
+
+void *
+pool_allocate(size_t size, void * state)
+{
+  (void)state;
+  const size_t size_class = get_size_class(size);
+  BufferHeader * header = nullptr;
+  if (unpooled == size_class) {
+    if (size > std::numeric_limits<size_t>::max() - sizeof(BufferHeader)) {
+      return nullptr;
+    }
+    header = static_cast<BufferHeader *>(std::malloc(sizeof(BufferHeader) + size));
+    if (!header) {
+      return nullptr;
+    }
+    header->size_class = unpooled;
+    header->capacity = size;
+    return header + 1;
+  }
+
+  ThreadCache * cache = get_thread_cache();
+  if (cache) {
+    header = cache->free_lists.pop(size_class);
+  }
+  if (!header) {
+    SharedFreeLists & shared = get_shared_free_lists();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    header = shared.free_lists.pop(size_class);
+  }
+  if (!header) {
+    const size_t capacity = get_size_class_capacity(size_class);
+    header = static_cast<BufferHeader *>(std::malloc(sizeof(BufferHeader) + capacity));
+    if (!header) {
+      return nullptr;
+    }
+    header->size_class = size_class;
+    header->capacity = capacity;
+  }
+  return header + 1;
+}
+
+void
+pool_deallocate(void * pointer, void * state)
+{
+  (void)state;
+  if (!pointer) {
+    return;
+  }
+  BufferHeader * header = get_header(pointer);
+  if (unpooled == header->size_class) {
+    std::free(header);
+    return;
+  }
+  ThreadCache * cache = get_thread_cache();
+  if (cache && cache->free_lists.push(header)) {
+    return;
+  }
+  SharedFreeLists & shared = get_shared_free_lists();
+  {
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (shared.free_lists.push(header)) {
+      return;
+    }
+  }
+  std::free(header);
+}
+
+void *
+pool_reallocate(void * pointer, size_t size, void * state)
+{
+  if (!pointer) {
+    return pool_allocate(size, state);
+  }
+  BufferHeader * header = get_header(pointer);
+  if (size <= header->capacity) {
+    return pointer;
+  }
+  void * new_pointer = pool_allocate(size, state);
+  if (!new_pointer) {
+    return nullptr;
+  }
+  std::memcpy(new_pointer, pointer, header->capacity);
+  pool_deallocate(pointer, state);
+  return new_pointer;
+}
+
+void *
+pool_zero_allocate(size_t number_of_elements, size_t size_of_element, void * state)
+{
+  if (size_of_element != 0u &&
+    number_of_elements > std::numeric_limits<size_t>::max() / size_of_element)
+  {
+    return nullptr;
+  }
+  const size_t size = number_of_elements * size_of_element;
+  void * pointer = pool_allocate(size, state);
+  if (pointer) {
+    std::memset(pointer, 0, size);
+  }
+  return pointer;
+}
+
+}  // namespace
+
+rcutils_allocator_t
+rmw_implementation_get_serialized_message_pool_allocator(void)
+{
+  rcutils_allocator_t allocator = rcutils_get_zero_initialized_allocator();
+  allocator.allocate = pool_allocate;
+  allocator.deallocate = pool_deallocate;
+  allocator.reallocate = pool_reallocate;
+  allocator.zero_allocate = pool_zero_allocate;
+  allocator.state = nullptr;
+  return allocator;
+}
+
+rmw_ret_t
+rmw_implementation_serialized_message_init_pooled(
+  rmw_serialized_message_t * serialized_message,
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  size_t default_capacity)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_bounds, RMW_RET_INVALID_ARGUMENT);
+
+  size_t capacity = 0u;
+  if (RMW_RET_OK != rmw_get_serialized_message_size(type_support, message_bounds, &capacity)) {
+    // most RMW implementations cannot tell, then use the default
+    rmw_reset_error();
+    capacity = default_capacity;
+  }
+  rcutils_allocator_t allocator = rmw_implementation_get_serialized_message_pool_allocator();
+  return rmw_serialized_message_init(serialized_message, capacity, &allocator);
+}
+
+void
+rmw_implementation_trim_serialized_message_pool(void)
+{
+  ThreadCache * cache = get_thread_cache();
+  if (cache) {
+    cache->free_lists.clear();
+  }
+  SharedFreeLists & shared = get_shared_free_lists();
+  std::lock_guard<std::mutex> lock(shared.mutex);
+  shared.free_lists.clear();
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef TRACEPOINTS_HPP_
+#define TRACEPOINTS_HPP_
+
+#include <cstdint>
+
+#include "rmw/types.h"
+
+// Static user-space probes (USDT) fired upon entry to and exit from every
+// function of the RMW implementation, under the rmw_implementation provider:
+//
+//   function_entry(function_id, function_name, handle)
+//   function_exit(function_id, function_name, handle, return_value)
+//
+// where `handle` is the first argument of the call if it is a pointer, or
+// NULL otherwise, and `return_value` is either a return code or a pointer.
+// They can be attached to using e.g.
+//
+//   bpftrace -e 'usdt:/path/to/librmw_implementation.so:rmw_implementation:function_entry
+//                { @[str(arg1)] = count(); }'
+//
+// Probes come with the usual is-enabled semaphores, which tracers increment
+// while attached, so that calls only take the traced path while some tracer
+// is attached, even to an already running process.
+
+#ifdef RMW_IMPLEMENTATION_HAS_SDT
+#define _SDT_HAS_SEMAPHORES 1
+#include <sys/sdt.h>
+
+extern "C"
+{
+extern unsigned short rmw_implementation_function_entry_semaphore;
+extern unsigned short rmw_implementation_function_exit_semaphore;
+}
+
+#define RMW_IMPLEMENTATION_TRACEPOINTS_ENABLED() \
+  __builtin_expect( \
+    rmw_implementation_function_entry_semaphore != 0 || \
+    rmw_implementation_function_exit_semaphore != 0, 0)
+
+#define RMW_IMPLEMENTATION_TRACEPOINT_ENTRY(function_id, function_name, handle) \
+  DTRACE_PROBE3(rmw_implementation, function_entry, function_id, function_name, handle)
+
+#define RMW_IMPLEMENTATION_TRACEPOINT_EXIT(function_id, function_name, handle, return_value) \
+  DTRACE_PROBE4( \
+    rmw_implementation, function_exit, function_id, function_name, handle, return_value)
+#else
+#define RMW_IMPLEMENTATION_TRACEPOINTS_ENABLED() false
+#define RMW_IMPLEMENTATION_TRACEPOINT_ENTRY(function_id, function_name, handle)
+#define RMW_IMPLEMENTATION_TRACEPOINT_EXIT(function_id, function_name, handle, return_value)
+#endif
+
+/// Get the handle to report for a call given its first argument.
+template<typename T>
+inline const void *
+get_traced_handle(T * first_arg)
+{
+  return first_arg;
+}
+
+template<typename T>
+inline const void *
+get_traced_handle(const T &)
+{
+  return nullptr;
+}
+
+inline const void *
+get_traced_handle()
+{
+  return nullptr;
+}
+
+/// Get the value to report for a call given its return value.
+inline int64_t
+get_traced_return_value(rmw_ret_t ret)
+{
+  return ret;
+}
+
+inline int64_t
+get_traced_return_value(bool ret)
+{
+  return ret ? 1 : 0;
+}
+
+template<typename T>
+inline int64_t
+get_traced_return_value(T * ret)
+{
+  return static_cast<int64_t>(reinterpret_cast<intptr_t>(ret));
+}
+
+#endif  // TRACEPOINTS_HPP_
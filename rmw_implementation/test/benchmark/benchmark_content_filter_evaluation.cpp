@@ -0,0 +1,160 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/macros.h"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/nested.hpp"
+#include "test_msgs/msg/strings.hpp"
+
+#include "../../src/content_filter.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+// Measures how fast compiled content filters evaluate against messages
+// already taken, independently of any RMW implementation, as well as how
+// long compiling them takes.
+class PerformanceTestContentFilterEvaluation : public PerformanceTest
+{
+protected:
+  // Evaluate the given filter against the same message every iteration.
+  void evaluate(
+    benchmark::State & st, const rosidl_message_type_support_t * ts, const void * message,
+    const std::string & expression, const std::vector<std::string> & parameters = {})
+  {
+    std::unique_ptr<ContentFilter> filter;
+    try {
+      filter = std::make_unique<ContentFilter>(ts, expression, parameters);
+    } catch (const std::invalid_argument & e) {
+      st.SkipWithError(e.what());
+      return;
+    }
+
+    reset_heap_counters();
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      bool matches = filter->matches(message);
+      benchmark::DoNotOptimize(matches);
+    }
+    st.SetItemsProcessed(st.iterations());
+  }
+};
+
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, compile)(benchmark::State & st)
+{
+  const rosidl_message_type_support_t * ts =
+    rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BasicTypes>();
+  const std::string expression =
+    "int32_value > %0 AND (float64_value BETWEEN -1.0 AND 1.0 OR bool_value = TRUE)";
+  const std::vector<std::string> parameters = {"100"};
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    try {
+      ContentFilter filter(ts, expression, parameters);
+      benchmark::DoNotOptimize(filter);
+    } catch (const std::invalid_argument & e) {
+      st.SkipWithError(e.what());
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, comparison)(benchmark::State & st)
+{
+  test_msgs::msg::BasicTypes message;
+  message.int32_value = 42;
+  evaluate(
+    st, rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BasicTypes>(),
+    &message, "int32_value > %0", {"10"});
+}
+
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, comparison_c)(benchmark::State & st)
+{
+  test_msgs__msg__BasicTypes message;
+  if (!test_msgs__msg__BasicTypes__init(&message)) {
+    st.SkipWithError("failed to initialize message");
+    return;
+  }
+  message.int32_value = 42;
+  evaluate(
+    st, ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes), &message,
+    "int32_value > %0", {"10"});
+  test_msgs__msg__BasicTypes__fini(&message);
+}
+
+// All predicates are evaluated, as they all hold.
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, conjunction)(benchmark::State & st)
+{
+  test_msgs::msg::BasicTypes message;
+  message.bool_value = true;
+  message.uint8_value = 8u;
+  message.int32_value = 42;
+  message.float64_value = 0.5;
+  evaluate(
+    st, rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BasicTypes>(),
+    &message,
+    "bool_value = TRUE AND uint8_value <> 3 AND int32_value > 10 AND "
+    "float64_value BETWEEN -1.0 AND 1.0");
+}
+
+// Only the first predicate is evaluated, as it holds.
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, short_circuit)(benchmark::State & st)
+{
+  test_msgs::msg::BasicTypes message;
+  message.bool_value = true;
+  evaluate(
+    st, rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::BasicTypes>(),
+    &message,
+    "bool_value = TRUE OR uint8_value <> 3 OR int32_value > 10 OR "
+    "float64_value BETWEEN -1.0 AND 1.0");
+}
+
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, nested_field)(benchmark::State & st)
+{
+  test_msgs::msg::Nested message;
+  message.basic_types_value.float64_value = 0.5;
+  evaluate(
+    st, rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Nested>(),
+    &message, "basic_types_value.float64_value < 1.0");
+}
+
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, string_equality)(benchmark::State & st)
+{
+  test_msgs::msg::Strings message;
+  message.string_value = "/robot/imu_link";
+  evaluate(
+    st, rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Strings>(),
+    &message, "string_value = %0", {"'/robot/imu_link'"});
+}
+
+BENCHMARK_F(PerformanceTestContentFilterEvaluation, string_like)(benchmark::State & st)
+{
+  test_msgs::msg::Strings message;
+  message.string_value = "/robot/imu_link";
+  evaluate(
+    st, rosidl_typesupport_cpp::get_message_type_support_handle<test_msgs::msg::Strings>(),
+    &message, "string_value LIKE '%imu%'");
+}
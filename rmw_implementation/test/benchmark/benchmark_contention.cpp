@@ -0,0 +1,257 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "../../src/functions.hpp"
+
+// Measures calls made concurrently from 1 to 64 threads, each using entities
+// of its own or all using the same ones, both through the rmw_implementation
+// shim and directly to the loaded RMW implementation.
+// Besides the aggregate throughput, each benchmark reports its scaling
+// efficiency, i.e. the throughput of every thread relative to that of a single
+// thread. Should the shim scale worse than the RMW implementation, threads
+// contend in the dispatch layer, e.g. writing data sharing a cache line with
+// the dispatch table. Calls to rmw_get_implementation_identifier() do next to
+// nothing in the RMW implementation, and thus expose such contention best.
+
+namespace
+{
+
+constexpr char topic_name_prefix[] = "/benchmark_contention_";
+
+// State shared by all threads of a benchmark run, set up and torn down by the
+// first thread only.
+struct SharedState
+{
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  std::vector<rmw_publisher_t *> pubs;
+  std::vector<rmw_subscription_t *> subs;
+  test_msgs__msg__BasicTypes msg{};
+  bool ready{false};
+
+  std::shared_ptr<rcpputils::SharedLibrary> lib;
+  decltype(&rmw_get_implementation_identifier) backend_rmw_get_implementation_identifier{
+    nullptr};
+  decltype(&rmw_publish) backend_rmw_publish{nullptr};
+  decltype(&rmw_take) backend_rmw_take{nullptr};
+};
+
+SharedState g_state;
+
+// Create a publisher and a subscription on a topic of their own per thread.
+bool
+set_up(size_t thread_count)
+{
+  rmw_ret_t ret = rmw_init_options_init(&g_state.init_options, rcutils_get_default_allocator());
+  if (RMW_RET_OK != ret) {
+    return false;
+  }
+  g_state.init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+  ret = rmw_init(&g_state.init_options, &g_state.context);
+  if (RMW_RET_OK != ret) {
+    return false;
+  }
+  g_state.node = rmw_create_node(&g_state.context, "benchmark_contention_node", "/");
+  if (!g_state.node) {
+    return false;
+  }
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+  rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+  for (size_t i = 0; i < thread_count; ++i) {
+    const std::string topic_name = topic_name_prefix + std::to_string(i);
+    rmw_publisher_t * pub = rmw_create_publisher(
+      g_state.node, ts, topic_name.c_str(), &rmw_qos_profile_default, &pub_options);
+    if (!pub) {
+      return false;
+    }
+    g_state.pubs.push_back(pub);
+    rmw_subscription_t * sub = rmw_create_subscription(
+      g_state.node, ts, topic_name.c_str(), &rmw_qos_profile_default, &sub_options);
+    if (!sub) {
+      return false;
+    }
+    g_state.subs.push_back(sub);
+  }
+  if (!test_msgs__msg__BasicTypes__init(&g_state.msg)) {
+    RMW_SET_ERROR_MSG("failed to initialize message");
+    return false;
+  }
+
+  g_state.lib = load_library();
+  g_state.backend_rmw_get_implementation_identifier =
+    reinterpret_cast<decltype(&rmw_get_implementation_identifier)>(
+    lookup_symbol(g_state.lib, "rmw_get_implementation_identifier"));
+  g_state.backend_rmw_publish =
+    reinterpret_cast<decltype(&rmw_publish)>(lookup_symbol(g_state.lib, "rmw_publish"));
+  g_state.backend_rmw_take =
+    reinterpret_cast<decltype(&rmw_take)>(lookup_symbol(g_state.lib, "rmw_take"));
+  return
+    g_state.backend_rmw_get_implementation_identifier &&
+    g_state.backend_rmw_publish &&
+    g_state.backend_rmw_take;
+}
+
+void
+tear_down()
+{
+  g_state.lib.reset();
+  test_msgs__msg__BasicTypes__fini(&g_state.msg);
+  for (rmw_subscription_t * sub : g_state.subs) {
+    rmw_destroy_subscription(g_state.node, sub);
+  }
+  for (rmw_publisher_t * pub : g_state.pubs) {
+    rmw_destroy_publisher(g_state.node, pub);
+  }
+  if (g_state.node) {
+    rmw_destroy_node(g_state.node);
+  }
+  rmw_shutdown(&g_state.context);
+  rmw_context_fini(&g_state.context);
+  rmw_init_options_fini(&g_state.init_options);
+  g_state = SharedState();
+  rmw_reset_error();
+}
+
+// Run a call from every thread, passing it the index of the entities to use,
+// and report throughput and scaling efficiency.
+// The throughput of a single thread is recorded in single_thread_rate.
+template<typename CallT>
+void
+run_concurrently(
+  benchmark::State & st, bool shared_entities, double & single_thread_rate, CallT call)
+{
+  if (0 == st.thread_index()) {
+    g_state.ready = set_up(static_cast<size_t>(st.threads()));
+  }
+  const size_t index = shared_entities ? 0u : static_cast<size_t>(st.thread_index());
+
+  std::chrono::steady_clock::time_point start;
+  bool started = false;
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (!started) {
+      // all threads were set up by now
+      if (!g_state.ready) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+      start = std::chrono::steady_clock::now();
+      started = true;
+    }
+    if (!call(index)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  if (started && elapsed.count() > 0.0) {
+    const double rate = static_cast<double>(st.iterations()) / elapsed.count();
+    if (1 == st.threads()) {
+      single_thread_rate = rate;
+    }
+    if (single_thread_rate > 0.0) {
+      st.counters["scaling_efficiency"] =
+        benchmark::Counter(rate / single_thread_rate, benchmark::Counter::kAvgThreads);
+    }
+  }
+  st.SetItemsProcessed(st.iterations());
+
+  if (0 == st.thread_index()) {
+    tear_down();
+  }
+}
+
+bool
+publish_through_shim(size_t index)
+{
+  return RMW_RET_OK == rmw_publish(g_state.pubs[index], &g_state.msg, nullptr);
+}
+
+bool
+publish_directly(size_t index)
+{
+  return RMW_RET_OK == g_state.backend_rmw_publish(g_state.pubs[index], &g_state.msg, nullptr);
+}
+
+bool
+take_through_shim(size_t index)
+{
+  test_msgs__msg__BasicTypes msg{};
+  bool taken = false;
+  return RMW_RET_OK == rmw_take(g_state.subs[index], &msg, &taken, nullptr);
+}
+
+bool
+take_directly(size_t index)
+{
+  test_msgs__msg__BasicTypes msg{};
+  bool taken = false;
+  return RMW_RET_OK == g_state.backend_rmw_take(g_state.subs[index], &msg, &taken, nullptr);
+}
+
+bool
+get_implementation_identifier_through_shim(size_t)
+{
+  benchmark::DoNotOptimize(rmw_get_implementation_identifier());
+  return true;
+}
+
+bool
+get_implementation_identifier_directly(size_t)
+{
+  benchmark::DoNotOptimize(g_state.backend_rmw_get_implementation_identifier());
+  return true;
+}
+
+}  // namespace
+
+#define CONTENTION_BENCHMARK(name, shared_entities, call) \
+  static void name(benchmark::State & st) \
+  { \
+    static double single_thread_rate = 0.0; \
+    run_concurrently(st, shared_entities, single_thread_rate, call); \
+  } \
+  BENCHMARK(name)->ThreadRange(1, 64)->UseRealTime()
+
+CONTENTION_BENCHMARK(publish_distinct_through_shim, false, publish_through_shim);
+CONTENTION_BENCHMARK(publish_distinct_directly, false, publish_directly);
+CONTENTION_BENCHMARK(publish_shared_through_shim, true, publish_through_shim);
+CONTENTION_BENCHMARK(publish_shared_directly, true, publish_directly);
+CONTENTION_BENCHMARK(take_distinct_through_shim, false, take_through_shim);
+CONTENTION_BENCHMARK(take_distinct_directly, false, take_directly);
+CONTENTION_BENCHMARK(take_shared_through_shim, true, take_through_shim);
+CONTENTION_BENCHMARK(take_shared_directly, true, take_directly);
+CONTENTION_BENCHMARK(
+  get_identifier_through_shim, false, get_implementation_identifier_through_shim);
+CONTENTION_BENCHMARK(get_identifier_directly, false, get_implementation_identifier_directly);
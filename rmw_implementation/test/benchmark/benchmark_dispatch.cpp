@@ -0,0 +1,223 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+#include "../../src/functions.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_dispatch";
+constexpr rmw_time_t zero_timeout{0, 0};
+}  // namespace
+
+// Compares calls through the rmw_implementation shim against calls to the
+// very same functions of the loaded RMW implementation.
+// Also run with calls routed by implementation identifier, and by handle
+// through the handle registry, to measure what each adds per call.
+class PerformanceTestDispatch : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_dispatch_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    const rosidl_message_type_support_t * ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &rmw_qos_profile_default, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &rmw_qos_profile_default, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    if (!test_msgs__msg__BasicTypes__init(&msg)) {
+      st.SkipWithError("failed to initialize message");
+      return;
+    }
+
+    lib = load_library();
+    backend_rmw_publish =
+      reinterpret_cast<decltype(&rmw_publish)>(lookup_symbol(lib, "rmw_publish"));
+    backend_rmw_take =
+      reinterpret_cast<decltype(&rmw_take)>(lookup_symbol(lib, "rmw_take"));
+    backend_rmw_wait =
+      reinterpret_cast<decltype(&rmw_wait)>(lookup_symbol(lib, "rmw_wait"));
+    backend_rmw_get_gid_for_publisher = reinterpret_cast<decltype(&rmw_get_gid_for_publisher)>(
+      lookup_symbol(lib, "rmw_get_gid_for_publisher"));
+    if (
+      !backend_rmw_publish || !backend_rmw_take || !backend_rmw_wait ||
+      !backend_rmw_get_gid_for_publisher)
+    {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    lib.reset();
+    test_msgs__msg__BasicTypes__fini(&msg);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+    }
+    if (node) {
+      rmw_destroy_node(node);
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs__msg__BasicTypes msg{};
+
+  std::shared_ptr<rcpputils::SharedLibrary> lib;
+  decltype(&rmw_publish) backend_rmw_publish{nullptr};
+  decltype(&rmw_take) backend_rmw_take{nullptr};
+  decltype(&rmw_wait) backend_rmw_wait{nullptr};
+  decltype(&rmw_get_gid_for_publisher) backend_rmw_get_gid_for_publisher{nullptr};
+};
+
+BENCHMARK_F(PerformanceTestDispatch, publish_through_shim)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(rmw_publish(pub, &msg, nullptr));
+  }
+}
+
+BENCHMARK_F(PerformanceTestDispatch, publish_directly)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(backend_rmw_publish(pub, &msg, nullptr));
+  }
+}
+
+BENCHMARK_F(PerformanceTestDispatch, take_through_shim)(benchmark::State & st)
+{
+  bool taken = false;
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(rmw_take(sub, &msg, &taken, nullptr));
+  }
+}
+
+BENCHMARK_F(PerformanceTestDispatch, take_directly)(benchmark::State & st)
+{
+  bool taken = false;
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(backend_rmw_take(sub, &msg, &taken, nullptr));
+  }
+}
+
+BENCHMARK_F(PerformanceTestDispatch, wait_through_shim)(benchmark::State & st)
+{
+  void * subscriptions[1];
+  rmw_subscriptions_t subscriptions_set{1, subscriptions};
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    subscriptions[0] = sub->data;
+    benchmark::DoNotOptimize(
+      rmw_wait(&subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &zero_timeout));
+  }
+}
+
+BENCHMARK_F(PerformanceTestDispatch, wait_directly)(benchmark::State & st)
+{
+  void * subscriptions[1];
+  rmw_subscriptions_t subscriptions_set{1, subscriptions};
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    subscriptions[0] = sub->data;
+    benchmark::DoNotOptimize(
+      backend_rmw_wait(
+        &subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &zero_timeout));
+  }
+}
+
+// Cheap enough for dispatch to account for much of the time per call.
+BENCHMARK_F(PerformanceTestDispatch, get_gid_through_shim)(benchmark::State & st)
+{
+  rmw_gid_t gid;
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(rmw_get_gid_for_publisher(pub, &gid));
+  }
+}
+
+BENCHMARK_F(PerformanceTestDispatch, get_gid_directly)(benchmark::State & st)
+{
+  rmw_gid_t gid;
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(backend_rmw_get_gid_for_publisher(pub, &gid));
+  }
+}
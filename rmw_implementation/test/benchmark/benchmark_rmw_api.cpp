@@ -0,0 +1,369 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "rmw_implementation/publish_batch.h"
+
+#include "rosidl_runtime_c/primitives_sequence_functions.h"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/msg/unbounded_sequences.h"
+#include "test_msgs/srv/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char node_name[] = "benchmark_rmw_api_node";
+constexpr char node_namespace[] = "/";
+constexpr char topic_name[] = "/benchmark_rmw_api";
+constexpr char service_name[] = "/benchmark_rmw_api_service";
+constexpr rmw_time_t message_timeout{1, 0};
+constexpr size_t publish_batch_size = 16u;
+}  // namespace
+
+// Provides an initialized context and a node to create entities with.
+class PerformanceTestRmwApi : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, node_name, node_namespace);
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    if (node) {
+      rmw_destroy_node(node);
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+};
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_node)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_node_t * other_node = rmw_create_node(&context, "benchmark_other_node", node_namespace);
+    if (!other_node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_node(other_node)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_publisher)(benchmark::State & st)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rmw_publisher_options_t options = rmw_get_default_publisher_options();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_publisher_t * pub =
+      rmw_create_publisher(node, ts, topic_name, &rmw_qos_profile_default, &options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_publisher(node, pub)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_subscription)(benchmark::State & st)
+{
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  rmw_subscription_options_t options = rmw_get_default_subscription_options();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_subscription_t * sub =
+      rmw_create_subscription(node, ts, topic_name, &rmw_qos_profile_default, &options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_subscription(node, sub)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_client)(benchmark::State & st)
+{
+  const rosidl_service_type_support_t * ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_client_t * client =
+      rmw_create_client(node, ts, service_name, &rmw_qos_profile_services_default);
+    if (!client) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_client(node, client)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_service)(benchmark::State & st)
+{
+  const rosidl_service_type_support_t * ts =
+    ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_service_t * service =
+      rmw_create_service(node, ts, service_name, &rmw_qos_profile_services_default);
+    if (!service) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_service(node, service)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_guard_condition)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_guard_condition_t * guard_condition = rmw_create_guard_condition(&context);
+    if (!guard_condition) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_guard_condition(guard_condition)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestRmwApi, create_destroy_wait_set)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != rmw_destroy_wait_set(wait_set)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+}
+
+// Publishes and takes messages carrying as many bytes as the benchmark
+// argument, between a publisher and a subscription of the same node.
+class PerformanceTestRmwApiPubSub : public PerformanceTestRmwApi
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    PerformanceTestRmwApi::SetUp(st);
+    if (st.error_occurred()) {
+      return;
+    }
+
+    const rosidl_message_type_support_t * ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, UnboundedSequences);
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = 1u;
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &qos, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &qos, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const size_t size = static_cast<size_t>(st.range(0));
+    if (
+      !test_msgs__msg__UnboundedSequences__init(&pub_msg) ||
+      !test_msgs__msg__UnboundedSequences__init(&sub_msg) ||
+      !rosidl_runtime_c__octet__Sequence__init(&pub_msg.byte_values, size))
+    {
+      st.SkipWithError("failed to initialize messages");
+      return;
+    }
+    std::memset(pub_msg.byte_values.data, 0xA5, size);
+
+    // Let discovery complete before measuring anything.
+    if (RMW_RET_OK != rmw_publish(pub, &pub_msg, nullptr) || !take_one()) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    test_msgs__msg__UnboundedSequences__fini(&sub_msg);
+    test_msgs__msg__UnboundedSequences__fini(&pub_msg);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+    }
+
+    PerformanceTestRmwApi::TearDown(st);
+  }
+
+protected:
+  // Wait for a message to arrive, and take it.
+  bool take_one()
+  {
+    void * subscriptions[1] = {sub->data};
+    rmw_subscriptions_t subscriptions_set{1, subscriptions};
+    rmw_ret_t ret =
+      rmw_wait(&subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout);
+    if (RMW_RET_OK != ret) {
+      return false;
+    }
+    bool taken = false;
+    ret = rmw_take(sub, &sub_msg, &taken, nullptr);
+    return RMW_RET_OK == ret && taken;
+  }
+
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs__msg__UnboundedSequences pub_msg{};
+  test_msgs__msg__UnboundedSequences sub_msg{};
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestRmwApiPubSub, publish)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (RMW_RET_OK != rmw_publish(pub, &pub_msg, nullptr)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations());
+  st.SetBytesProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTestRmwApiPubSub, publish)
+->RangeMultiplier(16)->Range(16, 1 << 20);
+
+BENCHMARK_DEFINE_F(PerformanceTestRmwApiPubSub, publish_batch)(benchmark::State & st)
+{
+  const std::vector<rmw_implementation_publish_batch_entry_t> entries(
+    publish_batch_size, rmw_implementation_publish_batch_entry_t{pub, &pub_msg, nullptr});
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    size_t published_count = 0u;
+    if (
+      RMW_RET_OK != rmw_implementation_publish_batch(
+        entries.data(), entries.size(), &published_count))
+    {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * publish_batch_size);
+  st.SetBytesProcessed(st.iterations() * publish_batch_size * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTestRmwApiPubSub, publish_batch)
+->RangeMultiplier(16)->Range(16, 1 << 20);
+
+BENCHMARK_DEFINE_F(PerformanceTestRmwApiPubSub, publish_take_round_trip)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (RMW_RET_OK != rmw_publish(pub, &pub_msg, nullptr)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (!take_one()) {
+      st.SkipWithError("failed to take published message");
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations());
+  st.SetBytesProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTestRmwApiPubSub, publish_take_round_trip)
+->RangeMultiplier(16)->Range(16, 1 << 20);
@@ -13,11 +13,17 @@
 // limitations under the License.
 
 #include <memory>
+#include <string>
 
 #include "performance_test_fixture/performance_test_fixture.hpp"
+#include "rcutils/env.h"
 #include "rcutils/macros.h"
 
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
 #include "../../src/functions.hpp"
+#include "../../src/load_cache.hpp"
 
 using performance_test_fixture::PerformanceTest;
 
@@ -38,3 +44,118 @@ BENCHMARK_F(PerformanceTest, lookup_symbol)(benchmark::State & st)
     lookup_symbol(lib, "rmw_init");
   }
 }
+
+BENCHMARK_F(PerformanceTest, call_through_shim)(benchmark::State & st)
+{
+  prefetch_symbols();
+  if (rmw_get_implementation_identifier() == nullptr) {
+    st.SkipWithError(rmw_get_error_string().str);
+    rmw_reset_error();
+    return;
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(rmw_get_implementation_identifier());
+  }
+}
+
+BENCHMARK_F(PerformanceTest, call_backend_directly)(benchmark::State & st)
+{
+  std::shared_ptr<rcpputils::SharedLibrary> lib = load_library();
+  void * symbol = lookup_symbol(lib, "rmw_get_implementation_identifier");
+  if (!symbol) {
+    st.SkipWithError(rmw_get_error_string().str);
+    rmw_reset_error();
+    return;
+  }
+  typedef const char * (* FunctionSignature)(void);
+  FunctionSignature func = reinterpret_cast<FunctionSignature>(symbol);
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    benchmark::DoNotOptimize(func());
+  }
+}
+
+// Loads the RMW implementation the way it is done when none is requested
+// explicitly via the RMW_IMPLEMENTATION environment variable and the default
+// one cannot be loaded, with the load cache enabled.
+class PerformanceTestLoadLibrary : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    const char * rmw_implementation_env_var = nullptr;
+    if (nullptr != rcutils_get_env("RMW_IMPLEMENTATION", &rmw_implementation_env_var)) {
+      st.SkipWithError("failed to get RMW_IMPLEMENTATION");
+      return;
+    }
+    rmw_implementation = rmw_implementation_env_var;
+    if (!rcutils_set_env("RMW_IMPLEMENTATION", nullptr)) {
+      st.SkipWithError("failed to unset RMW_IMPLEMENTATION");
+      return;
+    }
+    if (!rcutils_set_env("RMW_IMPLEMENTATION_LOAD_CACHE", "1")) {
+      st.SkipWithError("failed to set RMW_IMPLEMENTATION_LOAD_CACHE");
+      return;
+    }
+    clear_load_cache();
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    clear_load_cache();
+    rcutils_set_env("RMW_IMPLEMENTATION_LOAD_CACHE", nullptr);
+    rcutils_set_env("RMW_IMPLEMENTATION", rmw_implementation.c_str());
+  }
+
+protected:
+  // An RMW implementation that is never installed, so that one is searched for.
+  static constexpr const char * kUnloadableRmwImplementation = "rmw_nonexistent_cpp";
+
+  std::string rmw_implementation;
+};
+
+BENCHMARK_F(PerformanceTestLoadLibrary, load_library_cold_cache)(benchmark::State & st)
+{
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    st.PauseTiming();
+    clear_load_cache();
+    st.ResumeTiming();
+
+    std::shared_ptr<rcpputils::SharedLibrary> lib = load_library(kUnloadableRmwImplementation);
+    if (!lib) {
+      st.SkipWithError(rmw_get_error_string().str);
+      rmw_reset_error();
+      break;
+    }
+  }
+}
+
+BENCHMARK_F(PerformanceTestLoadLibrary, load_library_warm_cache)(benchmark::State & st)
+{
+  if (!load_library(kUnloadableRmwImplementation)) {
+    st.SkipWithError(rmw_get_error_string().str);
+    rmw_reset_error();
+    return;
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    std::shared_ptr<rcpputils::SharedLibrary> lib = load_library(kUnloadableRmwImplementation);
+    if (!lib) {
+      st.SkipWithError(rmw_get_error_string().str);
+      rmw_reset_error();
+      break;
+    }
+  }
+}
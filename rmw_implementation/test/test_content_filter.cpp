@@ -0,0 +1,182 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "rosidl_runtime_c/string_functions.h"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/msg/basic_types.hpp"
+#include "test_msgs/msg/nested.hpp"
+#include "test_msgs/msg/strings.h"
+#include "test_msgs/msg/strings.hpp"
+
+#include "../src/content_filter.hpp"
+
+template<typename MessageT>
+static const rosidl_message_type_support_t *
+get_cpp_type_support()
+{
+  return rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>();
+}
+
+TEST(ContentFilter, comparisons) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::BasicTypes>();
+  test_msgs::msg::BasicTypes msg;
+  msg.int32_value = 42;
+  msg.float64_value = 1.5;
+  msg.bool_value = true;
+  msg.uint8_value = 200u;
+  msg.char_value = 250u;
+
+  EXPECT_TRUE(ContentFilter(ts, "int32_value = 42", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value == 42", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value <> 42", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value != 42", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value < 43", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value < 42", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value <= 42", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value > -1", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value >= 42", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "41 < int32_value", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "float64_value > 1.25", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "bool_value = TRUE", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "bool_value = false", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "uint8_value = 200", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "char_value = 250", {}).matches(&msg));
+}
+
+TEST(ContentFilter, large_integers) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::BasicTypes>();
+  test_msgs::msg::BasicTypes msg;
+  // Neither of these is representable as a double.
+  msg.int64_value = 9007199254740993;
+  msg.uint64_value = 18446744073709551615u;
+
+  EXPECT_TRUE(ContentFilter(ts, "int64_value = 9007199254740993", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int64_value = 9007199254740992", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int64_value > 9007199254740992", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int64_value < 9007199254740993.5", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "uint64_value = %0", {"18446744073709551615"}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "uint64_value = 18446744073709551614", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "uint64_value > -1", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "uint64_value < 1e20", {}).matches(&msg));
+}
+
+TEST(ContentFilter, logical_operations) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::BasicTypes>();
+  test_msgs::msg::BasicTypes msg;
+  msg.int32_value = 42;
+  msg.int64_value = -7;
+
+  EXPECT_TRUE(ContentFilter(ts, "int32_value = 42 AND int64_value < 0", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value = 42 AND int64_value > 0", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value = 0 OR int64_value < 0", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "NOT int32_value = 42", {}).matches(&msg));
+  EXPECT_TRUE(
+    ContentFilter(
+      ts, "(int32_value = 0 or int32_value = 42) and not (int64_value = 0)",
+      {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "int32_value BETWEEN 40 AND 50", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value NOT BETWEEN 40 AND 50", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value BETWEEN 43 AND 50", {}).matches(&msg));
+}
+
+TEST(ContentFilter, parameters) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::BasicTypes>();
+  test_msgs::msg::BasicTypes msg;
+  msg.int32_value = 42;
+  msg.bool_value = true;
+
+  EXPECT_TRUE(ContentFilter(ts, "int32_value = %0", {"42"}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "int32_value = %0", {"41"}).matches(&msg));
+  EXPECT_TRUE(
+    ContentFilter(ts, "int32_value BETWEEN %1 AND %0", {"50", "40"}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "bool_value = %0", {"TRUE"}).matches(&msg));
+  EXPECT_THROW(ContentFilter(ts, "int32_value = %1", {"42"}), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value = %0", {"'42'"}), std::invalid_argument);
+}
+
+TEST(ContentFilter, strings) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::Strings>();
+  test_msgs::msg::Strings msg;
+  msg.string_value = "Hello world!";
+
+  EXPECT_TRUE(ContentFilter(ts, "string_value = 'Hello world!'", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value = %0", {"'Hello world!'"}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value = %0", {"Hello world!"}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value > 'Hello'", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value LIKE 'Hello%'", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value LIKE '%o w%!'", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value LIKE 'H_llo%'", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "string_value LIKE 'Hello'", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "string_value NOT LIKE 'Bye%'", {}).matches(&msg));
+  EXPECT_THROW(ContentFilter(ts, "string_value = 42", {}), std::invalid_argument);
+}
+
+TEST(ContentFilter, nested_fields) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::Nested>();
+  test_msgs::msg::Nested msg;
+  msg.basic_types_value.uint16_value = 1000u;
+
+  EXPECT_TRUE(ContentFilter(ts, "basic_types_value.uint16_value = 1000", {}).matches(&msg));
+  EXPECT_FALSE(ContentFilter(ts, "basic_types_value.uint16_value < 1000", {}).matches(&msg));
+  EXPECT_THROW(ContentFilter(ts, "basic_types_value = 1000", {}), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "basic_types_value.missing = 0", {}), std::invalid_argument);
+}
+
+TEST(ContentFilter, c_messages) {
+  const rosidl_message_type_support_t * ts =
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+  test_msgs__msg__BasicTypes msg;
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+  msg.int16_value = -3;
+  msg.char_value = -1;
+  EXPECT_TRUE(ContentFilter(ts, "int16_value = -3", {}).matches(&msg));
+  EXPECT_TRUE(ContentFilter(ts, "char_value < 0", {}).matches(&msg));
+  test_msgs__msg__BasicTypes__fini(&msg);
+
+  ts = ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, Strings);
+  test_msgs__msg__Strings strings_msg;
+  ASSERT_TRUE(test_msgs__msg__Strings__init(&strings_msg));
+  ASSERT_TRUE(rosidl_runtime_c__String__assign(&strings_msg.string_value, "Hello world!"));
+  EXPECT_TRUE(ContentFilter(ts, "string_value LIKE '%world%'", {}).matches(&strings_msg));
+  EXPECT_FALSE(ContentFilter(ts, "string_value = ''", {}).matches(&strings_msg));
+  test_msgs__msg__Strings__fini(&strings_msg);
+}
+
+TEST(ContentFilter, bad_expressions) {
+  const rosidl_message_type_support_t * ts = get_cpp_type_support<test_msgs::msg::BasicTypes>();
+  const std::vector<std::string> no_parameters;
+
+  EXPECT_THROW(ContentFilter(nullptr, "int32_value = 0", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value = ", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value ! 0", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "(int32_value = 0", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value = 0)", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value = 'a", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "missing_value = 0", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "0 = 0", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "bool_value = 1", no_parameters), std::invalid_argument);
+  EXPECT_THROW(ContentFilter(ts, "int32_value LIKE 0", no_parameters), std::invalid_argument);
+  EXPECT_THROW(
+    ContentFilter(ts, "int32_value BETWEEN 0 OR 1", no_parameters), std::invalid_argument);
+}
@@ -14,12 +14,32 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
+#ifdef RMW_IMPLEMENTATION_HAS_SDT
+#include <elf.h>
+#include <link.h>
+#endif
+
+#include "rcutils/allocator.h"
 #include "rcutils/env.h"
+#include "rcutils/strdup.h"
 #include "rcutils/testing/fault_injection.h"
 
 #include "rmw/error_handling.h"
+#include "rmw/get_node_info_and_types.h"
+#include "rmw/rmw.h"
+
+#include "rmw_implementation/call_statistics.h"
+#include "rmw_implementation/publish_batch.h"
+#include "rmw_implementation/serialized_message_pool.h"
 
 #include "../src/functions.hpp"
 
@@ -59,3 +79,382 @@ TEST(Functions, nominal_prefetch_and_unload) {
   prefetch_symbols();
   unload_library();
 }
+
+TEST(Functions, function_availability) {
+  EXPECT_TRUE(is_function_available("rmw_init")) << rmw_get_error_string().str;
+  EXPECT_TRUE(is_function_available("rmw_publish")) << rmw_get_error_string().str;
+  EXPECT_FALSE(is_function_available("not_an_rmw_function"));
+  unload_library();
+}
+
+TEST(Functions, bind_now) {
+  ASSERT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_BIND_NOW", "1"));
+  prefetch_symbols();
+  EXPECT_NE(nullptr, rmw_get_implementation_identifier()) << rmw_get_error_string().str;
+  EXPECT_TRUE(is_function_available("rmw_init")) << rmw_get_error_string().str;
+  unload_library();
+  EXPECT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_BIND_NOW", nullptr));
+}
+
+// Call a function test_partial_rmw lacks, with and without binding all
+// functions up front.
+static void
+check_missing_function_call(bool bind_now)
+{
+  const char * env_var = nullptr;
+  ASSERT_EQ(nullptr, rcutils_get_env("RMW_IMPLEMENTATION", &env_var));
+  const std::string rmw_implementation = env_var;
+  ASSERT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION", "test_partial_rmw"));
+  ASSERT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_BIND_NOW", bind_now ? "1" : nullptr));
+  unload_library();
+  prefetch_symbols();
+
+  EXPECT_STREQ("test_partial_rmw", rmw_get_implementation_identifier()) <<
+    rmw_get_error_string().str;
+  EXPECT_TRUE(is_function_available("rmw_get_implementation_identifier"));
+  EXPECT_FALSE(is_function_available("rmw_create_node"));
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(nullptr, rmw_create_node(nullptr, "node", "/"));
+    ASSERT_TRUE(rmw_error_is_set());
+    EXPECT_NE(nullptr, std::strstr(rmw_get_error_string().str, "'rmw_create_node'")) <<
+      rmw_get_error_string().str;
+    rmw_reset_error();
+  }
+  EXPECT_EQ(RMW_RET_ERROR, rmw_shutdown(nullptr));
+  EXPECT_NE(nullptr, std::strstr(rmw_get_error_string().str, "'rmw_shutdown'")) <<
+    rmw_get_error_string().str;
+  rmw_reset_error();
+
+  unload_library();
+  EXPECT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_BIND_NOW", nullptr));
+  EXPECT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION", rmw_implementation.c_str()));
+}
+
+TEST(Functions, missing_function) {
+  check_missing_function_call(false);
+}
+
+TEST(Functions, bind_now_missing_function) {
+  check_missing_function_call(true);
+}
+
+TEST(Functions, call_statistics) {
+  ASSERT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_CALL_STATISTICS", "1"));
+  prefetch_symbols();
+  EXPECT_TRUE(rmw_implementation_call_statistics_enabled());
+  rmw_implementation_reset_call_statistics();
+
+  constexpr uint64_t call_count = 10u;
+  for (uint64_t i = 0u; i < call_count; ++i) {
+    EXPECT_NE(nullptr, rmw_get_implementation_identifier()) << rmw_get_error_string().str;
+  }
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, rmw_publish(nullptr, nullptr, nullptr));
+  rmw_reset_error();
+
+  size_t count = 0u;
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, rmw_implementation_get_call_statistics(nullptr, 1u, &count));
+  rmw_reset_error();
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, rmw_implementation_get_call_statistics(nullptr, 0u, nullptr));
+  rmw_reset_error();
+  ASSERT_EQ(RMW_RET_OK, rmw_implementation_get_call_statistics(nullptr, 0u, &count));
+  ASSERT_GT(count, 0u);
+  std::vector<rmw_implementation_call_statistics_t> statistics(count);
+  ASSERT_EQ(
+    RMW_RET_OK, rmw_implementation_get_call_statistics(statistics.data(), count, &count));
+  bool found_identifier_calls = false;
+  bool found_publish_calls = false;
+  for (const rmw_implementation_call_statistics_t & function : statistics) {
+    uint64_t histogram_count = 0u;
+    for (uint64_t bucket_count : function.latency_histogram) {
+      histogram_count += bucket_count;
+    }
+    EXPECT_EQ(function.call_count, histogram_count) << function.function_name;
+    if (std::string(function.function_name) == "rmw_get_implementation_identifier") {
+      EXPECT_EQ(call_count, function.call_count);
+      EXPECT_EQ(0u, function.error_count);
+      found_identifier_calls = true;
+    } else if (std::string(function.function_name) == "rmw_publish") {
+      EXPECT_EQ(1u, function.call_count);
+      EXPECT_EQ(1u, function.error_count);
+      found_publish_calls = true;
+    }
+  }
+  EXPECT_TRUE(found_identifier_calls);
+  EXPECT_TRUE(found_publish_calls);
+
+  EXPECT_EQ(0u, rmw_implementation_get_call_latency_bucket_lower_bound(0u));
+  EXPECT_EQ(5u, rmw_implementation_get_call_latency_bucket_lower_bound(5u));
+  EXPECT_EQ(8u, rmw_implementation_get_call_latency_bucket_lower_bound(8u));
+  EXPECT_EQ(18u, rmw_implementation_get_call_latency_bucket_lower_bound(17u));
+  EXPECT_EQ(32u, rmw_implementation_get_call_latency_bucket_lower_bound(24u));
+  EXPECT_EQ(
+    UINT64_MAX, rmw_implementation_get_call_latency_bucket_lower_bound(
+      RMW_IMPLEMENTATION_CALL_LATENCY_BUCKET_COUNT));
+
+  unload_library();
+  EXPECT_FALSE(rmw_implementation_call_statistics_enabled());
+  EXPECT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_CALL_STATISTICS", nullptr));
+}
+
+#ifdef RMW_IMPLEMENTATION_HAS_SDT
+static int
+find_rmw_implementation_library(struct dl_phdr_info * info, size_t, void * data)
+{
+  if (info->dlpi_name && std::strstr(info->dlpi_name, "librmw_implementation.")) {
+    *static_cast<std::string *>(data) = info->dlpi_name;
+    return 1;
+  }
+  return 0;
+}
+
+// Read the probes of a 64-bit ELF shared library from its .note.stapsdt
+// section, as "provider:name" mapped to whether all of them have an
+// is-enabled semaphore in its .probes section.
+static std::map<std::string, bool>
+read_probes(const std::string & path)
+{
+  std::map<std::string, bool> probes;
+  std::ifstream file(path, std::ios::binary);
+  const std::vector<char> image{
+    std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  Elf64_Ehdr header;
+  if (image.size() < sizeof(header)) {
+    return probes;
+  }
+  std::memcpy(&header, image.data(), sizeof(header));
+  if (
+    std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 ||
+    header.e_ident[EI_CLASS] != ELFCLASS64 ||
+    header.e_shentsize != sizeof(Elf64_Shdr) ||
+    header.e_shoff + header.e_shnum * sizeof(Elf64_Shdr) > image.size() ||
+    header.e_shstrndx >= header.e_shnum)
+  {
+    return probes;
+  }
+  std::vector<Elf64_Shdr> sections(header.e_shnum);
+  std::memcpy(sections.data(), &image[header.e_shoff], header.e_shnum * sizeof(Elf64_Shdr));
+  const Elf64_Shdr & names = sections[header.e_shstrndx];
+  const Elf64_Shdr * notes = nullptr;
+  const Elf64_Shdr * semaphores = nullptr;
+  for (const Elf64_Shdr & section : sections) {
+    if (section.sh_name >= names.sh_size || names.sh_offset + names.sh_size > image.size()) {
+      continue;
+    }
+    const std::string name(&image[names.sh_offset + section.sh_name]);
+    if (name == ".note.stapsdt") {
+      notes = &section;
+    } else if (name == ".probes") {
+      semaphores = &section;
+    }
+  }
+  if (!notes || notes->sh_offset + notes->sh_size > image.size()) {
+    return probes;
+  }
+
+  // Each note holds the address of the probe, that of the .stapsdt.base
+  // section and that of the semaphore, followed by the provider name, the
+  // probe name and the argument format, as null terminated strings.
+  const auto align = [](size_t size) {return (size + 3u) & ~size_t{3u};};
+  size_t offset = 0u;
+  while (offset + sizeof(Elf64_Nhdr) <= notes->sh_size) {
+    Elf64_Nhdr note;
+    std::memcpy(&note, &image[notes->sh_offset + offset], sizeof(note));
+    const size_t name_offset = offset + sizeof(note);
+    const size_t desc_offset = name_offset + align(note.n_namesz);
+    offset = desc_offset + align(note.n_descsz);
+    if (offset > notes->sh_size) {
+      break;
+    }
+    const char * desc = &image[notes->sh_offset + desc_offset];
+    if (
+      note.n_type != 3u || note.n_descsz <= 3u * sizeof(Elf64_Addr) ||
+      std::string(&image[notes->sh_offset + name_offset]) != "stapsdt" ||
+      desc[note.n_descsz - 1u] != '\0')
+    {
+      continue;
+    }
+    Elf64_Addr semaphore;
+    std::memcpy(&semaphore, desc + 2u * sizeof(Elf64_Addr), sizeof(semaphore));
+    const char * provider = desc + 3u * sizeof(Elf64_Addr);
+    const std::string probe = std::string(provider) + ":" + (provider + std::strlen(provider) + 1u);
+    const bool has_semaphore = semaphores && semaphore != 0u &&
+      semaphore >= semaphores->sh_addr && semaphore < semaphores->sh_addr + semaphores->sh_size;
+    auto it = probes.emplace(probe, true).first;
+    it->second = it->second && has_semaphore;
+  }
+  return probes;
+}
+#endif
+
+TEST(Functions, tracepoints) {
+  prefetch_symbols();
+  // Tracepoints, fired or not, do not imply collecting call statistics.
+  EXPECT_FALSE(rmw_implementation_call_statistics_enabled());
+  EXPECT_NE(nullptr, rmw_get_implementation_identifier()) << rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, rmw_publish(nullptr, nullptr, nullptr));
+  rmw_reset_error();
+
+  unload_library();
+
+#ifdef RMW_IMPLEMENTATION_HAS_SDT
+  std::string library_path;
+  dl_iterate_phdr(find_rmw_implementation_library, &library_path);
+  ASSERT_FALSE(library_path.empty());
+  const std::map<std::string, bool> probes = read_probes(library_path);
+  for (const char * probe : {
+      "rmw_implementation:function_entry", "rmw_implementation:function_exit"})
+  {
+    const auto it = probes.find(probe);
+    ASSERT_NE(probes.end(), it) << probe << " missing from " << library_path;
+    EXPECT_TRUE(it->second) << probe << " lacks a semaphore in " << library_path;
+  }
+#else
+  GTEST_SKIP() << "built without tracepoints";
+#endif
+}
+
+TEST(Functions, graph_cache) {
+  ASSERT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_GRAPH_CACHE", "1"));
+  prefetch_symbols();
+
+  rmw_init_options_t options = rmw_get_zero_initialized_init_options();
+  ASSERT_EQ(RMW_RET_OK, rmw_init_options_init(&options, rcutils_get_default_allocator())) <<
+    rmw_get_error_string().str;
+  options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+  rmw_context_t context = rmw_get_zero_initialized_context();
+  ASSERT_EQ(RMW_RET_OK, rmw_init(&options, &context)) << rmw_get_error_string().str;
+  rmw_node_t * node = rmw_create_node(&context, "graph_cache_node", "/");
+  ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+  auto count_nodes = [node]() {
+      rcutils_string_array_t node_names = rcutils_get_zero_initialized_string_array();
+      rcutils_string_array_t node_namespaces = rcutils_get_zero_initialized_string_array();
+      EXPECT_EQ(RMW_RET_OK, rmw_get_node_names(node, &node_names, &node_namespaces)) <<
+        rmw_get_error_string().str;
+      const size_t count = node_names.size;
+      EXPECT_EQ(count, node_namespaces.size);
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_names));
+      EXPECT_EQ(RCUTILS_RET_OK, rcutils_string_array_fini(&node_namespaces));
+      return count;
+    };
+  const size_t node_count = count_nodes();
+  EXPECT_LE(1u, node_count);
+  EXPECT_EQ(node_count, count_nodes());
+
+  // Nodes created or destroyed through this library are accounted for right away.
+  rmw_node_t * other_node = rmw_create_node(&context, "other_graph_cache_node", "/");
+  ASSERT_NE(nullptr, other_node) << rmw_get_error_string().str;
+  EXPECT_EQ(node_count + 1u, count_nodes());
+  EXPECT_EQ(RMW_RET_OK, rmw_destroy_node(other_node)) << rmw_get_error_string().str;
+  EXPECT_EQ(node_count, count_nodes());
+
+  // Nodes created behind the back of this library are accounted for once
+  // rmw_wait() returns the graph guard condition of a node as ready.
+  auto create_node_directly = reinterpret_cast<decltype(&rmw_create_node)>(
+    lookup_symbol(load_library(), "rmw_create_node"));
+  ASSERT_NE(nullptr, create_node_directly) << rmw_get_error_string().str;
+  auto destroy_node_directly = reinterpret_cast<decltype(&rmw_destroy_node)>(
+    lookup_symbol(load_library(), "rmw_destroy_node"));
+  ASSERT_NE(nullptr, destroy_node_directly) << rmw_get_error_string().str;
+  rmw_node_t * hidden_node = create_node_directly(&context, "hidden_graph_cache_node", "/");
+  ASSERT_NE(nullptr, hidden_node) << rmw_get_error_string().str;
+  EXPECT_EQ(node_count, count_nodes());
+  const rmw_guard_condition_t * graph_guard_condition = rmw_node_get_graph_guard_condition(node);
+  ASSERT_NE(nullptr, graph_guard_condition) << rmw_get_error_string().str;
+  rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, 1u);
+  ASSERT_NE(nullptr, wait_set) << rmw_get_error_string().str;
+  void * guard_condition_handles[] = {graph_guard_condition->data};
+  rmw_guard_conditions_t guard_conditions{1u, guard_condition_handles};
+  rmw_time_t timeout{1u, 0u};
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_wait(nullptr, &guard_conditions, nullptr, nullptr, nullptr, wait_set, &timeout)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(node_count + 1u, count_nodes());
+  EXPECT_EQ(RMW_RET_OK, rmw_destroy_wait_set(wait_set)) << rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, destroy_node_directly(hidden_node)) << rmw_get_error_string().str;
+
+  // Bad arguments are still handled by the RMW implementation.
+  size_t publisher_count = 1u;
+  EXPECT_EQ(RMW_RET_OK, rmw_count_publishers(node, "/graph_cache_topic", &publisher_count)) <<
+    rmw_get_error_string().str;
+  EXPECT_EQ(0u, publisher_count);
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, rmw_count_publishers(node, "/graph_cache_topic", nullptr));
+  rmw_reset_error();
+  EXPECT_EQ(
+    RMW_RET_INVALID_ARGUMENT,
+    rmw_count_publishers(nullptr, "/graph_cache_topic", &publisher_count));
+  rmw_reset_error();
+
+  EXPECT_EQ(RMW_RET_OK, rmw_destroy_node(node)) << rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_shutdown(&context)) << rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_context_fini(&context)) << rmw_get_error_string().str;
+  EXPECT_EQ(RMW_RET_OK, rmw_init_options_fini(&options)) << rmw_get_error_string().str;
+
+  unload_library();
+  EXPECT_TRUE(rcutils_set_env("RMW_IMPLEMENTATION_GRAPH_CACHE", nullptr));
+}
+
+TEST(Functions, publish_batch) {
+  size_t published_count = 1u;
+  EXPECT_EQ(RMW_RET_OK, rmw_implementation_publish_batch(nullptr, 0u, &published_count));
+  EXPECT_EQ(0u, published_count);
+
+  EXPECT_EQ(
+    RMW_RET_INVALID_ARGUMENT, rmw_implementation_publish_batch(nullptr, 1u, &published_count));
+  rmw_reset_error();
+  rmw_implementation_publish_batch_entry_t entries[2] = {};
+  EXPECT_EQ(RMW_RET_INVALID_ARGUMENT, rmw_implementation_publish_batch(entries, 2u, nullptr));
+  rmw_reset_error();
+
+  // Publishing stops at the first message that fails to be published.
+  published_count = 1u;
+  EXPECT_EQ(
+    RMW_RET_INVALID_ARGUMENT, rmw_implementation_publish_batch(entries, 2u, &published_count));
+  rmw_reset_error();
+  EXPECT_EQ(0u, published_count);
+  unload_library();
+}
+
+TEST(Functions, serialized_message_pool) {
+  rcutils_allocator_t allocator = rmw_implementation_get_serialized_message_pool_allocator();
+  ASSERT_TRUE(rcutils_allocator_is_valid(&allocator));
+
+  // Reallocations within the size class of a buffer keep it.
+  void * buffer = allocator.allocate(100u, allocator.state);
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_EQ(buffer, allocator.reallocate(buffer, 256u, allocator.state));
+  std::memset(buffer, 0x5A, 256u);
+  void * larger_buffer = allocator.reallocate(buffer, 257u, allocator.state);
+  ASSERT_NE(nullptr, larger_buffer);
+  EXPECT_EQ(0x5A, static_cast<uint8_t *>(larger_buffer)[255]);
+
+  // Deallocated buffers are reused.
+  allocator.deallocate(larger_buffer, allocator.state);
+  void * reused_buffer = allocator.allocate(512u, allocator.state);
+  EXPECT_EQ(larger_buffer, reused_buffer);
+  allocator.deallocate(reused_buffer, allocator.state);
+
+  void * zeroed_buffer = allocator.zero_allocate(16u, 64u, allocator.state);
+  ASSERT_NE(nullptr, zeroed_buffer);
+  for (size_t i = 0u; i < 16u * 64u; ++i) {
+    EXPECT_EQ(0u, static_cast<uint8_t *>(zeroed_buffer)[i]);
+  }
+  allocator.deallocate(zeroed_buffer, allocator.state);
+
+  // Buffers beyond the largest size class are not pooled, but work all the same.
+  void * huge_buffer = allocator.allocate(size_t{1u} << 27u, allocator.state);
+  ASSERT_NE(nullptr, huge_buffer);
+  allocator.deallocate(huge_buffer, allocator.state);
+
+  rmw_serialized_message_t serialized_message = rmw_get_zero_initialized_serialized_message();
+  const rosidl_message_type_support_t * ts = nullptr;
+  rosidl_runtime_c__Sequence__bound message_bounds{};
+  EXPECT_EQ(
+    RMW_RET_INVALID_ARGUMENT,
+    rmw_implementation_serialized_message_init_pooled(
+      &serialized_message, ts, &message_bounds, 1024u));
+  rmw_reset_error();
+
+  rmw_implementation_trim_serialized_message_pool();
+}
@@ -0,0 +1,108 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/handle_registry.hpp"
+
+TEST(HandleRegistry, insert_find_erase) {
+  HandleRegistry registry;
+  int handles[3];
+  int values[3];
+
+  EXPECT_EQ(nullptr, registry.find(&handles[0]));
+  registry.insert(&handles[0], &values[0]);
+  registry.insert(&handles[1], &values[1]);
+  EXPECT_EQ(2u, registry.size());
+  EXPECT_EQ(&values[0], registry.find(&handles[0]));
+  EXPECT_EQ(&values[1], registry.find(&handles[1]));
+  EXPECT_EQ(nullptr, registry.find(&handles[2]));
+
+  // handles may be reused once destroyed
+  registry.insert(&handles[0], &values[2]);
+  EXPECT_EQ(2u, registry.size());
+  EXPECT_EQ(&values[2], registry.find(&handles[0]));
+
+  registry.erase(&handles[0]);
+  registry.erase(&handles[2]);
+  EXPECT_EQ(1u, registry.size());
+  EXPECT_EQ(nullptr, registry.find(&handles[0]));
+  EXPECT_EQ(&values[1], registry.find(&handles[1]));
+
+  registry.clear();
+  EXPECT_EQ(0u, registry.size());
+  EXPECT_EQ(nullptr, registry.find(&handles[1]));
+}
+
+TEST(HandleRegistry, grow_and_shrink) {
+  constexpr size_t count = 10000u;
+  std::vector<int> handles(count);
+  int value = 0;
+  HandleRegistry registry;
+  for (size_t i = 0u; i < count; ++i) {
+    registry.insert(&handles[i], &value);
+  }
+  EXPECT_EQ(count, registry.size());
+  // erase every other handle, leaving the others reachable
+  for (size_t i = 0u; i < count; i += 2u) {
+    registry.erase(&handles[i]);
+  }
+  EXPECT_EQ(count / 2u, registry.size());
+  for (size_t i = 0u; i < count; ++i) {
+    EXPECT_EQ(i % 2u ? &value : nullptr, registry.find(&handles[i])) << i;
+  }
+}
+
+TEST(HandleRegistry, concurrent_lookups) {
+  constexpr size_t stable_count = 16u;
+  constexpr size_t churn_count = 4096u;
+  std::vector<int> stable_handles(stable_count);
+  std::vector<int> churn_handles(churn_count);
+  int value = 0;
+  HandleRegistry registry;
+  for (int & handle : stable_handles) {
+    registry.insert(&handle, &value);
+  }
+
+  // Lookups of handles that stay registered never miss, even while tables
+  // are modified, outgrown and freed.
+  std::atomic<bool> done{false};
+  std::atomic<size_t> misses{0u};
+  std::thread reader([&]() {
+      while (!done.load()) {
+        for (const int & handle : stable_handles) {
+          if (registry.find(&handle) != &value) {
+            misses.fetch_add(1u);
+          }
+        }
+      }
+    });
+  for (size_t round = 0u; round < 4u; ++round) {
+    for (int & handle : churn_handles) {
+      registry.insert(&handle, &value);
+    }
+    for (int & handle : churn_handles) {
+      registry.erase(&handle);
+    }
+  }
+  done.store(true);
+  reader.join();
+  EXPECT_EQ(0u, misses.load());
+  EXPECT_EQ(stable_count, registry.size());
+}
@@ -0,0 +1,61 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../src/routing.hpp"
+
+TEST(Routing, parse_rules) {
+  std::istringstream input(
+    "# routing configuration\n"
+    "\n"
+    "/camera/* rmw_cyclonedds_cpp\n"
+    "  /tf\trmw_fastrtps_cpp  # transforms\n");
+  std::vector<RoutingRule> rules = parse_routing_rules(input);
+  ASSERT_EQ(2u, rules.size());
+  EXPECT_EQ("/camera/*", rules[0].pattern);
+  EXPECT_EQ("rmw_cyclonedds_cpp", rules[0].rmw_implementation);
+  EXPECT_EQ("/tf", rules[1].pattern);
+  EXPECT_EQ("rmw_fastrtps_cpp", rules[1].rmw_implementation);
+}
+
+TEST(Routing, parse_bad_rules) {
+  std::istringstream missing_implementation("/camera/*\n");
+  EXPECT_THROW(parse_routing_rules(missing_implementation), std::runtime_error);
+  std::istringstream extra_field("/camera/* rmw_cyclonedds_cpp rmw_fastrtps_cpp\n");
+  EXPECT_THROW(parse_routing_rules(extra_field), std::runtime_error);
+}
+
+TEST(Routing, load_missing_rules) {
+  EXPECT_THROW(load_routing_rules("/nonexistent/routing.conf"), std::runtime_error);
+}
+
+TEST(Routing, match_patterns) {
+  EXPECT_TRUE(matches_routing_pattern("/tf", "/tf"));
+  EXPECT_FALSE(matches_routing_pattern("/tf_static", "/tf"));
+  EXPECT_TRUE(matches_routing_pattern("/tf_static", "/tf*"));
+  EXPECT_TRUE(matches_routing_pattern("/camera/image_raw", "/camera/*"));
+  EXPECT_TRUE(matches_routing_pattern("/camera/left/image_raw", "/camera/*"));
+  EXPECT_FALSE(matches_routing_pattern("/camera", "/camera/*"));
+  EXPECT_TRUE(matches_routing_pattern("/robot/camera/image_raw", "*/image_raw"));
+  EXPECT_TRUE(matches_routing_pattern("/a/b/c", "/a*b*c"));
+  EXPECT_FALSE(matches_routing_pattern("/a/b/d", "/a*b*c"));
+  EXPECT_TRUE(matches_routing_pattern("", "*"));
+  EXPECT_TRUE(matches_routing_pattern("/anything", "*"));
+}
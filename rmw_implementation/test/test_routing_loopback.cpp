@@ -0,0 +1,248 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "rcutils/allocator.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+// Runs with a routing configuration sending topics starting with /routed to
+// rmw_loopback_cpp, and anything else to the RMW implementation loaded as
+// usual.
+
+class TestRoutingLoopback : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    rmw_init_options_t options = rmw_get_zero_initialized_init_options();
+    rmw_ret_t ret = rmw_init_options_init(&options, rcutils_get_default_allocator());
+    ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+    context = rmw_get_zero_initialized_context();
+    ret = rmw_init(&options, &context);
+    EXPECT_EQ(RMW_RET_OK, rmw_init_options_fini(&options)) << rmw_get_error_string().str;
+    ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+    node = rmw_create_node(&context, "test_routing_loopback", "/");
+    ASSERT_NE(nullptr, node) << rmw_get_error_string().str;
+
+    const rosidl_message_type_support_t * ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    rmw_publisher_options_t publisher_options = rmw_get_default_publisher_options();
+    rmw_subscription_options_t subscription_options = rmw_get_default_subscription_options();
+    for (size_t i = 0u; i < 2u; ++i) {
+      const char * topic_name = 0u == i ? "/routed_chatter" : "/chatter";
+      pubs[i] = rmw_create_publisher(
+        node, ts, topic_name, &rmw_qos_profile_default, &publisher_options);
+      ASSERT_NE(nullptr, pubs[i]) << rmw_get_error_string().str;
+      subs[i] = rmw_create_subscription(
+        node, ts, topic_name, &rmw_qos_profile_default, &subscription_options);
+      ASSERT_NE(nullptr, subs[i]) << rmw_get_error_string().str;
+    }
+    guard_condition = rmw_create_guard_condition(&context);
+    ASSERT_NE(nullptr, guard_condition) << rmw_get_error_string().str;
+    wait_set = rmw_create_wait_set(&context, 3u);
+    ASSERT_NE(nullptr, wait_set) << rmw_get_error_string().str;
+
+    // Let the RMW implementation loaded as usual match its own entities.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    size_t count = 0u;
+    while (0u == count && std::chrono::steady_clock::now() < deadline) {
+      ASSERT_EQ(RMW_RET_OK, rmw_subscription_count_matched_publishers(subs[1], &count));
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(1u, count);
+  }
+
+  void TearDown() override
+  {
+    if (wait_set) {
+      EXPECT_EQ(RMW_RET_OK, rmw_destroy_wait_set(wait_set)) << rmw_get_error_string().str;
+    }
+    if (guard_condition) {
+      EXPECT_EQ(RMW_RET_OK, rmw_destroy_guard_condition(guard_condition)) <<
+        rmw_get_error_string().str;
+    }
+    for (size_t i = 0u; i < 2u; ++i) {
+      if (subs[i]) {
+        EXPECT_EQ(RMW_RET_OK, rmw_destroy_subscription(node, subs[i])) <<
+          rmw_get_error_string().str;
+      }
+      if (pubs[i]) {
+        EXPECT_EQ(RMW_RET_OK, rmw_destroy_publisher(node, pubs[i])) <<
+          rmw_get_error_string().str;
+      }
+    }
+    if (node) {
+      EXPECT_EQ(RMW_RET_OK, rmw_destroy_node(node)) << rmw_get_error_string().str;
+    }
+    EXPECT_EQ(RMW_RET_OK, rmw_shutdown(&context)) << rmw_get_error_string().str;
+    EXPECT_EQ(RMW_RET_OK, rmw_context_fini(&context)) << rmw_get_error_string().str;
+  }
+
+  // Wait on both subscriptions and the guard condition, leaving which of
+  // them were ready in `ready`.
+  rmw_ret_t wait(const rmw_time_t * timeout, bool ready[3])
+  {
+    void * subscribers[2] = {subs[0]->data, subs[1]->data};
+    void * guard_conditions[1] = {guard_condition->data};
+    rmw_subscriptions_t subscriptions{2u, subscribers};
+    rmw_guard_conditions_t conditions{1u, guard_conditions};
+    rmw_services_t services{0u, nullptr};
+    rmw_clients_t clients{0u, nullptr};
+    rmw_events_t events{0u, nullptr};
+    rmw_ret_t ret = rmw_wait(
+      &subscriptions, &conditions, &services, &clients, &events, wait_set, timeout);
+    ready[0] = nullptr != subscribers[0];
+    ready[1] = nullptr != subscribers[1];
+    ready[2] = nullptr != guard_conditions[0];
+    return ret;
+  }
+
+  // Take a message from a subscription, checking it carries the given value.
+  void take(size_t i, int64_t value)
+  {
+    test_msgs__msg__BasicTypes msg;
+    ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+    bool taken = false;
+    EXPECT_EQ(RMW_RET_OK, rmw_take(subs[i], &msg, &taken, nullptr)) << rmw_get_error_string().str;
+    EXPECT_TRUE(taken);
+    EXPECT_EQ(value, msg.int64_value);
+    test_msgs__msg__BasicTypes__fini(&msg);
+  }
+
+  void publish(size_t i, int64_t value)
+  {
+    test_msgs__msg__BasicTypes msg;
+    ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&msg));
+    msg.int64_value = value;
+    EXPECT_EQ(RMW_RET_OK, rmw_publish(pubs[i], &msg, nullptr)) << rmw_get_error_string().str;
+    test_msgs__msg__BasicTypes__fini(&msg);
+  }
+
+  rmw_context_t context;
+  rmw_node_t * node = nullptr;
+  // Routed to rmw_loopback_cpp first, then those of the loaded RMW.
+  rmw_publisher_t * pubs[2] = {nullptr, nullptr};
+  rmw_subscription_t * subs[2] = {nullptr, nullptr};
+  rmw_guard_condition_t * guard_condition = nullptr;
+  rmw_wait_set_t * wait_set = nullptr;
+};
+
+TEST_F(TestRoutingLoopback, entities_are_routed) {
+  EXPECT_STREQ("rmw_loopback_cpp", pubs[0]->implementation_identifier);
+  EXPECT_STREQ("rmw_loopback_cpp", subs[0]->implementation_identifier);
+  EXPECT_STREQ(rmw_get_implementation_identifier(), pubs[1]->implementation_identifier);
+  EXPECT_STREQ(rmw_get_implementation_identifier(), subs[1]->implementation_identifier);
+  EXPECT_STREQ(rmw_get_implementation_identifier(), node->implementation_identifier);
+
+  size_t count = 0u;
+  EXPECT_EQ(RMW_RET_OK, rmw_subscription_count_matched_publishers(subs[0], &count));
+  EXPECT_EQ(1u, count);
+  EXPECT_EQ(RMW_RET_OK, rmw_count_publishers(node, "/routed_chatter", &count));
+  EXPECT_EQ(1u, count);
+}
+
+TEST_F(TestRoutingLoopback, wait_across_rmw_implementations) {
+  bool ready[3];
+  const rmw_time_t short_timeout{0u, 10000000u};
+  const rmw_time_t long_timeout{10u, 0u};
+  EXPECT_EQ(RMW_RET_TIMEOUT, wait(&short_timeout, ready));
+  EXPECT_FALSE(ready[0] || ready[1] || ready[2]);
+
+  publish(0u, 1);
+  ASSERT_EQ(RMW_RET_OK, wait(&long_timeout, ready)) << rmw_get_error_string().str;
+  EXPECT_TRUE(ready[0]);
+  EXPECT_FALSE(ready[2]);
+  take(0u, 1);
+
+  publish(1u, 2);
+  bool taken = false;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!taken && std::chrono::steady_clock::now() < deadline) {
+    ASSERT_EQ(RMW_RET_OK, wait(&long_timeout, ready)) << rmw_get_error_string().str;
+    EXPECT_FALSE(ready[0]);
+    taken = ready[1];
+  }
+  ASSERT_TRUE(taken);
+  take(1u, 2);
+
+  EXPECT_EQ(RMW_RET_OK, rmw_trigger_guard_condition(guard_condition));
+  ASSERT_EQ(RMW_RET_OK, wait(&long_timeout, ready)) << rmw_get_error_string().str;
+  EXPECT_FALSE(ready[0] || ready[1]);
+  EXPECT_TRUE(ready[2]);
+}
+
+TEST_F(TestRoutingLoopback, routed_data_wakes_blocked_wait) {
+  // The loaded RMW implementation blocks, and must be woken up by
+  // rmw_loopback_cpp well before the wait times out.
+  std::thread publisher([this]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      publish(0u, 3);
+    });
+  bool ready[3];
+  const rmw_time_t long_timeout{30u, 0u};
+  const auto start = std::chrono::steady_clock::now();
+  rmw_ret_t ret = wait(&long_timeout, ready);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  publisher.join();
+  ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  EXPECT_TRUE(ready[0]);
+  EXPECT_LT(elapsed, std::chrono::seconds(10));
+  take(0u, 3);
+}
+
+TEST_F(TestRoutingLoopback, routed_graph_changes_wake_graph_listeners) {
+  const rmw_guard_condition_t * graph_guard_condition = rmw_node_get_graph_guard_condition(node);
+  ASSERT_NE(nullptr, graph_guard_condition) << rmw_get_error_string().str;
+  void * guard_conditions[1] = {graph_guard_condition->data};
+  rmw_subscriptions_t subscriptions{0u, nullptr};
+  rmw_guard_conditions_t conditions{1u, guard_conditions};
+  rmw_services_t services{0u, nullptr};
+  rmw_clients_t clients{0u, nullptr};
+  rmw_events_t events{0u, nullptr};
+
+  // Let graph changes seen so far settle.
+  const rmw_time_t short_timeout{0u, 100000000u};
+  for (size_t i = 0u; i < 100u; ++i) {
+    rmw_ret_t ret = rmw_wait(
+      &subscriptions, &conditions, &services, &clients, &events, wait_set, &short_timeout);
+    if (RMW_RET_TIMEOUT == ret) {
+      break;
+    }
+    ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+    guard_conditions[0] = graph_guard_condition->data;
+  }
+
+  rmw_publisher_options_t publisher_options = rmw_get_default_publisher_options();
+  rmw_publisher_t * pub = rmw_create_publisher(
+    node, ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes), "/routed_graph",
+    &rmw_qos_profile_default, &publisher_options);
+  ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+  guard_conditions[0] = graph_guard_condition->data;
+  const rmw_time_t long_timeout{10u, 0u};
+  EXPECT_EQ(
+    RMW_RET_OK,
+    rmw_wait(&subscriptions, &conditions, &services, &clients, &events, wait_set, &long_timeout)) <<
+    rmw_get_error_string().str;
+  EXPECT_NE(nullptr, guard_conditions[0]);
+  EXPECT_EQ(RMW_RET_OK, rmw_destroy_publisher(node, pub)) << rmw_get_error_string().str;
+}
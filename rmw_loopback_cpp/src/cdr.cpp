@@ -0,0 +1,523 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./cdr.hpp"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "rmw/error_handling.h"
+
+#include "rosidl_runtime_c/string.h"
+#include "rosidl_runtime_c/string_functions.h"
+#include "rosidl_runtime_c/u16string.h"
+#include "rosidl_runtime_c/u16string_functions.h"
+
+#include "rosidl_typesupport_introspection_c/field_types.h"
+#include "rosidl_typesupport_introspection_c/identifier.h"
+#include "rosidl_typesupport_introspection_c/message_introspection.h"
+#include "rosidl_typesupport_introspection_c/service_introspection.h"
+#include "rosidl_typesupport_introspection_cpp/identifier.hpp"
+#include "rosidl_typesupport_introspection_cpp/message_introspection.hpp"
+#include "rosidl_typesupport_introspection_cpp/service_introspection.hpp"
+
+namespace rmw_loopback_cpp
+{
+
+namespace
+{
+
+using CMessageMembers = rosidl_typesupport_introspection_c__MessageMembers;
+using CppMessageMembers = rosidl_typesupport_introspection_cpp::MessageMembers;
+
+template<typename MessageMembersT>
+constexpr bool is_cpp = std::is_same_v<MessageMembersT, CppMessageMembers>;
+
+bool
+host_is_little_endian()
+{
+  const uint16_t value = 1u;
+  uint8_t first_byte;
+  std::memcpy(&first_byte, &value, 1u);
+  return 1u == first_byte;
+}
+
+// Get the size of primitives of the given field type, or zero for strings
+// and messages.
+// Field type ids are shared by C and C++ introspection.
+size_t
+get_primitive_size(uint8_t type_id)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      return sizeof(float);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      return sizeof(double);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
+      return sizeof(long double);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      return 1u;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      return 2u;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      return 4u;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      return 8u;
+    default:
+      return 0u;
+  }
+}
+
+// Get the alignment of primitives of the given size.
+size_t
+get_alignment(size_t size)
+{
+  return size < 8u ? size : 8u;
+}
+
+// Build a type name like `pkg/msg/Type` out of a namespace like `pkg__msg`,
+// as in C, or `pkg::msg`, as in C++.
+std::string
+make_type_name(const char * type_namespace, const char * type_name)
+{
+  std::string name;
+  for (const char * c = type_namespace; '\0' != *c; ++c) {
+    if ((':' == c[0] && ':' == c[1]) || ('_' == c[0] && '_' == c[1])) {
+      name += '/';
+      ++c;
+    } else {
+      name += *c;
+    }
+  }
+  return name + "/" + type_name;
+}
+
+class CdrWriter
+{
+public:
+  explicit CdrWriter(std::vector<uint8_t> & buffer)
+  : buffer_(buffer)
+  {
+    const uint8_t header[cdr_header_size] = {
+      0x00u, static_cast<uint8_t>(host_is_little_endian() ? 0x01u : 0x00u), 0x00u, 0x00u};
+    buffer_.assign(header, header + cdr_header_size);
+  }
+
+  void write(const void * data, size_t size, size_t alignment)
+  {
+    if (0u == size) {
+      return;
+    }
+    const size_t offset = buffer_.size();
+    const size_t padding = (alignment - (offset - cdr_header_size) % alignment) % alignment;
+    buffer_.resize(offset + padding + size);
+    std::memcpy(buffer_.data() + offset + padding, data, size);
+  }
+
+  void write_length(size_t length)
+  {
+    if (length > UINT32_MAX) {
+      throw std::length_error("sequence or string is too long to be encoded");
+    }
+    const uint32_t value = static_cast<uint32_t>(length);
+    write(&value, sizeof(value), sizeof(value));
+  }
+
+  void write_string(const char * data, size_t size)
+  {
+    write_length(size + 1u);
+    write(data, size, 1u);
+    const char terminator = '\0';
+    write(&terminator, 1u, 1u);
+  }
+
+private:
+  std::vector<uint8_t> & buffer_;
+};
+
+class CdrReader
+{
+public:
+  CdrReader(const uint8_t * data, size_t size)
+  : data_(data), size_(size)
+  {
+  }
+
+  bool read_header()
+  {
+    if (!data_ || size_ < cdr_header_size) {
+      return false;
+    }
+    position_ = cdr_header_size;
+    return data_[1] == (host_is_little_endian() ? 0x01u : 0x00u);
+  }
+
+  // Get a pointer to the given number of bytes at the given alignment, and
+  // skip past them.
+  const uint8_t * advance(size_t size, size_t alignment)
+  {
+    if (0u == size) {
+      return data_ + position_;
+    }
+    const size_t padding = (alignment - (position_ - cdr_header_size) % alignment) % alignment;
+    if (padding > size_ - position_ || size > size_ - position_ - padding) {
+      return nullptr;
+    }
+    const uint8_t * data = data_ + position_ + padding;
+    position_ += padding + size;
+    return data;
+  }
+
+  bool read(void * data, size_t size, size_t alignment)
+  {
+    const uint8_t * source = advance(size, alignment);
+    if (!source) {
+      return false;
+    }
+    if (size > 0u) {
+      std::memcpy(data, source, size);
+    }
+    return true;
+  }
+
+  // Read a sequence or string length, rejecting lengths that could not
+  // possibly fit in the remaining data so as not to allocate for them.
+  bool read_length(size_t & length)
+  {
+    uint32_t value;
+    if (!read(&value, sizeof(value), sizeof(value)) || value > size_ - position_) {
+      return false;
+    }
+    length = value;
+    return true;
+  }
+
+private:
+  const uint8_t * data_;
+  size_t size_;
+  size_t position_{0u};
+};
+
+template<typename MessageMembersT>
+void
+serialize_message(CdrWriter & writer, const MessageMembersT * members, const void * message);
+
+template<typename MessageMembersT, typename MessageMemberT>
+void
+serialize_value(CdrWriter & writer, const MessageMemberT & member, const void * value)
+{
+  switch (member.type_id_) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+      if constexpr (is_cpp<MessageMembersT>) {
+        const auto & string = *static_cast<const std::string *>(value);
+        writer.write_string(string.data(), string.size());
+      } else {
+        const auto & string = *static_cast<const rosidl_runtime_c__String *>(value);
+        writer.write_string(string.data, string.data ? string.size : 0u);
+      }
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
+      if constexpr (is_cpp<MessageMembersT>) {
+        const auto & string = *static_cast<const std::u16string *>(value);
+        writer.write_length(string.size());
+        writer.write(string.data(), string.size() * sizeof(char16_t), sizeof(char16_t));
+      } else {
+        const auto & string = *static_cast<const rosidl_runtime_c__U16String *>(value);
+        const size_t size = string.data ? string.size : 0u;
+        writer.write_length(size);
+        writer.write(string.data, size * sizeof(uint16_t), sizeof(uint16_t));
+      }
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE:
+      serialize_message(
+        writer, static_cast<const MessageMembersT *>(member.members_->data), value);
+      break;
+    default:
+      {
+        const size_t size = get_primitive_size(member.type_id_);
+        writer.write(value, size, get_alignment(size));
+      }
+      break;
+  }
+}
+
+template<typename MessageMembersT>
+void
+serialize_message(CdrWriter & writer, const MessageMembersT * members, const void * message)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const auto & member = members->members_[i];
+    const void * field = static_cast<const uint8_t *>(message) + member.offset_;
+    if (!member.is_array_) {
+      serialize_value<MessageMembersT>(writer, member, field);
+      continue;
+    }
+    const bool is_sequence = 0u == member.array_size_ || member.is_upper_bound_;
+    size_t count = member.array_size_;
+    if (is_sequence) {
+      count = member.size_function(field);
+      writer.write_length(count);
+    }
+    if (0u == count) {
+      continue;
+    }
+    const size_t primitive_size = get_primitive_size(member.type_id_);
+    if (
+      is_cpp<MessageMembersT> && is_sequence &&
+      rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN == member.type_id_)
+    {
+      // Booleans are packed in std::vector<bool>.
+      for (size_t j = 0u; j < count; ++j) {
+        bool value;
+        member.fetch_function(field, j, &value);
+        writer.write(&value, sizeof(value), 1u);
+      }
+    } else if (primitive_size > 0u) {
+      // Primitives are contiguous.
+      const void * first = is_sequence ? member.get_const_function(field, 0u) : field;
+      writer.write(first, primitive_size * count, get_alignment(primitive_size));
+    } else {
+      for (size_t j = 0u; j < count; ++j) {
+        serialize_value<MessageMembersT>(writer, member, member.get_const_function(field, j));
+      }
+    }
+  }
+}
+
+template<typename MessageMembersT>
+bool
+deserialize_message(CdrReader & reader, const MessageMembersT * members, void * message);
+
+template<typename MessageMembersT, typename MessageMemberT>
+bool
+deserialize_value(CdrReader & reader, const MessageMemberT & member, void * value)
+{
+  switch (member.type_id_) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+      {
+        size_t length;
+        if (!reader.read_length(length) || 0u == length) {
+          return false;
+        }
+        const char * data = reinterpret_cast<const char *>(reader.advance(length, 1u));
+        if (!data || '\0' != data[length - 1u]) {
+          return false;
+        }
+        if (member.string_upper_bound_ > 0u && length - 1u > member.string_upper_bound_) {
+          return false;
+        }
+        if constexpr (is_cpp<MessageMembersT>) {
+          static_cast<std::string *>(value)->assign(data, length - 1u);
+        } else {
+          auto string = static_cast<rosidl_runtime_c__String *>(value);
+          if (!rosidl_runtime_c__String__assignn(string, data, length - 1u)) {
+            throw std::bad_alloc();
+          }
+        }
+      }
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
+      {
+        size_t length;
+        if (!reader.read_length(length)) {
+          return false;
+        }
+        if (member.string_upper_bound_ > 0u && length > member.string_upper_bound_) {
+          return false;
+        }
+        if constexpr (is_cpp<MessageMembersT>) {
+          auto string = static_cast<std::u16string *>(value);
+          string->resize(length);
+          return reader.read(string->data(), length * sizeof(char16_t), sizeof(char16_t));
+        } else {
+          auto string = static_cast<rosidl_runtime_c__U16String *>(value);
+          if (!rosidl_runtime_c__U16String__resize(string, length)) {
+            throw std::bad_alloc();
+          }
+          return reader.read(string->data, length * sizeof(uint16_t), sizeof(uint16_t));
+        }
+      }
+    case rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE:
+      return deserialize_message(
+        reader, static_cast<const MessageMembersT *>(member.members_->data), value);
+    default:
+      {
+        const size_t size = get_primitive_size(member.type_id_);
+        return reader.read(value, size, get_alignment(size));
+      }
+  }
+}
+
+template<typename MessageMembersT>
+bool
+deserialize_message(CdrReader & reader, const MessageMembersT * members, void * message)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const auto & member = members->members_[i];
+    void * field = static_cast<uint8_t *>(message) + member.offset_;
+    if (!member.is_array_) {
+      if (!deserialize_value<MessageMembersT>(reader, member, field)) {
+        return false;
+      }
+      continue;
+    }
+    const bool is_sequence = 0u == member.array_size_ || member.is_upper_bound_;
+    size_t count = member.array_size_;
+    if (is_sequence) {
+      if (!reader.read_length(count) || (member.is_upper_bound_ && count > member.array_size_)) {
+        return false;
+      }
+      if constexpr (is_cpp<MessageMembersT>) {
+        member.resize_function(field, count);
+      } else if (!member.resize_function(field, count)) {
+        throw std::bad_alloc();
+      }
+    }
+    if (0u == count) {
+      continue;
+    }
+    const size_t primitive_size = get_primitive_size(member.type_id_);
+    if (
+      is_cpp<MessageMembersT> && is_sequence &&
+      rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN == member.type_id_)
+    {
+      for (size_t j = 0u; j < count; ++j) {
+        bool value;
+        if (!reader.read(&value, sizeof(value), 1u)) {
+          return false;
+        }
+        member.assign_function(field, j, &value);
+      }
+    } else if (primitive_size > 0u) {
+      void * first = is_sequence ? member.get_function(field, 0u) : field;
+      if (!reader.read(first, primitive_size * count, get_alignment(primitive_size))) {
+        return false;
+      }
+    } else {
+      for (size_t j = 0u; j < count; ++j) {
+        if (!deserialize_value<MessageMembersT>(reader, member, member.get_function(field, j))) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+MessageCodec::MessageCodec(const rosidl_message_type_support_t * type_support)
+{
+  if (!type_support) {
+    throw std::invalid_argument("type support is null");
+  }
+  const rosidl_message_type_support_t * introspection =
+    get_message_typesupport_handle(type_support, rosidl_typesupport_introspection_c__identifier);
+  if (introspection) {
+    *this = MessageCodec(false, introspection->data);
+    return;
+  }
+  rmw_reset_error();
+  introspection = get_message_typesupport_handle(
+    type_support, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+  if (introspection) {
+    *this = MessageCodec(true, introspection->data);
+    return;
+  }
+  rmw_reset_error();
+  throw std::invalid_argument("message type support provides no introspection");
+}
+
+MessageCodec::MessageCodec(bool cpp, const void * members)
+: cpp_(cpp), members_(members)
+{
+  if (cpp_) {
+    auto message_members = static_cast<const CppMessageMembers *>(members_);
+    type_name_ = make_type_name(
+      message_members->message_namespace_, message_members->message_name_);
+  } else {
+    auto message_members = static_cast<const CMessageMembers *>(members_);
+    type_name_ = make_type_name(
+      message_members->message_namespace_, message_members->message_name_);
+  }
+}
+
+void
+MessageCodec::serialize(const void * message, std::vector<uint8_t> & buffer) const
+{
+  CdrWriter writer(buffer);
+  if (cpp_) {
+    serialize_message(writer, static_cast<const CppMessageMembers *>(members_), message);
+  } else {
+    serialize_message(writer, static_cast<const CMessageMembers *>(members_), message);
+  }
+}
+
+bool
+MessageCodec::deserialize(const uint8_t * data, size_t size, void * message) const
+{
+  CdrReader reader(data, size);
+  if (!reader.read_header()) {
+    return false;
+  }
+  if (cpp_) {
+    return deserialize_message(reader, static_cast<const CppMessageMembers *>(members_), message);
+  }
+  return deserialize_message(reader, static_cast<const CMessageMembers *>(members_), message);
+}
+
+ServiceCodecs::ServiceCodecs(const rosidl_service_type_support_t * type_support)
+{
+  if (!type_support) {
+    throw std::invalid_argument("type support is null");
+  }
+  const rosidl_service_type_support_t * introspection =
+    get_service_typesupport_handle(type_support, rosidl_typesupport_introspection_c__identifier);
+  if (introspection) {
+    auto members =
+      static_cast<const rosidl_typesupport_introspection_c__ServiceMembers *>(introspection->data);
+    type_name = make_type_name(members->service_namespace_, members->service_name_);
+    request = MessageCodec(false, members->request_members_);
+    response = MessageCodec(false, members->response_members_);
+    return;
+  }
+  rmw_reset_error();
+  introspection = get_service_typesupport_handle(
+    type_support, rosidl_typesupport_introspection_cpp::typesupport_identifier);
+  if (introspection) {
+    auto members =
+      static_cast<const rosidl_typesupport_introspection_cpp::ServiceMembers *>(
+      introspection->data);
+    type_name = make_type_name(members->service_namespace_, members->service_name_);
+    request = MessageCodec(true, members->request_members_);
+    response = MessageCodec(true, members->response_members_);
+    return;
+  }
+  rmw_reset_error();
+  throw std::invalid_argument("service type support provides no introspection");
+}
+
+}  // namespace rmw_loopback_cpp
@@ -0,0 +1,99 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef CDR_HPP_
+#define CDR_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rosidl_runtime_c/message_type_support_struct.h"
+#include "rosidl_runtime_c/service_type_support_struct.h"
+
+namespace rmw_loopback_cpp
+{
+
+/// Converts messages of a given type to and from CDR, as described by introspection.
+/**
+ * Messages are encoded in the byte order of the host, following a four byte
+ * encapsulation header, with primitives aligned to their size (eight bytes
+ * at most) relative to the end of the header, strings prefixed with their
+ * length including a null terminator, and sequences prefixed with their
+ * length, as DDS implementations do.
+ * Encoding does not depend on the language messages are laid out for, so
+ * messages published from C can be taken from C++ and the other way around.
+ */
+class MessageCodec
+{
+public:
+  /// Get a codec for messages of the given type.
+  /**
+   * \throws std::invalid_argument if the type support does not provide
+   *   introspection.
+   */
+  explicit MessageCodec(const rosidl_message_type_support_t * type_support);
+
+  /// Encode a message, replacing the contents of the buffer.
+  /**
+   * \throws std::bad_alloc if the buffer cannot grow.
+   */
+  void serialize(const void * message, std::vector<uint8_t> & buffer) const;
+
+  /// Decode a message, as encoded by serialize().
+  /**
+   * \return false if the data is malformed, truncated, or exceeds the bounds
+   *   of the message type, in which case the message is left partially decoded.
+   * \throws std::bad_alloc if memory for strings or sequences cannot be allocated.
+   */
+  bool deserialize(const uint8_t * data, size_t size, void * message) const;
+
+  /// Get the name of the message type, e.g. `std_msgs/msg/String`.
+  const std::string & type_name() const
+  {
+    return type_name_;
+  }
+
+private:
+  friend struct ServiceCodecs;
+
+  MessageCodec() = default;
+
+  /// Get a codec for messages described by the given C or C++ introspection members.
+  MessageCodec(bool cpp, const void * members);
+
+  bool cpp_{false};
+  const void * members_{nullptr};
+  std::string type_name_;
+};
+
+/// Codecs for requests and responses of a given service type.
+struct ServiceCodecs
+{
+  /// \throws std::invalid_argument if the type support does not provide introspection.
+  explicit ServiceCodecs(const rosidl_service_type_support_t * type_support);
+
+  /// Name of the service type, e.g. `std_srvs/srv/Empty`.
+  std::string type_name;
+  MessageCodec request;
+  MessageCodec response;
+};
+
+/// Size of the encapsulation header leading encoded messages.
+constexpr size_t cdr_header_size = 4u;
+
+}  // namespace rmw_loopback_cpp
+
+#endif  // CDR_HPP_
@@ -0,0 +1,480 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./domain.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rcutils/process.h"
+
+#include "./qos.hpp"
+
+namespace rmw_loopback_cpp
+{
+
+const char * const identifier = "rmw_loopback_cpp";
+const char * const serialization_format = "cdr";
+
+Gid
+make_gid()
+{
+  static std::atomic<uint64_t> count{0u};
+  static const int pid = rcutils_get_pid();
+  const uint64_t value = ++count;
+  Gid gid{};
+  std::memcpy(gid.data(), &pid, sizeof(pid));
+  std::memcpy(gid.data() + sizeof(uint64_t), &value, sizeof(value));
+  return gid;
+}
+
+Notifier &
+Notifier::instance()
+{
+  static Notifier notifier;
+  return notifier;
+}
+
+void
+Notifier::notify()
+{
+  generation_.fetch_add(1u);
+  if (waiters_.load() > 0u) {
+    // Waiters check the generation while holding the mutex, so locking it
+    // ensures they either see the new one or are blocked already.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+    }
+    condition_.notify_all();
+  }
+}
+
+bool
+Notifier::wait(uint64_t generation, const std::chrono::steady_clock::time_point * deadline)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  waiters_.fetch_add(1u);
+  bool notified = true;
+  while (generation_.load() == generation) {
+    if (!deadline) {
+      condition_.wait(lock);
+    } else if (std::cv_status::timeout == condition_.wait_until(lock, *deadline)) {
+      notified = generation_.load() != generation;
+      break;
+    }
+  }
+  waiters_.fetch_sub(1u);
+  return notified;
+}
+
+void
+SampleQueue::push(
+  const uint8_t * payload, size_t size, const Gid & writer_gid, int64_t sequence_number,
+  rcutils_time_point_value_t source_timestamp)
+{
+  rcutils_time_point_value_t now = source_timestamp;
+  rcutils_system_time_now(&now);
+  samples.push_overwriting(
+    [&](Sample & sample) {
+      // Cells must be released whatever happens, so samples that cannot be
+      // copied are left empty, to be dropped upon take.
+      try {
+        sample.payload.assign(payload, payload + size);
+      } catch (const std::bad_alloc &) {
+        sample.payload.clear();
+      }
+      sample.writer_gid = writer_gid;
+      sample.sequence_number = sequence_number;
+      sample.source_timestamp = source_timestamp;
+      sample.received_timestamp = now;
+    });
+  Notifier::instance().notify();
+  if (has_callback_.load()) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (callback_) {
+      callback_(user_data_, 1u);
+    }
+  }
+}
+
+void
+SampleQueue::set_callback(rmw_event_callback_t callback, const void * user_data)
+{
+  std::lock_guard<std::mutex> lock(callback_mutex_);
+  callback_ = callback;
+  user_data_ = user_data;
+  has_callback_.store(nullptr != callback);
+  // Samples queued beforehand are reported right away.
+  const size_t count = samples.size();
+  if (callback && count > 0u) {
+    callback(user_data, count);
+  }
+}
+
+void
+EventStatuses::changed(rmw_event_type_t event_type)
+{
+  unread[event_type].store(true);
+  Notifier::instance().notify();
+  if (callbacks[event_type]) {
+    callbacks[event_type](user_data[event_type], 1u);
+  }
+}
+
+std::shared_ptr<Domain>
+Domain::get(size_t domain_id)
+{
+  static std::mutex mutex;
+  static std::map<size_t, std::weak_ptr<Domain>> domains;
+  std::lock_guard<std::mutex> lock(mutex);
+  std::shared_ptr<Domain> domain = domains[domain_id].lock();
+  if (!domain) {
+    domain = std::make_shared<Domain>();
+    domains[domain_id] = domain;
+  }
+  return domain;
+}
+
+void
+Domain::notify_graph_change()
+{
+  for (Node * node : nodes) {
+    node->graph_guard_condition.triggered.store(true);
+  }
+  Notifier::instance().notify();
+}
+
+const Node *
+Domain::find_node(std::string_view name, std::string_view namespace_) const
+{
+  for (const Node * node : nodes) {
+    if (node->name == name && node->namespace_ == namespace_) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+namespace
+{
+
+template<typename MapT>
+typename MapT::mapped_type::element_type &
+get_or_add(MapT & map, const std::string & name)
+{
+  auto it = map.find(name);
+  if (map.end() == it) {
+    it = map.emplace(name, std::make_unique<typename MapT::mapped_type::element_type>()).first;
+  }
+  return *it->second;
+}
+
+template<typename MapT, typename EntryT>
+void
+erase_if_empty(MapT & map, const std::string & name, const EntryT & entry)
+{
+  auto it = map.find(name);
+  if (map.end() != it && it->second.get() == &entry) {
+    map.erase(it);
+  }
+}
+
+void
+record_match(EventStatuses & events, rmw_event_type_t event_type, int32_t change)
+{
+  std::lock_guard<std::mutex> lock(events.mutex);
+  if (change > 0) {
+    ++events.matched.total_count;
+    ++events.matched.total_count_change;
+    ++events.matched.current_count;
+  } else {
+    --events.matched.current_count;
+  }
+  events.matched.current_count_change += change;
+  events.changed(event_type);
+}
+
+void
+record_incompatible_qos(
+  EventStatuses & events, rmw_event_type_t event_type, rmw_qos_policy_kind_t policy)
+{
+  std::lock_guard<std::mutex> lock(events.mutex);
+  ++events.incompatible_qos.total_count;
+  ++events.incompatible_qos.total_count_change;
+  events.incompatible_qos.last_policy_kind = policy;
+  events.changed(event_type);
+}
+
+void
+record_incompatible_type(EventStatuses & events, rmw_event_type_t event_type)
+{
+  std::lock_guard<std::mutex> lock(events.mutex);
+  ++events.incompatible_type.total_count;
+  ++events.incompatible_type.total_count_change;
+  events.changed(event_type);
+}
+
+// Match a publisher with a subscription if their types and profiles are
+// compatible, or report why they are not.
+// The topic mutex must be held exclusively, and room must have been reserved
+// in the publisher's list of matched subscriptions.
+void
+match(Publisher & publisher, Subscription & subscription)
+{
+  if (publisher.codec.type_name() != subscription.codec.type_name()) {
+    record_incompatible_type(publisher.events, RMW_EVENT_PUBLISHER_INCOMPATIBLE_TYPE);
+    record_incompatible_type(subscription.events, RMW_EVENT_SUBSCRIPTION_INCOMPATIBLE_TYPE);
+    return;
+  }
+  const rmw_qos_policy_kind_t policy = find_incompatible_policy(publisher.qos, subscription.qos);
+  if (RMW_QOS_POLICY_INVALID != policy) {
+    record_incompatible_qos(publisher.events, RMW_EVENT_OFFERED_QOS_INCOMPATIBLE, policy);
+    record_incompatible_qos(subscription.events, RMW_EVENT_REQUESTED_QOS_INCOMPATIBLE, policy);
+    return;
+  }
+  publisher.matched.push_back(&subscription);
+  ++publisher.matched_count;
+  ++subscription.matched_count;
+  record_match(publisher.events, RMW_EVENT_PUBLICATION_MATCHED, 1);
+  record_match(subscription.events, RMW_EVENT_SUBSCRIPTION_MATCHED, 1);
+}
+
+void
+unmatch(Publisher & publisher, Subscription & subscription)
+{
+  --publisher.matched_count;
+  --subscription.matched_count;
+  record_match(publisher.events, RMW_EVENT_PUBLICATION_MATCHED, -1);
+  record_match(subscription.events, RMW_EVENT_SUBSCRIPTION_MATCHED, -1);
+}
+
+template<typename T>
+void
+erase_value(std::vector<T> & values, const T & value)
+{
+  values.erase(std::remove(values.begin(), values.end(), value), values.end());
+}
+
+}  // namespace
+
+void
+add_publisher(Domain & domain, Publisher & publisher)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  Topic & topic = get_or_add(domain.topics, publisher.topic_name);
+  {
+    std::unique_lock<std::shared_mutex> topic_lock(topic.mutex);
+    topic.publishers.reserve(topic.publishers.size() + 1u);
+    publisher.matched.reserve(topic.subscriptions.size());
+    topic.publishers.push_back(&publisher);
+    publisher.topic = &topic;
+    for (Subscription * subscription : topic.subscriptions) {
+      match(publisher, *subscription);
+    }
+  }
+  domain.notify_graph_change();
+}
+
+void
+remove_publisher(Domain & domain, Publisher & publisher)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  Topic & topic = *publisher.topic;
+  bool is_empty;
+  {
+    std::unique_lock<std::shared_mutex> topic_lock(topic.mutex);
+    for (Subscription * subscription : publisher.matched) {
+      unmatch(publisher, *subscription);
+    }
+    publisher.matched.clear();
+    erase_value(topic.publishers, &publisher);
+    is_empty = topic.publishers.empty() && topic.subscriptions.empty();
+  }
+  if (is_empty) {
+    erase_if_empty(domain.topics, publisher.topic_name, topic);
+  }
+  domain.notify_graph_change();
+}
+
+void
+publish_payload(Publisher & publisher, const uint8_t * payload, size_t size)
+{
+  const int64_t sequence_number = ++publisher.sequence_number;
+  rcutils_time_point_value_t now = 0;
+  rcutils_system_time_now(&now);
+
+  if (RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL == publisher.qos.durability) {
+    std::lock_guard<std::mutex> lock(publisher.history_mutex);
+    if (publisher.history.size() >= get_queue_depth(publisher.qos)) {
+      // Recycle the oldest sample, along with its storage.
+      publisher.history.push_back(std::move(publisher.history.front()));
+      publisher.history.pop_front();
+    } else {
+      publisher.history.emplace_back();
+    }
+    Sample & sample = publisher.history.back();
+    sample.payload.assign(payload, payload + size);
+    sample.writer_gid = publisher.gid;
+    sample.sequence_number = sequence_number;
+    sample.source_timestamp = now;
+  }
+
+  const Context * context = publisher.node->context;
+  std::shared_lock<std::shared_mutex> lock(publisher.topic->mutex);
+  for (Subscription * subscription : publisher.matched) {
+    if (subscription->ignore_local_publications && subscription->node->context == context) {
+      continue;
+    }
+    subscription->queue.push(payload, size, publisher.gid, sequence_number, now);
+  }
+}
+
+void
+add_subscription(Domain & domain, Subscription & subscription)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  Topic & topic = get_or_add(domain.topics, subscription.topic_name);
+  {
+    std::unique_lock<std::shared_mutex> topic_lock(topic.mutex);
+    std::vector<rmw_qos_profile_t> offered;
+    offered.reserve(topic.publishers.size());
+    for (Publisher * publisher : topic.publishers) {
+      if (publisher->codec.type_name() == subscription.codec.type_name()) {
+        offered.push_back(publisher->qos);
+      }
+      publisher->matched.reserve(publisher->matched.size() + 1u);
+    }
+    subscription.qos = resolve_qos(subscription.qos, offered);
+    topic.subscriptions.reserve(topic.subscriptions.size() + 1u);
+
+    topic.subscriptions.push_back(&subscription);
+    subscription.topic = &topic;
+    for (Publisher * publisher : topic.publishers) {
+      const size_t matched_count = publisher->matched.size();
+      match(*publisher, subscription);
+      const bool is_matched = publisher->matched.size() > matched_count;
+      if (
+        !is_matched ||
+        RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL != subscription.qos.durability ||
+        RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL != publisher->qos.durability)
+      {
+        continue;
+      }
+      // Late joining subscriptions get the history of publishers.
+      std::lock_guard<std::mutex> history_lock(publisher->history_mutex);
+      for (const Sample & sample : publisher->history) {
+        subscription.queue.push(
+          sample.payload.data(), sample.payload.size(), sample.writer_gid,
+          sample.sequence_number, sample.source_timestamp);
+      }
+    }
+  }
+  domain.notify_graph_change();
+}
+
+void
+remove_subscription(Domain & domain, Subscription & subscription)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  Topic & topic = *subscription.topic;
+  bool is_empty;
+  {
+    std::unique_lock<std::shared_mutex> topic_lock(topic.mutex);
+    for (Publisher * publisher : topic.publishers) {
+      auto it = std::find(publisher->matched.begin(), publisher->matched.end(), &subscription);
+      if (publisher->matched.end() != it) {
+        publisher->matched.erase(it);
+        unmatch(*publisher, subscription);
+      }
+    }
+    erase_value(topic.subscriptions, &subscription);
+    is_empty = topic.publishers.empty() && topic.subscriptions.empty();
+  }
+  if (is_empty) {
+    erase_if_empty(domain.topics, subscription.topic_name, topic);
+  }
+  domain.notify_graph_change();
+}
+
+void
+add_service(Domain & domain, Service & service)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  ServiceTopic & service_topic = get_or_add(domain.services, service.service_name);
+  {
+    std::unique_lock<std::shared_mutex> service_lock(service_topic.mutex);
+    service_topic.services.push_back(&service);
+  }
+  service.service_topic = &service_topic;
+  domain.notify_graph_change();
+}
+
+void
+remove_service(Domain & domain, Service & service)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  ServiceTopic & service_topic = *service.service_topic;
+  bool is_empty;
+  {
+    std::unique_lock<std::shared_mutex> service_lock(service_topic.mutex);
+    erase_value(service_topic.services, &service);
+    is_empty = service_topic.services.empty() && service_topic.clients.empty();
+  }
+  if (is_empty) {
+    erase_if_empty(domain.services, service.service_name, service_topic);
+  }
+  domain.notify_graph_change();
+}
+
+void
+add_client(Domain & domain, Client & client)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  ServiceTopic & service_topic = get_or_add(domain.services, client.service_name);
+  {
+    std::unique_lock<std::shared_mutex> service_lock(service_topic.mutex);
+    service_topic.clients.push_back(&client);
+  }
+  client.service_topic = &service_topic;
+  domain.notify_graph_change();
+}
+
+void
+remove_client(Domain & domain, Client & client)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  ServiceTopic & service_topic = *client.service_topic;
+  bool is_empty;
+  {
+    std::unique_lock<std::shared_mutex> service_lock(service_topic.mutex);
+    erase_value(service_topic.clients, &client);
+    is_empty = service_topic.services.empty() && service_topic.clients.empty();
+  }
+  if (is_empty) {
+    erase_if_empty(domain.services, client.service_name, service_topic);
+  }
+  domain.notify_graph_change();
+}
+
+}  // namespace rmw_loopback_cpp
@@ -0,0 +1,377 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef DOMAIN_HPP_
+#define DOMAIN_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rcutils/time.h"
+
+#include "rmw/event.h"
+#include "rmw/event_callback_type.h"
+#include "rmw/events_statuses/events_statuses.h"
+#include "rmw/types.h"
+
+#include "./cdr.hpp"
+#include "./ring_buffer.hpp"
+
+// Everything is exchanged within the process, through per domain tables of
+// topics and services that publishers, subscriptions, clients and services
+// join upon creation and leave upon destruction, so they are matched right
+// away and graph queries see them right away too.
+// Messages are encoded once upon publication and copied into a bounded
+// lock-free queue per matching subscription, to be decoded upon take.
+
+namespace rmw_loopback_cpp
+{
+
+extern const char * const identifier;
+extern const char * const serialization_format;
+
+/// Depth of queues for KEEP_ALL history, which are bounded all the same.
+constexpr size_t keep_all_depth = 1000u;
+
+using Gid = std::array<uint8_t, RMW_GID_STORAGE_SIZE>;
+
+/// Get a new globally unique identifier.
+Gid
+make_gid();
+
+/// Wakes up threads blocked in rmw_wait() whenever anything they may be waiting on changes.
+/**
+ * Notifying is a single atomic increment unless some thread is waiting.
+ */
+class Notifier
+{
+public:
+  static Notifier & instance();
+
+  /// Get a number that changes whenever notify() is called.
+  uint64_t generation() const
+  {
+    return generation_.load();
+  }
+
+  void notify();
+
+  /// Block until notify() is called after generation() returned the given
+  /// number, or until the deadline if any.
+  /**
+   * \return false if the deadline passed first.
+   */
+  bool wait(uint64_t generation, const std::chrono::steady_clock::time_point * deadline);
+
+private:
+  std::atomic<uint64_t> generation_{0u};
+  std::atomic<size_t> waiters_{0u};
+  std::mutex mutex_;
+  std::condition_variable condition_;
+};
+
+struct GuardCondition
+{
+  void trigger()
+  {
+    triggered.store(true);
+    Notifier::instance().notify();
+  }
+
+  rmw_guard_condition_t handle;
+  std::atomic<bool> triggered{false};
+};
+
+/// A message, request or response, on its way to a subscription, service or client.
+struct Sample
+{
+  /// Encoded message, its storage reused from one sample to the next.
+  std::vector<uint8_t> payload;
+  /// Publisher or client it comes from.
+  Gid writer_gid;
+  int64_t sequence_number;
+  rcutils_time_point_value_t source_timestamp;
+  rcutils_time_point_value_t received_timestamp;
+};
+
+/// A queue of samples, waking up rmw_wait() and invoking a callback upon push.
+class SampleQueue
+{
+public:
+  /// \throws std::bad_alloc if the queue cannot be allocated.
+  explicit SampleQueue(size_t depth)
+  : samples(depth)
+  {
+  }
+
+  /// Push a copy of a sample, dropping the oldest one if the queue is full.
+  void push(
+    const uint8_t * payload, size_t size, const Gid & writer_gid, int64_t sequence_number,
+    rcutils_time_point_value_t source_timestamp);
+
+  void set_callback(rmw_event_callback_t callback, const void * user_data);
+
+  RingBuffer<Sample> samples;
+
+private:
+  std::atomic<bool> has_callback_{false};
+  std::mutex callback_mutex_;
+  rmw_event_callback_t callback_{nullptr};
+  const void * user_data_{nullptr};
+};
+
+/// Statuses of the events of a publisher or subscription, which rmw_event_t point to.
+struct EventStatuses
+{
+  /// Record a change of an event status, waking up rmw_wait() and invoking
+  /// the callback if any.
+  /**
+   * The mutex must be held.
+   */
+  void changed(rmw_event_type_t event_type);
+
+  std::mutex mutex;
+  std::array<std::atomic<bool>, RMW_EVENT_INVALID> unread{};
+  std::array<rmw_event_callback_t, RMW_EVENT_INVALID> callbacks{};
+  std::array<const void *, RMW_EVENT_INVALID> user_data{};
+  rmw_matched_status_t matched{};
+  rmw_qos_incompatible_event_status_t incompatible_qos{};
+  rmw_incompatible_type_status_t incompatible_type{};
+};
+
+struct Domain;
+struct Publisher;
+struct Subscription;
+struct Service;
+struct Client;
+
+struct Context
+{
+  std::shared_ptr<Domain> domain;
+  std::atomic<bool> is_shutdown{false};
+};
+
+struct Node
+{
+  rmw_node_t handle;
+  Context * context;
+  std::string name;
+  std::string namespace_;
+  std::string enclave;
+  GuardCondition graph_guard_condition;
+};
+
+/// Publishers and subscriptions of a topic.
+struct Topic
+{
+  /// Guards matching, and is held shared while publishing.
+  std::shared_mutex mutex;
+  std::vector<Publisher *> publishers;
+  std::vector<Subscription *> subscriptions;
+};
+
+struct Publisher
+{
+  /// \throws std::invalid_argument if the type support does not provide introspection.
+  explicit Publisher(const rosidl_message_type_support_t * type_support)
+  : codec(type_support)
+  {
+  }
+
+  rmw_publisher_t handle;
+  Node * node;
+  Topic * topic;
+  std::string topic_name;
+  MessageCodec codec;
+  rmw_qos_profile_t qos;
+  Gid gid;
+  /// Matched subscriptions, guarded by the topic mutex.
+  std::vector<Subscription *> matched;
+  std::atomic<size_t> matched_count{0u};
+  std::atomic<int64_t> sequence_number{0};
+  EventStatuses events;
+  /// Last samples published, kept for late joining subscriptions if
+  /// durability is TRANSIENT_LOCAL.
+  std::mutex history_mutex;
+  std::deque<Sample> history;
+};
+
+struct Subscription
+{
+  /// \throws std::invalid_argument if the type support does not provide introspection.
+  /// \throws std::bad_alloc if the queue cannot be allocated.
+  Subscription(const rosidl_message_type_support_t * type_support, size_t depth)
+  : codec(type_support), queue(depth)
+  {
+  }
+
+  rmw_subscription_t handle;
+  Node * node;
+  Topic * topic;
+  std::string topic_name;
+  MessageCodec codec;
+  rmw_qos_profile_t qos;
+  bool ignore_local_publications;
+  Gid gid;
+  SampleQueue queue;
+  std::atomic<size_t> matched_count{0u};
+  std::atomic<uint64_t> reception_sequence_number{0u};
+  EventStatuses events;
+};
+
+/// Services and clients of a service name.
+struct ServiceTopic
+{
+  /// Guards the lists, and is held shared while sending requests and responses.
+  std::shared_mutex mutex;
+  std::vector<Service *> services;
+  std::vector<Client *> clients;
+};
+
+struct Service
+{
+  /// \throws std::invalid_argument if the type support does not provide introspection.
+  /// \throws std::bad_alloc if the queue cannot be allocated.
+  Service(const rosidl_service_type_support_t * type_support, size_t depth)
+  : codecs(type_support), requests(depth)
+  {
+  }
+
+  rmw_service_t handle;
+  Node * node;
+  ServiceTopic * service_topic;
+  std::string service_name;
+  ServiceCodecs codecs;
+  rmw_qos_profile_t qos;
+  Gid gid;
+  SampleQueue requests;
+};
+
+struct Client
+{
+  /// \throws std::invalid_argument if the type support does not provide introspection.
+  /// \throws std::bad_alloc if the queue cannot be allocated.
+  Client(const rosidl_service_type_support_t * type_support, size_t depth)
+  : codecs(type_support), responses(depth)
+  {
+  }
+
+  rmw_client_t handle;
+  Node * node;
+  ServiceTopic * service_topic;
+  std::string service_name;
+  ServiceCodecs codecs;
+  rmw_qos_profile_t qos;
+  Gid gid;
+  SampleQueue responses;
+  std::atomic<int64_t> sequence_number{0};
+};
+
+/// Nodes, topics and services of a domain.
+/**
+ * Lookups by name take string views, so that they do not allocate.
+ */
+struct Domain
+{
+  /// Get the domain of the given id, shared by all contexts using it.
+  /**
+   * \throws std::bad_alloc if it cannot be allocated.
+   */
+  static std::shared_ptr<Domain> get(size_t domain_id);
+
+  /// Trigger the graph guard conditions of all nodes.
+  /**
+   * The mutex must be held.
+   */
+  void notify_graph_change();
+
+  /// Find a node by name and namespace.
+  /**
+   * The mutex must be held.
+   */
+  const Node * find_node(std::string_view name, std::string_view namespace_) const;
+
+  /// Guards everything below, but not the contents of topics and services.
+  std::mutex mutex;
+  std::vector<Node *> nodes;
+  std::map<std::string, std::unique_ptr<Topic>, std::less<>> topics;
+  std::map<std::string, std::unique_ptr<ServiceTopic>, std::less<>> services;
+};
+
+/// Add a publisher to its topic, matching it with subscriptions.
+/**
+ * \throws std::bad_alloc if the topic cannot be created or grow.
+ */
+void
+add_publisher(Domain & domain, Publisher & publisher);
+
+void
+remove_publisher(Domain & domain, Publisher & publisher);
+
+/// Send a message to all subscriptions matched with a publisher, but those
+/// ignoring local publications if it belongs to the same context.
+/**
+ * \throws std::bad_alloc if the publisher history cannot grow.
+ */
+void
+publish_payload(Publisher & publisher, const uint8_t * payload, size_t size);
+
+/// Add a subscription to its topic, matching it with publishers, and
+/// replaying the history of TRANSIENT_LOCAL publishers to it.
+/**
+ * \throws std::bad_alloc if the topic cannot be created or grow.
+ */
+void
+add_subscription(Domain & domain, Subscription & subscription);
+
+void
+remove_subscription(Domain & domain, Subscription & subscription);
+
+/// \throws std::bad_alloc if the service name cannot be registered or its lists grow.
+void
+add_service(Domain & domain, Service & service);
+
+void
+remove_service(Domain & domain, Service & service);
+
+/// \throws std::bad_alloc if the service name cannot be registered or its lists grow.
+void
+add_client(Domain & domain, Client & client);
+
+void
+remove_client(Domain & domain, Client & client);
+
+/// Get the domain a node belongs to.
+inline Domain &
+get_domain(const rmw_node_t * node)
+{
+  return *static_cast<const Node *>(node->data)->context->domain;
+}
+
+}  // namespace rmw_loopback_cpp
+
+#endif  // DOMAIN_HPP_
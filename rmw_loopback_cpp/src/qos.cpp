@@ -0,0 +1,237 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "./qos.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "rmw/error_handling.h"
+#include "rmw/qos_profiles.h"
+#include "rmw/qos_string_conversions.h"
+#include "rmw/rmw.h"
+#include "rmw/time.h"
+
+#include "./domain.hpp"
+
+namespace rmw_loopback_cpp
+{
+
+namespace
+{
+
+bool
+is_best_available(const rmw_time_t & duration)
+{
+  const rmw_time_t best_available = RMW_QOS_DEADLINE_BEST_AVAILABLE;
+  return duration.sec == best_available.sec && duration.nsec == best_available.nsec;
+}
+
+// Get a duration in nanoseconds, unspecified durations standing for infinite ones.
+rmw_duration_t
+get_duration(const rmw_time_t & duration)
+{
+  if (0u == duration.sec && 0u == duration.nsec) {
+    return std::numeric_limits<rmw_duration_t>::max();
+  }
+  return rmw_time_total_nsec(duration);
+}
+
+// Get the longest duration of those offered, or an unspecified one if none is.
+template<typename GetT>
+rmw_time_t
+get_longest_duration(const std::vector<rmw_qos_profile_t> & offered, GetT && get)
+{
+  rmw_time_t longest = RMW_DURATION_UNSPECIFIED;
+  for (auto it = offered.begin(); it != offered.end(); ++it) {
+    if (offered.begin() == it || get_duration(get(*it)) > get_duration(longest)) {
+      longest = get(*it);
+    }
+  }
+  return longest;
+}
+
+}  // namespace
+
+bool
+has_unknown_policy(const rmw_qos_profile_t & qos)
+{
+  return
+    RMW_QOS_POLICY_HISTORY_UNKNOWN == qos.history ||
+    RMW_QOS_POLICY_RELIABILITY_UNKNOWN == qos.reliability ||
+    RMW_QOS_POLICY_DURABILITY_UNKNOWN == qos.durability ||
+    RMW_QOS_POLICY_LIVELINESS_UNKNOWN == qos.liveliness;
+}
+
+rmw_qos_profile_t
+resolve_qos(const rmw_qos_profile_t & qos, const std::vector<rmw_qos_profile_t> & offered)
+{
+  auto all_offered = [&offered](auto && predicate) {
+      return std::all_of(offered.begin(), offered.end(), predicate);
+    };
+
+  rmw_qos_profile_t resolved = qos;
+  if (RMW_QOS_POLICY_HISTORY_SYSTEM_DEFAULT == resolved.history) {
+    resolved.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+  }
+  if (RMW_QOS_POLICY_HISTORY_KEEP_LAST == resolved.history && 0u == resolved.depth) {
+    resolved.depth = 1u;
+  }
+  if (RMW_QOS_POLICY_RELIABILITY_SYSTEM_DEFAULT == resolved.reliability) {
+    resolved.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+  } else if (RMW_QOS_POLICY_RELIABILITY_BEST_AVAILABLE == resolved.reliability) {
+    resolved.reliability =
+      all_offered(
+      [](const rmw_qos_profile_t & qos) {
+        return RMW_QOS_POLICY_RELIABILITY_RELIABLE == qos.reliability;
+      }) ? RMW_QOS_POLICY_RELIABILITY_RELIABLE : RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT;
+  }
+  if (RMW_QOS_POLICY_DURABILITY_SYSTEM_DEFAULT == resolved.durability) {
+    resolved.durability = RMW_QOS_POLICY_DURABILITY_VOLATILE;
+  } else if (RMW_QOS_POLICY_DURABILITY_BEST_AVAILABLE == resolved.durability) {
+    resolved.durability =
+      all_offered(
+      [](const rmw_qos_profile_t & qos) {
+        return RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL == qos.durability;
+      }) ? RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL : RMW_QOS_POLICY_DURABILITY_VOLATILE;
+  }
+  if (RMW_QOS_POLICY_LIVELINESS_SYSTEM_DEFAULT == resolved.liveliness) {
+    resolved.liveliness = RMW_QOS_POLICY_LIVELINESS_AUTOMATIC;
+  } else if (RMW_QOS_POLICY_LIVELINESS_BEST_AVAILABLE == resolved.liveliness) {
+    resolved.liveliness =
+      !offered.empty() && all_offered(
+      [](const rmw_qos_profile_t & qos) {
+        return RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC == qos.liveliness;
+      }) ? RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC : RMW_QOS_POLICY_LIVELINESS_AUTOMATIC;
+  }
+  if (is_best_available(resolved.deadline)) {
+    resolved.deadline = get_longest_duration(
+      offered, [](const rmw_qos_profile_t & qos) {return qos.deadline;});
+  }
+  if (is_best_available(resolved.liveliness_lease_duration)) {
+    resolved.liveliness_lease_duration = get_longest_duration(
+      offered, [](const rmw_qos_profile_t & qos) {return qos.liveliness_lease_duration;});
+  }
+  return resolved;
+}
+
+size_t
+get_queue_depth(const rmw_qos_profile_t & qos)
+{
+  if (RMW_QOS_POLICY_HISTORY_KEEP_ALL == qos.history) {
+    return keep_all_depth;
+  }
+  return std::max<size_t>(qos.depth, 1u);
+}
+
+rmw_qos_policy_kind_t
+find_incompatible_policy(const rmw_qos_profile_t & offered, const rmw_qos_profile_t & requested)
+{
+  if (
+    RMW_QOS_POLICY_RELIABILITY_BEST_EFFORT == offered.reliability &&
+    RMW_QOS_POLICY_RELIABILITY_RELIABLE == requested.reliability)
+  {
+    return RMW_QOS_POLICY_RELIABILITY;
+  }
+  if (
+    RMW_QOS_POLICY_DURABILITY_VOLATILE == offered.durability &&
+    RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL == requested.durability)
+  {
+    return RMW_QOS_POLICY_DURABILITY;
+  }
+  if (
+    !is_best_available(offered.deadline) && !is_best_available(requested.deadline) &&
+    get_duration(offered.deadline) > get_duration(requested.deadline))
+  {
+    return RMW_QOS_POLICY_DEADLINE;
+  }
+  if (
+    RMW_QOS_POLICY_LIVELINESS_AUTOMATIC == offered.liveliness &&
+    RMW_QOS_POLICY_LIVELINESS_MANUAL_BY_TOPIC == requested.liveliness)
+  {
+    return RMW_QOS_POLICY_LIVELINESS;
+  }
+  if (
+    !is_best_available(offered.liveliness_lease_duration) &&
+    !is_best_available(requested.liveliness_lease_duration) &&
+    get_duration(offered.liveliness_lease_duration) >
+    get_duration(requested.liveliness_lease_duration))
+  {
+    return RMW_QOS_POLICY_LIVELINESS_LEASE_DURATION;
+  }
+  return RMW_QOS_POLICY_INVALID;
+}
+
+}  // namespace rmw_loopback_cpp
+
+extern "C"
+{
+rmw_ret_t
+rmw_qos_profile_check_compatible(
+  const rmw_qos_profile_t publisher_profile,
+  const rmw_qos_profile_t subscription_profile,
+  rmw_qos_compatibility_type_t * compatibility,
+  char * reason,
+  size_t reason_size)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(compatibility, RMW_RET_INVALID_ARGUMENT);
+  if (!reason && 0u != reason_size) {
+    RMW_SET_ERROR_MSG("reason is null but reason_size is not zero");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (reason_size > 0u) {
+    reason[0] = '\0';
+  }
+
+  const rmw_qos_policy_kind_t policy =
+    rmw_loopback_cpp::find_incompatible_policy(publisher_profile, subscription_profile);
+  if (RMW_QOS_POLICY_INVALID != policy) {
+    *compatibility = RMW_QOS_COMPATIBILITY_ERROR;
+    if (reason_size > 0u) {
+      std::snprintf(
+        reason, reason_size, "ERROR: offered %s policy does not satisfy the requested one;",
+        rmw_qos_policy_kind_to_str(policy));
+    }
+    return RMW_RET_OK;
+  }
+
+  // Policies left to the system or to be resolved upon matching may turn out incompatible.
+  const bool undecided =
+    RMW_QOS_POLICY_RELIABILITY_SYSTEM_DEFAULT == publisher_profile.reliability ||
+    RMW_QOS_POLICY_RELIABILITY_SYSTEM_DEFAULT == subscription_profile.reliability ||
+    RMW_QOS_POLICY_RELIABILITY_UNKNOWN == publisher_profile.reliability ||
+    RMW_QOS_POLICY_RELIABILITY_UNKNOWN == subscription_profile.reliability ||
+    RMW_QOS_POLICY_DURABILITY_SYSTEM_DEFAULT == publisher_profile.durability ||
+    RMW_QOS_POLICY_DURABILITY_SYSTEM_DEFAULT == subscription_profile.durability ||
+    RMW_QOS_POLICY_DURABILITY_UNKNOWN == publisher_profile.durability ||
+    RMW_QOS_POLICY_DURABILITY_UNKNOWN == subscription_profile.durability ||
+    RMW_QOS_POLICY_LIVELINESS_SYSTEM_DEFAULT == publisher_profile.liveliness ||
+    RMW_QOS_POLICY_LIVELINESS_SYSTEM_DEFAULT == subscription_profile.liveliness ||
+    RMW_QOS_POLICY_LIVELINESS_UNKNOWN == publisher_profile.liveliness ||
+    RMW_QOS_POLICY_LIVELINESS_UNKNOWN == subscription_profile.liveliness;
+  if (undecided) {
+    *compatibility = RMW_QOS_COMPATIBILITY_WARNING;
+    if (reason_size > 0u) {
+      std::snprintf(
+        reason, reason_size,
+        "WARNING: some policies are left to the system and may turn out incompatible;");
+    }
+    return RMW_RET_OK;
+  }
+  *compatibility = RMW_QOS_COMPATIBILITY_OK;
+  return RMW_RET_OK;
+}
+}  // extern "C"
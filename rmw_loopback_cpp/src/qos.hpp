@@ -0,0 +1,57 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef QOS_HPP_
+#define QOS_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "rmw/qos_policy_kind.h"
+#include "rmw/types.h"
+
+namespace rmw_loopback_cpp
+{
+
+/// Check whether any policy of a profile is UNKNOWN, which cannot be honored.
+bool
+has_unknown_policy(const rmw_qos_profile_t & qos);
+
+/// Replace SYSTEM_DEFAULT policies by the values they stand for, and
+/// BEST_AVAILABLE ones by the strictest values that the given offered
+/// profiles all satisfy.
+/**
+ * Publishers, services and clients resolve their profile against no offered
+ * profile, which yields RELIABLE, TRANSIENT_LOCAL and AUTOMATIC policies,
+ * and subscriptions against the profiles of the publishers of their topic.
+ */
+rmw_qos_profile_t
+resolve_qos(
+  const rmw_qos_profile_t & qos, const std::vector<rmw_qos_profile_t> & offered = {});
+
+/// Get the number of samples to queue for a profile.
+size_t
+get_queue_depth(const rmw_qos_profile_t & qos);
+
+/// Find the first policy for which a publisher offering a profile cannot
+/// satisfy a subscription requesting another.
+/**
+ * \return RMW_QOS_POLICY_INVALID if they are compatible.
+ */
+rmw_qos_policy_kind_t
+find_incompatible_policy(const rmw_qos_profile_t & offered, const rmw_qos_profile_t & requested);
+
+}  // namespace rmw_loopback_cpp
+
+#endif  // QOS_HPP_
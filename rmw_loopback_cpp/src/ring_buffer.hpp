@@ -0,0 +1,173 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RING_BUFFER_HPP_
+#define RING_BUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace rmw_loopback_cpp
+{
+
+/// A bounded lock-free queue, safe to use from any number of producers and consumers.
+/**
+ * Cells are allocated once upon construction and reused forever after, so
+ * values that own storage, like buffers, keep it from one use to the next
+ * and pushing or popping does not allocate once they have grown large enough.
+ * Values are filled and drained in place, by callables given exclusive
+ * access to their cell, rather than moved in and out.
+ *
+ * Every cell carries a sequence number telling producers and consumers
+ * whether it is theirs to use, as in Dmitry Vyukov's bounded MPMC queue.
+ * Compare-and-swaps on positions only contend between producers, or between
+ * consumers, so a single producer and a single consumer get through each
+ * operation in one of them.
+ */
+template<typename ValueT>
+class RingBuffer
+{
+public:
+  /// \throws std::bad_alloc if cells cannot be allocated.
+  explicit RingBuffer(size_t capacity)
+  : capacity_(capacity > 0u ? capacity : 1u),
+    // Sequence numbers cannot tell a filled cell from a free one if there is
+    // only one, so a queue of one value gets two, and is bounded by positions.
+    cell_count_(capacity_ > 1u ? capacity_ : 2u),
+    cells_(new Cell[cell_count_])
+  {
+    for (size_t i = 0u; i < cell_count_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  RingBuffer(const RingBuffer &) = delete;
+  RingBuffer & operator=(const RingBuffer &) = delete;
+
+  /// Claim the next free cell, if any, and have `fill` write to its value.
+  /**
+   * \return false if the queue is full.
+   */
+  template<typename FillT>
+  bool try_push(FillT && fill)
+  {
+    size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell & cell = cells_[position % cell_count_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t difference =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (0 == difference) {
+        if (
+          cell_count_ != capacity_ &&
+          position - dequeue_position_.load(std::memory_order_acquire) >= capacity_)
+        {
+          return false;
+        }
+        if (
+          enqueue_position_.compare_exchange_weak(
+            position, position + 1u, std::memory_order_relaxed))
+        {
+          fill(cell.value);
+          cell.sequence.store(position + 1u, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Claim the oldest filled cell, if any, and have `drain` read its value.
+  /**
+   * \return false if the queue is empty.
+   */
+  template<typename DrainT>
+  bool try_pop(DrainT && drain)
+  {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell & cell = cells_[position % cell_count_];
+      const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      const intptr_t difference =
+        static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1u);
+      if (0 == difference) {
+        if (
+          dequeue_position_.compare_exchange_weak(
+            position, position + 1u, std::memory_order_relaxed))
+        {
+          drain(cell.value);
+          cell.sequence.store(position + cell_count_, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Push a value, dropping the oldest ones to make room as needed.
+  template<typename FillT>
+  void push_overwriting(FillT && fill)
+  {
+    while (!try_push(fill)) {
+      try_pop([](ValueT &) {});
+    }
+  }
+
+  /// Check whether a value is ready to be popped.
+  bool empty() const
+  {
+    const size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    const Cell & cell = cells_[position % cell_count_];
+    return cell.sequence.load(std::memory_order_acquire) != position + 1u;
+  }
+
+  /// Get the number of values in the queue, which may be stale by the time it returns.
+  size_t size() const
+  {
+    const size_t dequeue_position = dequeue_position_.load(std::memory_order_acquire);
+    const size_t enqueue_position = enqueue_position_.load(std::memory_order_acquire);
+    return enqueue_position > dequeue_position ? enqueue_position - dequeue_position : 0u;
+  }
+
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+private:
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    ValueT value;
+  };
+
+  const size_t capacity_;
+  const size_t cell_count_;
+  std::unique_ptr<Cell[]> cells_;
+  // Producers and consumers each get their own cache line.
+  alignas(64) std::atomic<size_t> enqueue_position_{0u};
+  alignas(64) std::atomic<size_t> dequeue_position_{0u};
+};
+
+}  // namespace rmw_loopback_cpp
+
+#endif  // RING_BUFFER_HPP_
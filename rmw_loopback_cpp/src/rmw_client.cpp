@@ -0,0 +1,280 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "rmw/error_handling.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+#include "rmw/validate_full_topic_name.h"
+
+#include "./domain.hpp"
+#include "./qos.hpp"
+
+using rmw_loopback_cpp::Client;
+using rmw_loopback_cpp::Sample;
+using rmw_loopback_cpp::Service;
+using rmw_loopback_cpp::identifier;
+
+extern "C"
+{
+rmw_client_t *
+rmw_create_client(
+  const rmw_node_t * node,
+  const rosidl_service_type_support_t * type_support,
+  const char * service_name,
+  const rmw_qos_profile_t * qos_profile)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(service_name, nullptr);
+  if (0 == strlen(service_name)) {
+    RMW_SET_ERROR_MSG("service_name argument is an empty string");
+    return nullptr;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_profile, nullptr);
+  if (!qos_profile->avoid_ros_namespace_conventions) {
+    int validation_result = RMW_TOPIC_VALID;
+    rmw_ret_t ret = rmw_validate_full_topic_name(service_name, &validation_result, nullptr);
+    if (RMW_RET_OK != ret) {
+      return nullptr;
+    }
+    if (RMW_TOPIC_VALID != validation_result) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "invalid service name: %s",
+        rmw_full_topic_name_validation_result_string(validation_result));
+      return nullptr;
+    }
+  }
+  if (rmw_loopback_cpp::has_unknown_policy(*qos_profile)) {
+    RMW_SET_ERROR_MSG("qos_profile has unknown policies");
+    return nullptr;
+  }
+
+  const rmw_qos_profile_t qos = rmw_loopback_cpp::resolve_qos(*qos_profile);
+  std::unique_ptr<Client> client;
+  try {
+    client = std::make_unique<Client>(type_support, rmw_loopback_cpp::get_queue_depth(qos));
+    client->service_name = service_name;
+  } catch (const std::invalid_argument & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate client");
+    return nullptr;
+  }
+  client->node = static_cast<rmw_loopback_cpp::Node *>(node->data);
+  client->service_topic = nullptr;
+  client->qos = qos;
+  client->gid = rmw_loopback_cpp::make_gid();
+  client->handle.implementation_identifier = identifier;
+  client->handle.data = client.get();
+  client->handle.service_name = client->service_name.c_str();
+
+  try {
+    rmw_loopback_cpp::add_client(rmw_loopback_cpp::get_domain(node), *client);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to register client");
+    return nullptr;
+  }
+  return &client.release()->handle;
+}
+
+rmw_ret_t
+rmw_destroy_client(rmw_node_t * node, rmw_client_t * client)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Client *>(client->data);
+  rmw_loopback_cpp::remove_client(rmw_loopback_cpp::get_domain(node), *impl);
+  delete impl;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_send_request(
+  const rmw_client_t * client,
+  const void * ros_request,
+  int64_t * sequence_id)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_request, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(sequence_id, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Client *>(client->data);
+
+  thread_local std::vector<uint8_t> buffer;
+  try {
+    impl->codecs.request.serialize(ros_request, buffer);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate memory to serialize request");
+    return RMW_RET_BAD_ALLOC;
+  }
+  rcutils_time_point_value_t now = 0;
+  rcutils_system_time_now(&now);
+  *sequence_id = ++impl->sequence_number;
+
+  std::shared_lock<std::shared_mutex> lock(impl->service_topic->mutex);
+  for (Service * service : impl->service_topic->services) {
+    if (service->codecs.type_name == impl->codecs.type_name) {
+      service->requests.push(buffer.data(), buffer.size(), impl->gid, *sequence_id, now);
+    }
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_take_response(
+  const rmw_client_t * client,
+  rmw_service_info_t * request_header,
+  void * ros_response,
+  bool * taken)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(request_header, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_response, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Client *>(client->data);
+
+  *taken = false;
+  rmw_ret_t ret = RMW_RET_OK;
+  const bool popped = impl->responses.samples.try_pop(
+    [&](const Sample & sample) {
+      try {
+        if (!impl->codecs.response.deserialize(
+          sample.payload.data(), sample.payload.size(), ros_response))
+        {
+          RMW_SET_ERROR_MSG("failed to deserialize response");
+          ret = RMW_RET_ERROR;
+          return;
+        }
+      } catch (const std::bad_alloc &) {
+        RMW_SET_ERROR_MSG("failed to allocate memory to deserialize response");
+        ret = RMW_RET_BAD_ALLOC;
+        return;
+      }
+      std::memcpy(
+        request_header->request_id.writer_guid, sample.writer_gid.data(),
+        sample.writer_gid.size());
+      request_header->request_id.sequence_number = sample.sequence_number;
+      request_header->source_timestamp = sample.source_timestamp;
+      request_header->received_timestamp = sample.received_timestamp;
+    });
+  *taken = popped && RMW_RET_OK == ret;
+  return ret;
+}
+
+rmw_ret_t
+rmw_client_request_publisher_get_actual_qos(
+  const rmw_client_t * client,
+  rmw_qos_profile_t * qos)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *qos = static_cast<Client *>(client->data)->qos;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_client_response_subscription_get_actual_qos(
+  const rmw_client_t * client,
+  rmw_qos_profile_t * qos)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *qos = static_cast<Client *>(client->data)->qos;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_service_server_is_available(
+  const rmw_node_t * node,
+  const rmw_client_t * client,
+  bool * is_available)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(is_available, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Client *>(client->data);
+
+  *is_available = false;
+  std::shared_lock<std::shared_mutex> lock(impl->service_topic->mutex);
+  for (const Service * service : impl->service_topic->services) {
+    if (service->codecs.type_name == impl->codecs.type_name) {
+      *is_available = true;
+      break;
+    }
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_get_gid_for_client(const rmw_client_t * client, rmw_gid_t * gid)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  const rmw_loopback_cpp::Gid & client_gid = static_cast<Client *>(client->data)->gid;
+  gid->implementation_identifier = identifier;
+  std::memcpy(gid->data, client_gid.data(), client_gid.size());
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_client_set_on_new_response_callback(
+  rmw_client_t * client,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(client, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    client, client->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  static_cast<Client *>(client->data)->responses.set_callback(callback, user_data);
+  return RMW_RET_OK;
+}
+}  // extern "C"
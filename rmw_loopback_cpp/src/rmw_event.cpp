@@ -0,0 +1,217 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <mutex>
+
+#include "rmw/error_handling.h"
+#include "rmw/event.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+
+#include "./domain.hpp"
+
+using rmw_loopback_cpp::EventStatuses;
+using rmw_loopback_cpp::Publisher;
+using rmw_loopback_cpp::Subscription;
+using rmw_loopback_cpp::identifier;
+
+namespace
+{
+
+bool
+is_publisher_event(rmw_event_type_t event_type)
+{
+  switch (event_type) {
+    case RMW_EVENT_LIVELINESS_LOST:
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+    case RMW_EVENT_OFFERED_QOS_INCOMPATIBLE:
+    case RMW_EVENT_PUBLISHER_INCOMPATIBLE_TYPE:
+    case RMW_EVENT_PUBLICATION_MATCHED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool
+is_subscription_event(rmw_event_type_t event_type)
+{
+  switch (event_type) {
+    case RMW_EVENT_LIVELINESS_CHANGED:
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+    case RMW_EVENT_REQUESTED_QOS_INCOMPATIBLE:
+    case RMW_EVENT_MESSAGE_LOST:
+    case RMW_EVENT_SUBSCRIPTION_INCOMPATIBLE_TYPE:
+    case RMW_EVENT_SUBSCRIPTION_MATCHED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Copy an event status and reset its changes.
+// Deadlines, liveliness and message loss are not simulated, so their
+// statuses never change.
+// The mutex of the statuses must be held.
+void
+take_status(EventStatuses & events, rmw_event_type_t event_type, void * event_info)
+{
+  switch (event_type) {
+    case RMW_EVENT_LIVELINESS_CHANGED:
+      {
+        // Publishers are alive as long as they exist.
+        auto status = static_cast<rmw_liveliness_changed_status_t *>(event_info);
+        status->alive_count = events.matched.current_count;
+        status->not_alive_count = 0;
+        status->alive_count_change = 0;
+        status->not_alive_count_change = 0;
+        break;
+      }
+    case RMW_EVENT_REQUESTED_DEADLINE_MISSED:
+      {
+        auto status = static_cast<rmw_requested_deadline_missed_status_t *>(event_info);
+        status->total_count = 0;
+        status->total_count_change = 0;
+        break;
+      }
+    case RMW_EVENT_LIVELINESS_LOST:
+      {
+        auto status = static_cast<rmw_liveliness_lost_status_t *>(event_info);
+        status->total_count = 0;
+        status->total_count_change = 0;
+        break;
+      }
+    case RMW_EVENT_OFFERED_DEADLINE_MISSED:
+      {
+        auto status = static_cast<rmw_offered_deadline_missed_status_t *>(event_info);
+        status->total_count = 0;
+        status->total_count_change = 0;
+        break;
+      }
+    case RMW_EVENT_MESSAGE_LOST:
+      {
+        auto status = static_cast<rmw_message_lost_status_t *>(event_info);
+        status->total_count = 0;
+        status->total_count_change = 0;
+        break;
+      }
+    case RMW_EVENT_REQUESTED_QOS_INCOMPATIBLE:
+    case RMW_EVENT_OFFERED_QOS_INCOMPATIBLE:
+      *static_cast<rmw_qos_incompatible_event_status_t *>(event_info) = events.incompatible_qos;
+      events.incompatible_qos.total_count_change = 0;
+      break;
+    case RMW_EVENT_SUBSCRIPTION_INCOMPATIBLE_TYPE:
+    case RMW_EVENT_PUBLISHER_INCOMPATIBLE_TYPE:
+      *static_cast<rmw_incompatible_type_status_t *>(event_info) = events.incompatible_type;
+      events.incompatible_type.total_count_change = 0;
+      break;
+    case RMW_EVENT_SUBSCRIPTION_MATCHED:
+    case RMW_EVENT_PUBLICATION_MATCHED:
+      *static_cast<rmw_matched_status_t *>(event_info) = events.matched;
+      events.matched.total_count_change = 0;
+      events.matched.current_count_change = 0;
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
+extern "C"
+{
+rmw_ret_t
+rmw_publisher_event_init(
+  rmw_event_t * rmw_event,
+  const rmw_publisher_t * publisher,
+  rmw_event_type_t event_type)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (!is_publisher_event(event_type)) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING("provided event_type %d is not supported", event_type);
+    return RMW_RET_UNSUPPORTED;
+  }
+  rmw_event->implementation_identifier = identifier;
+  rmw_event->data = &static_cast<Publisher *>(publisher->data)->events;
+  rmw_event->event_type = event_type;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_event_init(
+  rmw_event_t * rmw_event,
+  const rmw_subscription_t * subscription,
+  rmw_event_type_t event_type)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(rmw_event, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (!is_subscription_event(event_type)) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING("provided event_type %d is not supported", event_type);
+    return RMW_RET_UNSUPPORTED;
+  }
+  rmw_event->implementation_identifier = identifier;
+  rmw_event->data = &static_cast<Subscription *>(subscription->data)->events;
+  rmw_event->event_type = event_type;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_take_event(const rmw_event_t * event_handle, void * event_info, bool * taken)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(event_handle, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(event_info, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    event_handle, event_handle->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto events = static_cast<EventStatuses *>(event_handle->data);
+  const rmw_event_type_t event_type = event_handle->event_type;
+
+  std::lock_guard<std::mutex> lock(events->mutex);
+  take_status(*events, event_type, event_info);
+  events->unread[event_type].store(false);
+  *taken = true;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_event_set_callback(
+  rmw_event_t * event,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(event, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    event, event->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto events = static_cast<EventStatuses *>(event->data);
+  const rmw_event_type_t event_type = event->event_type;
+
+  std::lock_guard<std::mutex> lock(events->mutex);
+  events->callbacks[event_type] = callback;
+  events->user_data[event_type] = user_data;
+  // A change left unread beforehand is reported right away.
+  if (callback && events->unread[event_type].load()) {
+    callback(user_data, 1u);
+  }
+  return RMW_RET_OK;
+}
+}  // extern "C"
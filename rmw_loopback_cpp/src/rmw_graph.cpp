@@ -0,0 +1,653 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rcutils/allocator.h"
+#include "rcutils/strdup.h"
+#include "rcutils/types/string_array.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/get_node_info_and_types.h"
+#include "rmw/get_service_names_and_types.h"
+#include "rmw/get_topic_endpoint_info.h"
+#include "rmw/get_topic_names_and_types.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/names_and_types.h"
+#include "rmw/rmw.h"
+#include "rmw/sanity_checks.h"
+#include "rmw/topic_endpoint_info_array.h"
+#include "rmw/validate_full_topic_name.h"
+#include "rmw/validate_namespace.h"
+#include "rmw/validate_node_name.h"
+
+#include "./domain.hpp"
+
+using rmw_loopback_cpp::Client;
+using rmw_loopback_cpp::Domain;
+using rmw_loopback_cpp::Node;
+using rmw_loopback_cpp::Publisher;
+using rmw_loopback_cpp::Service;
+using rmw_loopback_cpp::ServiceTopic;
+using rmw_loopback_cpp::Subscription;
+using rmw_loopback_cpp::Topic;
+using rmw_loopback_cpp::identifier;
+
+// Names are not mangled by this implementation, so no_demangle has no effect.
+
+namespace
+{
+
+using NamesAndTypes = std::map<std::string, std::set<std::string>>;
+
+const std::string &
+get_type_name(const Publisher & publisher)
+{
+  return publisher.codec.type_name();
+}
+
+const std::string &
+get_type_name(const Subscription & subscription)
+{
+  return subscription.codec.type_name();
+}
+
+const std::string &
+get_type_name(const Service & service)
+{
+  return service.codecs.type_name;
+}
+
+const std::string &
+get_type_name(const Client & client)
+{
+  return client.codecs.type_name;
+}
+
+// Collect the names and types of one kind of entities of topics or services,
+// only those of the given node if any.
+// The domain mutex must be held.
+template<typename EntryT, typename EntityT>
+void
+collect(
+  const std::map<std::string, std::unique_ptr<EntryT>, std::less<>> & entries,
+  std::vector<EntityT *> EntryT::* entities,
+  const Node * node,
+  NamesAndTypes & names_and_types)
+{
+  for (const auto & [name, entry] : entries) {
+    std::shared_lock<std::shared_mutex> lock(entry->mutex);
+    for (const EntityT * entity : (*entry).*entities) {
+      if (!node || entity->node == node) {
+        names_and_types[name].insert(get_type_name(*entity));
+      }
+    }
+  }
+}
+
+// Count one kind of entities of a topic or service, without allocating.
+template<typename EntryT, typename EntityT>
+size_t
+count(
+  Domain & domain,
+  const std::map<std::string, std::unique_ptr<EntryT>, std::less<>> & entries,
+  std::vector<EntityT *> EntryT::* entities,
+  std::string_view name)
+{
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  auto it = entries.find(name);
+  if (entries.end() == it) {
+    return 0u;
+  }
+  std::shared_lock<std::shared_mutex> entry_lock(it->second->mutex);
+  return ((*it->second).*entities).size();
+}
+
+rmw_ret_t
+copy_names_and_types(
+  const NamesAndTypes & names_and_types,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * output)
+{
+  if (names_and_types.empty()) {
+    return RMW_RET_OK;
+  }
+  rmw_ret_t ret = rmw_names_and_types_init(output, names_and_types.size(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  size_t i = 0u;
+  for (const auto & [name, types] : names_and_types) {
+    output->names.data[i] = rcutils_strdup(name.c_str(), *allocator);
+    if (!output->names.data[i]) {
+      RMW_SET_ERROR_MSG("failed to copy name");
+      ret = RMW_RET_BAD_ALLOC;
+      break;
+    }
+    ret = rcutils_string_array_init(&output->types[i], types.size(), allocator);
+    if (RMW_RET_OK != ret) {
+      break;
+    }
+    size_t j = 0u;
+    for (const std::string & type : types) {
+      output->types[i].data[j] = rcutils_strdup(type.c_str(), *allocator);
+      if (!output->types[i].data[j]) {
+        RMW_SET_ERROR_MSG("failed to copy type name");
+        ret = RMW_RET_BAD_ALLOC;
+        break;
+      }
+      ++j;
+    }
+    if (RMW_RET_OK != ret) {
+      break;
+    }
+    ++i;
+  }
+  if (RMW_RET_OK != ret) {
+    static_cast<void>(rmw_names_and_types_fini(output));
+  }
+  return ret;
+}
+
+// Check the arguments common to queries by node.
+rmw_ret_t
+check_query_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_names_and_types_t * names_and_types)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator argument is invalid", return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_name, RMW_RET_INVALID_ARGUMENT);
+  int validation_result = RMW_NODE_NAME_VALID;
+  rmw_ret_t ret = rmw_validate_node_name(node_name, &validation_result, nullptr);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  if (RMW_NODE_NAME_VALID != validation_result) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "node_name argument is invalid: %s",
+      rmw_node_name_validation_result_string(validation_result));
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespace, RMW_RET_INVALID_ARGUMENT);
+  validation_result = RMW_NAMESPACE_VALID;
+  ret = rmw_validate_namespace(node_namespace, &validation_result, nullptr);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  if (RMW_NAMESPACE_VALID != validation_result) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "node_namespace argument is invalid: %s",
+      rmw_namespace_validation_result_string(validation_result));
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(names_and_types, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_names_and_types_check_zero(names_and_types)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  return RMW_RET_OK;
+}
+
+// Query names and types of one kind of entities of a node.
+template<typename EntryT, typename EntityT>
+rmw_ret_t
+get_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_names_and_types_t * names_and_types,
+  std::map<std::string, std::unique_ptr<EntryT>, std::less<>> Domain::* entries,
+  std::vector<EntityT *> EntryT::* entities)
+{
+  rmw_ret_t ret = check_query_by_node(
+    node, allocator, node_name, node_namespace, names_and_types);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  Domain & domain = rmw_loopback_cpp::get_domain(node);
+  NamesAndTypes collected;
+  try {
+    std::lock_guard<std::mutex> lock(domain.mutex);
+    const Node * target = domain.find_node(node_name, node_namespace);
+    if (!target) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "node '%s' in namespace '%s' does not exist", node_name, node_namespace);
+      return RMW_RET_NODE_NAME_NON_EXISTENT;
+    }
+    collect(domain.*entries, entities, target, collected);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate names and types");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return copy_names_and_types(collected, allocator, names_and_types);
+}
+
+rmw_ret_t
+validate_topic_name(const char * topic_name)
+{
+  int validation_result = RMW_TOPIC_VALID;
+  rmw_ret_t ret = rmw_validate_full_topic_name(topic_name, &validation_result, nullptr);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  if (RMW_TOPIC_VALID != validation_result) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "topic_name argument is invalid: %s",
+      rmw_full_topic_name_validation_result_string(validation_result));
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  return RMW_RET_OK;
+}
+
+// Count one kind of entities of a topic or service.
+template<typename EntryT, typename EntityT>
+rmw_ret_t
+count_by_name(
+  const rmw_node_t * node,
+  const char * name,
+  size_t * count_out,
+  std::map<std::string, std::unique_ptr<EntryT>, std::less<>> Domain::* entries,
+  std::vector<EntityT *> EntryT::* entities)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(name, RMW_RET_INVALID_ARGUMENT);
+  rmw_ret_t ret = validate_topic_name(name);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(count_out, RMW_RET_INVALID_ARGUMENT);
+  Domain & domain = rmw_loopback_cpp::get_domain(node);
+  *count_out = count(domain, domain.*entries, entities, name);
+  return RMW_RET_OK;
+}
+
+template<typename EntityT>
+rmw_ret_t
+fill_endpoint_info(
+  rmw_topic_endpoint_info_t * info,
+  const EntityT & entity,
+  rmw_endpoint_type_t endpoint_type,
+  rcutils_allocator_t * allocator)
+{
+  rmw_ret_t ret = rmw_topic_endpoint_info_set_node_name(
+    info, entity.node->name.c_str(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = rmw_topic_endpoint_info_set_node_namespace(
+    info, entity.node->namespace_.c_str(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = rmw_topic_endpoint_info_set_topic_type(
+    info, get_type_name(entity).c_str(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = rmw_topic_endpoint_info_set_endpoint_type(info, endpoint_type);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = rmw_topic_endpoint_info_set_gid(info, entity.gid.data(), entity.gid.size());
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  return rmw_topic_endpoint_info_set_qos_profile(info, &entity.qos);
+}
+
+// Query the endpoints of one kind of a topic.
+template<typename EntityT>
+rmw_ret_t
+get_info_by_topic(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * topic_name,
+  rmw_topic_endpoint_info_array_t * info_array,
+  std::vector<EntityT *> Topic::* entities,
+  rmw_endpoint_type_t endpoint_type)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator argument is invalid", return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(info_array, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_topic_endpoint_info_array_check_zero(info_array)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  Domain & domain = rmw_loopback_cpp::get_domain(node);
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  auto it = domain.topics.find(std::string_view(topic_name));
+  if (domain.topics.end() == it) {
+    return RMW_RET_OK;
+  }
+  std::shared_lock<std::shared_mutex> topic_lock(it->second->mutex);
+  const std::vector<EntityT *> & endpoints = (*it->second).*entities;
+  if (endpoints.empty()) {
+    return RMW_RET_OK;
+  }
+  rmw_ret_t ret = rmw_topic_endpoint_info_array_init_with_size(
+    info_array, endpoints.size(), allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    info_array->info_array[i] = rmw_get_zero_initialized_topic_endpoint_info();
+  }
+  for (size_t i = 0; i < endpoints.size(); ++i) {
+    ret = fill_endpoint_info(&info_array->info_array[i], *endpoints[i], endpoint_type, allocator);
+    if (RMW_RET_OK != ret) {
+      static_cast<void>(rmw_topic_endpoint_info_array_fini(info_array, allocator));
+      return ret;
+    }
+  }
+  return RMW_RET_OK;
+}
+
+// Get the names, namespaces and, if requested, enclaves of all nodes.
+rmw_ret_t
+get_node_names(
+  const rmw_node_t * node,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  rcutils_string_array_t * enclaves)
+{
+  Domain & domain = rmw_loopback_cpp::get_domain(node);
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  std::lock_guard<std::mutex> lock(domain.mutex);
+  const size_t size = domain.nodes.size();
+  rcutils_ret_t ret = rcutils_string_array_init(node_names, size, &allocator);
+  if (RCUTILS_RET_OK == ret) {
+    ret = rcutils_string_array_init(node_namespaces, size, &allocator);
+  }
+  if (RCUTILS_RET_OK == ret && enclaves) {
+    ret = rcutils_string_array_init(enclaves, size, &allocator);
+  }
+  for (size_t i = 0; RCUTILS_RET_OK == ret && i < size; ++i) {
+    const Node * entry = domain.nodes[i];
+    node_names->data[i] = rcutils_strdup(entry->name.c_str(), allocator);
+    node_namespaces->data[i] = rcutils_strdup(entry->namespace_.c_str(), allocator);
+    if (enclaves) {
+      enclaves->data[i] = rcutils_strdup(entry->enclave.c_str(), allocator);
+    }
+    if (!node_names->data[i] || !node_namespaces->data[i] || (enclaves && !enclaves->data[i])) {
+      ret = RCUTILS_RET_BAD_ALLOC;
+    }
+  }
+  if (RCUTILS_RET_OK != ret) {
+    RMW_SET_ERROR_MSG("failed to allocate node names");
+    static_cast<void>(rcutils_string_array_fini(node_names));
+    static_cast<void>(rcutils_string_array_fini(node_namespaces));
+    if (enclaves) {
+      static_cast<void>(rcutils_string_array_fini(enclaves));
+    }
+    return RMW_RET_BAD_ALLOC;
+  }
+  return RMW_RET_OK;
+}
+
+}  // namespace
+
+extern "C"
+{
+rmw_ret_t
+rmw_get_node_names(
+  const rmw_node_t * node,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_names, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_check_zero_rmw_string_array(node_names)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespaces, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_check_zero_rmw_string_array(node_namespaces)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  return get_node_names(node, node_names, node_namespaces, nullptr);
+}
+
+rmw_ret_t
+rmw_get_node_names_with_enclaves(
+  const rmw_node_t * node,
+  rcutils_string_array_t * node_names,
+  rcutils_string_array_t * node_namespaces,
+  rcutils_string_array_t * enclaves)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_names, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_check_zero_rmw_string_array(node_names)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(node_namespaces, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_check_zero_rmw_string_array(node_namespaces)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(enclaves, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_check_zero_rmw_string_array(enclaves)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  return get_node_names(node, node_names, node_namespaces, enclaves);
+}
+
+rmw_ret_t
+rmw_get_topic_names_and_types(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  bool no_demangle,
+  rmw_names_and_types_t * topic_names_and_types)
+{
+  static_cast<void>(no_demangle);
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator argument is invalid", return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_names_and_types, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_names_and_types_check_zero(topic_names_and_types)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  Domain & domain = rmw_loopback_cpp::get_domain(node);
+  NamesAndTypes collected;
+  try {
+    std::lock_guard<std::mutex> lock(domain.mutex);
+    collect(domain.topics, &Topic::publishers, nullptr, collected);
+    collect(domain.topics, &Topic::subscriptions, nullptr, collected);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate names and types");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return copy_names_and_types(collected, allocator, topic_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_service_names_and_types(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  rmw_names_and_types_t * service_names_and_types)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RCUTILS_CHECK_ALLOCATOR_WITH_MSG(
+    allocator, "allocator argument is invalid", return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(service_names_and_types, RMW_RET_INVALID_ARGUMENT);
+  if (RMW_RET_OK != rmw_names_and_types_check_zero(service_names_and_types)) {
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  Domain & domain = rmw_loopback_cpp::get_domain(node);
+  NamesAndTypes collected;
+  try {
+    std::lock_guard<std::mutex> lock(domain.mutex);
+    collect(domain.services, &ServiceTopic::services, nullptr, collected);
+    collect(domain.services, &ServiceTopic::clients, nullptr, collected);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate names and types");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return copy_names_and_types(collected, allocator, service_names_and_types);
+}
+
+rmw_ret_t
+rmw_get_publisher_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  bool no_demangle,
+  rmw_names_and_types_t * topic_names_and_types)
+{
+  static_cast<void>(no_demangle);
+  return get_names_and_types_by_node(
+    node, allocator, node_name, node_namespace, topic_names_and_types,
+    &Domain::topics, &Topic::publishers);
+}
+
+rmw_ret_t
+rmw_get_subscriber_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  bool no_demangle,
+  rmw_names_and_types_t * topic_names_and_types)
+{
+  static_cast<void>(no_demangle);
+  return get_names_and_types_by_node(
+    node, allocator, node_name, node_namespace, topic_names_and_types,
+    &Domain::topics, &Topic::subscriptions);
+}
+
+rmw_ret_t
+rmw_get_service_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_names_and_types_t * service_names_and_types)
+{
+  return get_names_and_types_by_node(
+    node, allocator, node_name, node_namespace, service_names_and_types,
+    &Domain::services, &ServiceTopic::services);
+}
+
+rmw_ret_t
+rmw_get_client_names_and_types_by_node(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * node_name,
+  const char * node_namespace,
+  rmw_names_and_types_t * service_names_and_types)
+{
+  return get_names_and_types_by_node(
+    node, allocator, node_name, node_namespace, service_names_and_types,
+    &Domain::services, &ServiceTopic::clients);
+}
+
+rmw_ret_t
+rmw_count_publishers(
+  const rmw_node_t * node,
+  const char * topic_name,
+  size_t * count)
+{
+  return count_by_name(node, topic_name, count, &Domain::topics, &Topic::publishers);
+}
+
+rmw_ret_t
+rmw_count_subscribers(
+  const rmw_node_t * node,
+  const char * topic_name,
+  size_t * count)
+{
+  return count_by_name(node, topic_name, count, &Domain::topics, &Topic::subscriptions);
+}
+
+rmw_ret_t
+rmw_count_clients(
+  const rmw_node_t * node,
+  const char * service_name,
+  size_t * count)
+{
+  return count_by_name(node, service_name, count, &Domain::services, &ServiceTopic::clients);
+}
+
+rmw_ret_t
+rmw_count_services(
+  const rmw_node_t * node,
+  const char * service_name,
+  size_t * count)
+{
+  return count_by_name(node, service_name, count, &Domain::services, &ServiceTopic::services);
+}
+
+rmw_ret_t
+rmw_get_publishers_info_by_topic(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * topic_name,
+  bool no_mangle,
+  rmw_topic_endpoint_info_array_t * publishers_info)
+{
+  static_cast<void>(no_mangle);
+  return get_info_by_topic(
+    node, allocator, topic_name, publishers_info, &Topic::publishers, RMW_ENDPOINT_PUBLISHER);
+}
+
+rmw_ret_t
+rmw_get_subscriptions_info_by_topic(
+  const rmw_node_t * node,
+  rcutils_allocator_t * allocator,
+  const char * topic_name,
+  bool no_mangle,
+  rmw_topic_endpoint_info_array_t * subscriptions_info)
+{
+  static_cast<void>(no_mangle);
+  return get_info_by_topic(
+    node, allocator, topic_name, subscriptions_info, &Topic::subscriptions,
+    RMW_ENDPOINT_SUBSCRIPTION);
+}
+}  // extern "C"
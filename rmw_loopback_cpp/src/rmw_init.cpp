@@ -0,0 +1,258 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <new>
+
+#include "rcutils/allocator.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/discovery_options.h"
+#include "rmw/domain_id.h"
+#include "rmw/error_handling.h"
+#include "rmw/features.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/init.h"
+#include "rmw/init_options.h"
+#include "rmw/rmw.h"
+#include "rmw/security_options.h"
+
+#include "./domain.hpp"
+
+using rmw_loopback_cpp::Context;
+using rmw_loopback_cpp::Domain;
+using rmw_loopback_cpp::identifier;
+
+extern "C"
+{
+const char *
+rmw_get_implementation_identifier()
+{
+  return identifier;
+}
+
+const char *
+rmw_get_serialization_format()
+{
+  return rmw_loopback_cpp::serialization_format;
+}
+
+rmw_ret_t
+rmw_init_options_init(rmw_init_options_t * init_options, rcutils_allocator_t allocator)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(init_options, RMW_RET_INVALID_ARGUMENT);
+  RCUTILS_CHECK_ALLOCATOR(&allocator, return RMW_RET_INVALID_ARGUMENT);
+  if (nullptr != init_options->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected zero-initialized init_options");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  rmw_init_options_t options = rmw_get_zero_initialized_init_options();
+  options.instance_id = 0;
+  options.implementation_identifier = identifier;
+  options.allocator = allocator;
+  options.impl = nullptr;
+  options.domain_id = RMW_DEFAULT_DOMAIN_ID;
+  options.enclave = nullptr;
+  options.security_options = rmw_get_zero_initialized_security_options();
+  options.discovery_options = rmw_get_zero_initialized_discovery_options();
+  rmw_ret_t ret = rmw_discovery_options_init(&options.discovery_options, 0u, &allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  *init_options = options;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_init_options_copy(const rmw_init_options_t * src, rmw_init_options_t * dst)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(src, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(dst, RMW_RET_INVALID_ARGUMENT);
+  if (nullptr == src->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected initialized src");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    src, src->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (nullptr != dst->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected zero-initialized dst");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  rcutils_allocator_t allocator_copy = src->allocator;
+  rcutils_allocator_t * allocator = &allocator_copy;
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RMW_RET_INVALID_ARGUMENT);
+
+  rmw_init_options_t options = *src;
+  options.enclave = rcutils_strdup(src->enclave, *allocator);
+  if (nullptr != src->enclave && nullptr == options.enclave) {
+    RMW_SET_ERROR_MSG("failed to copy enclave");
+    return RMW_RET_BAD_ALLOC;
+  }
+  options.security_options = rmw_get_zero_initialized_security_options();
+  rmw_ret_t ret = rmw_security_options_copy(
+    &src->security_options, allocator, &options.security_options);
+  if (RMW_RET_OK != ret) {
+    allocator->deallocate(options.enclave, allocator->state);
+    return ret;
+  }
+  options.discovery_options = rmw_get_zero_initialized_discovery_options();
+  ret = rmw_discovery_options_copy(
+    &src->discovery_options, allocator, &options.discovery_options);
+  if (RMW_RET_OK != ret) {
+    static_cast<void>(rmw_security_options_fini(&options.security_options, allocator));
+    allocator->deallocate(options.enclave, allocator->state);
+    return ret;
+  }
+  *dst = options;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_init_options_fini(rmw_init_options_t * init_options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(init_options, RMW_RET_INVALID_ARGUMENT);
+  if (nullptr == init_options->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected initialized init_options");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    init_options, init_options->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  rcutils_allocator_t * allocator = &init_options->allocator;
+  RCUTILS_CHECK_ALLOCATOR(allocator, return RMW_RET_INVALID_ARGUMENT);
+
+  allocator->deallocate(init_options->enclave, allocator->state);
+  rmw_ret_t ret = rmw_security_options_fini(&init_options->security_options, allocator);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  ret = rmw_discovery_options_fini(&init_options->discovery_options);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  *init_options = rmw_get_zero_initialized_init_options();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_init(const rmw_init_options_t * options, rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(options, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    options->implementation_identifier,
+    "expected initialized init options",
+    return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    options, options->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    options->enclave,
+    "expected non-null enclave",
+    return RMW_RET_INVALID_ARGUMENT);
+  if (nullptr != context->implementation_identifier) {
+    RMW_SET_ERROR_MSG("expected a zero-initialized context");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  const size_t domain_id =
+    RMW_DEFAULT_DOMAIN_ID == options->domain_id ? 0u : options->domain_id;
+  Context * impl = new (std::nothrow) Context;
+  if (!impl) {
+    RMW_SET_ERROR_MSG("failed to allocate context");
+    return RMW_RET_BAD_ALLOC;
+  }
+  try {
+    impl->domain = Domain::get(domain_id);
+  } catch (const std::bad_alloc &) {
+    delete impl;
+    RMW_SET_ERROR_MSG("failed to allocate domain");
+    return RMW_RET_BAD_ALLOC;
+  }
+
+  rmw_context_t initialized = rmw_get_zero_initialized_context();
+  initialized.instance_id = options->instance_id;
+  initialized.implementation_identifier = identifier;
+  initialized.actual_domain_id = domain_id;
+  initialized.options = rmw_get_zero_initialized_init_options();
+  rmw_ret_t ret = rmw_init_options_copy(options, &initialized.options);
+  if (RMW_RET_OK != ret) {
+    delete impl;
+    return ret;
+  }
+  initialized.impl = reinterpret_cast<rmw_context_impl_t *>(impl);
+  *context = initialized;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_shutdown(rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    context->impl,
+    "expected initialized context",
+    return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    context, context->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  reinterpret_cast<Context *>(context->impl)->is_shutdown.store(true);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_context_fini(rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    context->impl,
+    "expected initialized context",
+    return RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    context, context->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  Context * impl = reinterpret_cast<Context *>(context->impl);
+  if (!impl->is_shutdown.load()) {
+    RMW_SET_ERROR_MSG("context has not been shutdown");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  rmw_ret_t ret = rmw_init_options_fini(&context->options);
+  if (RMW_RET_OK != ret) {
+    return ret;
+  }
+  delete impl;
+  *context = rmw_get_zero_initialized_context();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_set_log_severity(rmw_log_severity_t severity)
+{
+  // Nothing is logged by this implementation.
+  static_cast<void>(severity);
+  return RMW_RET_OK;
+}
+
+bool
+rmw_feature_supported(rmw_feature_t feature)
+{
+  switch (feature) {
+    case RMW_FEATURE_MESSAGE_INFO_PUBLICATION_SEQUENCE_NUMBER:
+    case RMW_FEATURE_MESSAGE_INFO_RECEPTION_SEQUENCE_NUMBER:
+      return true;
+    default:
+      return false;
+  }
+}
+}  // extern "C"
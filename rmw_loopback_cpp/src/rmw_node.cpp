@@ -0,0 +1,133 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "rmw/error_handling.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+#include "rmw/validate_namespace.h"
+#include "rmw/validate_node_name.h"
+
+#include "./domain.hpp"
+
+using rmw_loopback_cpp::Context;
+using rmw_loopback_cpp::Domain;
+using rmw_loopback_cpp::Node;
+using rmw_loopback_cpp::identifier;
+
+extern "C"
+{
+rmw_node_t *
+rmw_create_node(rmw_context_t * context, const char * name, const char * namespace_)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    context->implementation_identifier,
+    "expected initialized context",
+    return nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    context, context->implementation_identifier, identifier,
+    return nullptr);
+  RMW_CHECK_FOR_NULL_WITH_MSG(
+    context->impl,
+    "expected initialized context",
+    return nullptr);
+  Context * context_impl = reinterpret_cast<Context *>(context->impl);
+  if (context_impl->is_shutdown.load()) {
+    RMW_SET_ERROR_MSG("context has been shutdown");
+    return nullptr;
+  }
+
+  RMW_CHECK_ARGUMENT_FOR_NULL(name, nullptr);
+  int validation_result = RMW_NODE_NAME_VALID;
+  rmw_ret_t ret = rmw_validate_node_name(name, &validation_result, nullptr);
+  if (RMW_RET_OK != ret) {
+    return nullptr;
+  }
+  if (RMW_NODE_NAME_VALID != validation_result) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "invalid node name: %s", rmw_node_name_validation_result_string(validation_result));
+    return nullptr;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(namespace_, nullptr);
+  validation_result = RMW_NAMESPACE_VALID;
+  ret = rmw_validate_namespace(namespace_, &validation_result, nullptr);
+  if (RMW_RET_OK != ret) {
+    return nullptr;
+  }
+  if (RMW_NAMESPACE_VALID != validation_result) {
+    RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+      "invalid node namespace: %s", rmw_namespace_validation_result_string(validation_result));
+    return nullptr;
+  }
+
+  std::unique_ptr<Node> node;
+  Domain & domain = *context_impl->domain;
+  try {
+    node = std::make_unique<Node>();
+    node->name = name;
+    node->namespace_ = namespace_;
+    node->enclave = context->options.enclave ? context->options.enclave : "";
+    node->context = context_impl;
+    node->graph_guard_condition.handle.implementation_identifier = identifier;
+    node->graph_guard_condition.handle.data = &node->graph_guard_condition;
+    node->graph_guard_condition.handle.context = context;
+    node->handle.implementation_identifier = identifier;
+    node->handle.data = node.get();
+    node->handle.name = node->name.c_str();
+    node->handle.namespace_ = node->namespace_.c_str();
+    node->handle.context = context;
+
+    std::lock_guard<std::mutex> lock(domain.mutex);
+    domain.nodes.push_back(node.get());
+    domain.notify_graph_change();
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate node");
+    return nullptr;
+  }
+  return &node.release()->handle;
+}
+
+rmw_ret_t
+rmw_destroy_node(rmw_node_t * node)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  Node * impl = static_cast<Node *>(node->data);
+  Domain & domain = *impl->context->domain;
+  {
+    std::lock_guard<std::mutex> lock(domain.mutex);
+    domain.nodes.erase(std::find(domain.nodes.begin(), domain.nodes.end(), impl));
+    domain.notify_graph_change();
+  }
+  delete impl;
+  return RMW_RET_OK;
+}
+
+const rmw_guard_condition_t *
+rmw_node_get_graph_guard_condition(const rmw_node_t * node)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return nullptr);
+  return &static_cast<Node *>(node->data)->graph_guard_condition.handle;
+}
+}  // extern "C"
@@ -0,0 +1,323 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "rmw/error_handling.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+#include "rmw/validate_full_topic_name.h"
+
+#include "./domain.hpp"
+#include "./qos.hpp"
+
+using rmw_loopback_cpp::Gid;
+using rmw_loopback_cpp::Publisher;
+using rmw_loopback_cpp::identifier;
+
+extern "C"
+{
+rmw_ret_t
+rmw_init_publisher_allocation(
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  rmw_publisher_allocation_t * allocation)
+{
+  static_cast<void>(type_support);
+  static_cast<void>(message_bounds);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_init_publisher_allocation is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_fini_publisher_allocation(rmw_publisher_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_fini_publisher_allocation is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_publisher_t *
+rmw_create_publisher(
+  const rmw_node_t * node,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_profile,
+  const rmw_publisher_options_t * publisher_options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, nullptr);
+  if (0 == strlen(topic_name)) {
+    RMW_SET_ERROR_MSG("topic_name argument is an empty string");
+    return nullptr;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_profile, nullptr);
+  if (!qos_profile->avoid_ros_namespace_conventions) {
+    int validation_result = RMW_TOPIC_VALID;
+    rmw_ret_t ret = rmw_validate_full_topic_name(topic_name, &validation_result, nullptr);
+    if (RMW_RET_OK != ret) {
+      return nullptr;
+    }
+    if (RMW_TOPIC_VALID != validation_result) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "invalid topic name: %s", rmw_full_topic_name_validation_result_string(validation_result));
+      return nullptr;
+    }
+  }
+  if (rmw_loopback_cpp::has_unknown_policy(*qos_profile)) {
+    RMW_SET_ERROR_MSG("qos_profile has unknown policies");
+    return nullptr;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher_options, nullptr);
+
+  auto node_impl = static_cast<rmw_loopback_cpp::Node *>(node->data);
+  std::unique_ptr<Publisher> publisher;
+  try {
+    publisher = std::make_unique<Publisher>(type_support);
+    publisher->topic_name = topic_name;
+  } catch (const std::invalid_argument & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate publisher");
+    return nullptr;
+  }
+  publisher->node = node_impl;
+  publisher->topic = nullptr;
+  publisher->qos = rmw_loopback_cpp::resolve_qos(*qos_profile);
+  publisher->gid = rmw_loopback_cpp::make_gid();
+  publisher->handle.implementation_identifier = identifier;
+  publisher->handle.data = publisher.get();
+  publisher->handle.topic_name = publisher->topic_name.c_str();
+  publisher->handle.options = *publisher_options;
+  publisher->handle.can_loan_messages = false;
+
+  try {
+    rmw_loopback_cpp::add_publisher(rmw_loopback_cpp::get_domain(node), *publisher);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to add publisher to its topic");
+    return nullptr;
+  }
+  return &publisher.release()->handle;
+}
+
+rmw_ret_t
+rmw_destroy_publisher(rmw_node_t * node, rmw_publisher_t * publisher)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Publisher *>(publisher->data);
+  rmw_loopback_cpp::remove_publisher(rmw_loopback_cpp::get_domain(node), *impl);
+  delete impl;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_borrow_loaned_message(
+  const rmw_publisher_t * publisher,
+  const rosidl_message_type_support_t * type_support,
+  void ** ros_message)
+{
+  static_cast<void>(publisher);
+  static_cast<void>(type_support);
+  static_cast<void>(ros_message);
+  RMW_SET_ERROR_MSG("rmw_borrow_loaned_message is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_return_loaned_message_from_publisher(const rmw_publisher_t * publisher, void * loaned_message)
+{
+  static_cast<void>(publisher);
+  static_cast<void>(loaned_message);
+  RMW_SET_ERROR_MSG("rmw_return_loaned_message_from_publisher is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_publish(
+  const rmw_publisher_t * publisher,
+  const void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Publisher *>(publisher->data);
+  if (
+    0u == impl->matched_count.load() &&
+    RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL != impl->qos.durability)
+  {
+    // Nobody to deliver to, nor anything to keep, so skip encoding.
+    ++impl->sequence_number;
+    return RMW_RET_OK;
+  }
+  // Encoding buffers are kept per thread, so that they grow only once.
+  thread_local std::vector<uint8_t> buffer;
+  try {
+    impl->codec.serialize(ros_message, buffer);
+    rmw_loopback_cpp::publish_payload(*impl, buffer.data(), buffer.size());
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate memory to publish message");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publish_loaned_message(
+  const rmw_publisher_t * publisher,
+  void * ros_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  static_cast<void>(publisher);
+  static_cast<void>(ros_message);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_publish_loaned_message is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_publish_serialized_message(
+  const rmw_publisher_t * publisher,
+  const rmw_serialized_message_t * serialized_message,
+  rmw_publisher_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Publisher *>(publisher->data);
+  try {
+    rmw_loopback_cpp::publish_payload(
+      *impl, serialized_message->buffer, serialized_message->buffer_length);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate memory to publish message");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_count_matched_subscriptions(
+  const rmw_publisher_t * publisher,
+  size_t * subscription_count)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription_count, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *subscription_count = static_cast<Publisher *>(publisher->data)->matched_count.load();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_get_actual_qos(const rmw_publisher_t * publisher, rmw_qos_profile_t * qos)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *qos = static_cast<Publisher *>(publisher->data)->qos;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_assert_liveliness(const rmw_publisher_t * publisher)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  // Publishers stay alive for as long as they exist.
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_wait_for_all_acked(const rmw_publisher_t * publisher, rmw_time_t wait_timeout)
+{
+  static_cast<void>(wait_timeout);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  // Messages are delivered before rmw_publish() returns.
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_get_gid_for_publisher(const rmw_publisher_t * publisher, rmw_gid_t * gid)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    publisher, publisher->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  const Gid & publisher_gid = static_cast<Publisher *>(publisher->data)->gid;
+  gid->implementation_identifier = identifier;
+  std::memcpy(gid->data, publisher_gid.data(), publisher_gid.size());
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_compare_gids_equal(const rmw_gid_t * gid1, const rmw_gid_t * gid2, bool * result)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid1, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(gid2, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(result, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    gid1, gid1->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    gid2, gid2->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *result = 0 == std::memcmp(gid1->data, gid2->data, RMW_GID_STORAGE_SIZE);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_publisher_get_network_flow_endpoints(
+  const rmw_publisher_t * publisher,
+  rcutils_allocator_t * allocator,
+  rmw_network_flow_endpoint_array_t * network_flow_endpoint_array)
+{
+  static_cast<void>(publisher);
+  static_cast<void>(allocator);
+  static_cast<void>(network_flow_endpoint_array);
+  RMW_SET_ERROR_MSG("messages do not leave the process, so there are no network flows");
+  return RMW_RET_UNSUPPORTED;
+}
+}  // extern "C"
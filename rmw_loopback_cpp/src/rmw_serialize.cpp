@@ -0,0 +1,114 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "rmw/dynamic_message_type_support.h"
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/serialized_message.h"
+
+#include "./cdr.hpp"
+
+using rmw_loopback_cpp::MessageCodec;
+
+extern "C"
+{
+rmw_ret_t
+rmw_serialize(
+  const void * ros_message,
+  const rosidl_message_type_support_t * type_support,
+  rmw_serialized_message_t * serialized_message)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
+  thread_local std::vector<uint8_t> buffer;
+  try {
+    MessageCodec codec(type_support);
+    codec.serialize(ros_message, buffer);
+  } catch (const std::invalid_argument & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return RMW_RET_ERROR;
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate memory to serialize message");
+    return RMW_RET_BAD_ALLOC;
+  }
+  if (serialized_message->buffer_capacity < buffer.size()) {
+    rmw_ret_t ret = rmw_serialized_message_resize(serialized_message, buffer.size());
+    if (RMW_RET_OK != ret) {
+      return ret;
+    }
+  }
+  std::memcpy(serialized_message->buffer, buffer.data(), buffer.size());
+  serialized_message->buffer_length = buffer.size();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_deserialize(
+  const rmw_serialized_message_t * serialized_message,
+  const rosidl_message_type_support_t * type_support,
+  void * ros_message)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  try {
+    MessageCodec codec(type_support);
+    if (!codec.deserialize(
+        serialized_message->buffer, serialized_message->buffer_length, ros_message))
+    {
+      RMW_SET_ERROR_MSG("failed to deserialize message");
+      return RMW_RET_ERROR;
+    }
+  } catch (const std::invalid_argument & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return RMW_RET_ERROR;
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate memory to deserialize message");
+    return RMW_RET_BAD_ALLOC;
+  }
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_get_serialized_message_size(
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  size_t * size)
+{
+  static_cast<void>(type_support);
+  static_cast<void>(message_bounds);
+  static_cast<void>(size);
+  RMW_SET_ERROR_MSG("rmw_get_serialized_message_size is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_serialization_support_init(
+  const char * serialization_lib_name,
+  rcutils_allocator_t * allocator,
+  rosidl_dynamic_typesupport_serialization_support_t * serialization_support)
+{
+  static_cast<void>(serialization_lib_name);
+  static_cast<void>(allocator);
+  static_cast<void>(serialization_support);
+  RMW_SET_ERROR_MSG("dynamic type support is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+}  // extern "C"
@@ -0,0 +1,514 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+#include "rmw/error_handling.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+#include "rmw/validate_full_topic_name.h"
+
+#include "./domain.hpp"
+#include "./qos.hpp"
+
+using rmw_loopback_cpp::Sample;
+using rmw_loopback_cpp::Subscription;
+using rmw_loopback_cpp::identifier;
+
+namespace
+{
+
+void
+fill_message_info(Subscription & subscription, const Sample & sample, rmw_message_info_t * info)
+{
+  info->source_timestamp = sample.source_timestamp;
+  info->received_timestamp = sample.received_timestamp;
+  info->publication_sequence_number = static_cast<uint64_t>(sample.sequence_number);
+  info->reception_sequence_number = ++subscription.reception_sequence_number;
+  info->publisher_gid.implementation_identifier = identifier;
+  std::memcpy(info->publisher_gid.data, sample.writer_gid.data(), sample.writer_gid.size());
+  info->from_intra_process = false;
+}
+
+// Pop the oldest sample and have `consume` read it in place, skipping samples
+// that could not be copied upon delivery.
+// `consume` must not throw, as the sample is released once it returns.
+template<typename ConsumeT>
+rmw_ret_t
+take_sample(Subscription & subscription, bool * taken, ConsumeT && consume)
+{
+  *taken = false;
+  for (;;) {
+    bool is_empty = false;
+    rmw_ret_t ret = RMW_RET_OK;
+    const bool popped = subscription.queue.samples.try_pop(
+      [&](Sample & sample) {
+        is_empty = sample.payload.empty();
+        if (!is_empty) {
+          ret = consume(sample);
+        }
+      });
+    if (!popped) {
+      return RMW_RET_OK;
+    }
+    if (!is_empty) {
+      *taken = RMW_RET_OK == ret;
+      return ret;
+    }
+  }
+}
+
+rmw_ret_t
+take_message(
+  Subscription & subscription, void * ros_message, bool * taken, rmw_message_info_t * info)
+{
+  return take_sample(
+    subscription, taken, [&](const Sample & sample) {
+      try {
+        if (!subscription.codec.deserialize(
+          sample.payload.data(), sample.payload.size(), ros_message))
+        {
+          RMW_SET_ERROR_MSG("failed to deserialize message");
+          return RMW_RET_ERROR;
+        }
+      } catch (const std::bad_alloc &) {
+        RMW_SET_ERROR_MSG("failed to allocate memory to deserialize message");
+        return RMW_RET_BAD_ALLOC;
+      }
+      if (info) {
+        fill_message_info(subscription, sample, info);
+      }
+      return RMW_RET_OK;
+    });
+}
+
+rmw_ret_t
+take_serialized_message(
+  Subscription & subscription, rmw_serialized_message_t * serialized_message, bool * taken,
+  rmw_message_info_t * info)
+{
+  return take_sample(
+    subscription, taken, [&](const Sample & sample) {
+      if (serialized_message->buffer_capacity < sample.payload.size()) {
+        rmw_ret_t ret = rmw_serialized_message_resize(serialized_message, sample.payload.size());
+        if (RMW_RET_OK != ret) {
+          return ret;
+        }
+      }
+      std::memcpy(serialized_message->buffer, sample.payload.data(), sample.payload.size());
+      serialized_message->buffer_length = sample.payload.size();
+      if (info) {
+        fill_message_info(subscription, sample, info);
+      }
+      return RMW_RET_OK;
+    });
+}
+
+}  // namespace
+
+extern "C"
+{
+rmw_ret_t
+rmw_init_subscription_allocation(
+  const rosidl_message_type_support_t * type_support,
+  const rosidl_runtime_c__Sequence__bound * message_bounds,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(type_support);
+  static_cast<void>(message_bounds);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_init_subscription_allocation is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_fini_subscription_allocation(rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_fini_subscription_allocation is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_subscription_t *
+rmw_create_subscription(
+  const rmw_node_t * node,
+  const rosidl_message_type_support_t * type_support,
+  const char * topic_name,
+  const rmw_qos_profile_t * qos_profile,
+  const rmw_subscription_options_t * subscription_options)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(type_support, nullptr);
+  RMW_CHECK_ARGUMENT_FOR_NULL(topic_name, nullptr);
+  if (0 == strlen(topic_name)) {
+    RMW_SET_ERROR_MSG("topic_name argument is an empty string");
+    return nullptr;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos_profile, nullptr);
+  if (!qos_profile->avoid_ros_namespace_conventions) {
+    int validation_result = RMW_TOPIC_VALID;
+    rmw_ret_t ret = rmw_validate_full_topic_name(topic_name, &validation_result, nullptr);
+    if (RMW_RET_OK != ret) {
+      return nullptr;
+    }
+    if (RMW_TOPIC_VALID != validation_result) {
+      RMW_SET_ERROR_MSG_WITH_FORMAT_STRING(
+        "invalid topic name: %s", rmw_full_topic_name_validation_result_string(validation_result));
+      return nullptr;
+    }
+  }
+  if (rmw_loopback_cpp::has_unknown_policy(*qos_profile)) {
+    RMW_SET_ERROR_MSG("qos_profile has unknown policies");
+    return nullptr;
+  }
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription_options, nullptr);
+
+  auto node_impl = static_cast<rmw_loopback_cpp::Node *>(node->data);
+  // Policies are resolved anew against publishers once on the topic, but
+  // history and depth never depend on them.
+  const rmw_qos_profile_t qos = rmw_loopback_cpp::resolve_qos(*qos_profile);
+  std::unique_ptr<Subscription> subscription;
+  try {
+    subscription = std::make_unique<Subscription>(
+      type_support, rmw_loopback_cpp::get_queue_depth(qos));
+    subscription->topic_name = topic_name;
+  } catch (const std::invalid_argument & e) {
+    RMW_SET_ERROR_MSG(e.what());
+    return nullptr;
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to allocate subscription");
+    return nullptr;
+  }
+  subscription->node = node_impl;
+  subscription->topic = nullptr;
+  subscription->qos = *qos_profile;
+  subscription->ignore_local_publications = subscription_options->ignore_local_publications;
+  subscription->gid = rmw_loopback_cpp::make_gid();
+  subscription->handle.implementation_identifier = identifier;
+  subscription->handle.data = subscription.get();
+  subscription->handle.topic_name = subscription->topic_name.c_str();
+  subscription->handle.options = *subscription_options;
+  // Content filters are not supported, nor kept past this call.
+  subscription->handle.options.content_filter_options = nullptr;
+  subscription->handle.can_loan_messages = false;
+  subscription->handle.is_cft_enabled = false;
+
+  try {
+    rmw_loopback_cpp::add_subscription(rmw_loopback_cpp::get_domain(node), *subscription);
+  } catch (const std::bad_alloc &) {
+    RMW_SET_ERROR_MSG("failed to add subscription to its topic");
+    return nullptr;
+  }
+  return &subscription.release()->handle;
+}
+
+rmw_ret_t
+rmw_destroy_subscription(rmw_node_t * node, rmw_subscription_t * subscription)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(node, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    node, node->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  auto impl = static_cast<Subscription *>(subscription->data);
+  rmw_loopback_cpp::remove_subscription(rmw_loopback_cpp::get_domain(node), *impl);
+  delete impl;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_count_matched_publishers(
+  const rmw_subscription_t * subscription,
+  size_t * publisher_count)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(publisher_count, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *publisher_count = static_cast<Subscription *>(subscription->data)->matched_count.load();
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_get_actual_qos(const rmw_subscription_t * subscription, rmw_qos_profile_t * qos)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(qos, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  *qos = static_cast<Subscription *>(subscription->data)->qos;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_set_content_filter(
+  rmw_subscription_t * subscription,
+  const rmw_subscription_content_filter_options_t * options)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(options);
+  RMW_SET_ERROR_MSG("rmw_subscription_set_content_filter is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_subscription_get_content_filter(
+  const rmw_subscription_t * subscription,
+  rcutils_allocator_t * allocator,
+  rmw_subscription_content_filter_options_t * options)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(allocator);
+  static_cast<void>(options);
+  RMW_SET_ERROR_MSG("rmw_subscription_get_content_filter is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_take(
+  const rmw_subscription_t * subscription,
+  void * ros_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return take_message(
+    *static_cast<Subscription *>(subscription->data), ros_message, taken, nullptr);
+}
+
+rmw_ret_t
+rmw_take_with_info(
+  const rmw_subscription_t * subscription,
+  void * ros_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(ros_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return take_message(
+    *static_cast<Subscription *>(subscription->data), ros_message, taken, message_info);
+}
+
+rmw_ret_t
+rmw_take_sequence(
+  const rmw_subscription_t * subscription,
+  size_t count,
+  rmw_message_sequence_t * message_sequence,
+  rmw_message_info_sequence_t * message_info_sequence,
+  size_t * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_sequence, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_info_sequence, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  if (0u == count) {
+    RMW_SET_ERROR_MSG("count cannot be 0");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (count > message_sequence->capacity) {
+    RMW_SET_ERROR_MSG("insufficient capacity in message_sequence");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+  if (count > message_info_sequence->capacity) {
+    RMW_SET_ERROR_MSG("insufficient capacity in message_info_sequence");
+    return RMW_RET_INVALID_ARGUMENT;
+  }
+
+  auto impl = static_cast<Subscription *>(subscription->data);
+  *taken = 0u;
+  rmw_ret_t ret = RMW_RET_OK;
+  while (*taken < count) {
+    bool taken_one = false;
+    ret = take_message(
+      *impl, message_sequence->data[*taken], &taken_one,
+      &message_info_sequence->data[*taken]);
+    if (RMW_RET_OK != ret || !taken_one) {
+      break;
+    }
+    ++*taken;
+  }
+  message_sequence->size = *taken;
+  message_info_sequence->size = *taken;
+  return ret;
+}
+
+rmw_ret_t
+rmw_take_serialized_message(
+  const rmw_subscription_t * subscription,
+  rmw_serialized_message_t * serialized_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return take_serialized_message(
+    *static_cast<Subscription *>(subscription->data), serialized_message, taken, nullptr);
+}
+
+rmw_ret_t
+rmw_take_serialized_message_with_info(
+  const rmw_subscription_t * subscription,
+  rmw_serialized_message_t * serialized_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(allocation);
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(serialized_message, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(taken, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_ARGUMENT_FOR_NULL(message_info, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  return take_serialized_message(
+    *static_cast<Subscription *>(subscription->data), serialized_message, taken, message_info);
+}
+
+rmw_ret_t
+rmw_take_loaned_message(
+  const rmw_subscription_t * subscription,
+  void ** loaned_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(loaned_message);
+  static_cast<void>(taken);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_take_loaned_message is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_take_loaned_message_with_info(
+  const rmw_subscription_t * subscription,
+  void ** loaned_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(loaned_message);
+  static_cast<void>(taken);
+  static_cast<void>(message_info);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_take_loaned_message_with_info is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_return_loaned_message_from_subscription(
+  const rmw_subscription_t * subscription,
+  void * loaned_message)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(loaned_message);
+  RMW_SET_ERROR_MSG("rmw_return_loaned_message_from_subscription is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_take_dynamic_message(
+  const rmw_subscription_t * subscription,
+  rosidl_dynamic_typesupport_dynamic_data_t * dynamic_message,
+  bool * taken,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(dynamic_message);
+  static_cast<void>(taken);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_take_dynamic_message is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_take_dynamic_message_with_info(
+  const rmw_subscription_t * subscription,
+  rosidl_dynamic_typesupport_dynamic_data_t * dynamic_message,
+  bool * taken,
+  rmw_message_info_t * message_info,
+  rmw_subscription_allocation_t * allocation)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(dynamic_message);
+  static_cast<void>(taken);
+  static_cast<void>(message_info);
+  static_cast<void>(allocation);
+  RMW_SET_ERROR_MSG("rmw_take_dynamic_message_with_info is not supported");
+  return RMW_RET_UNSUPPORTED;
+}
+
+rmw_ret_t
+rmw_subscription_set_on_new_message_callback(
+  rmw_subscription_t * subscription,
+  rmw_event_callback_t callback,
+  const void * user_data)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(subscription, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    subscription, subscription->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  static_cast<Subscription *>(subscription->data)->queue.set_callback(callback, user_data);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_subscription_get_network_flow_endpoints(
+  const rmw_subscription_t * subscription,
+  rcutils_allocator_t * allocator,
+  rmw_network_flow_endpoint_array_t * network_flow_endpoint_array)
+{
+  static_cast<void>(subscription);
+  static_cast<void>(allocator);
+  static_cast<void>(network_flow_endpoint_array);
+  RMW_SET_ERROR_MSG("messages do not leave the process, so there are no network flows");
+  return RMW_RET_UNSUPPORTED;
+}
+}  // extern "C"
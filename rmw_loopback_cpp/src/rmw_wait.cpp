@@ -0,0 +1,264 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <new>
+
+#include "rmw/error_handling.h"
+#include "rmw/impl/cpp/macros.hpp"
+#include "rmw/rmw.h"
+
+#include "./domain.hpp"
+
+using rmw_loopback_cpp::Client;
+using rmw_loopback_cpp::EventStatuses;
+using rmw_loopback_cpp::GuardCondition;
+using rmw_loopback_cpp::Notifier;
+using rmw_loopback_cpp::Service;
+using rmw_loopback_cpp::Subscription;
+using rmw_loopback_cpp::identifier;
+
+namespace
+{
+
+bool
+is_ready(const rmw_event_t * event)
+{
+  if (event->event_type >= RMW_EVENT_INVALID) {
+    return false;
+  }
+  return static_cast<const EventStatuses *>(event->data)->unread[event->event_type].load();
+}
+
+// Tell whether anything is ready, without consuming guard conditions.
+bool
+any_ready(
+  const rmw_subscriptions_t * subscriptions,
+  const rmw_guard_conditions_t * guard_conditions,
+  const rmw_services_t * services,
+  const rmw_clients_t * clients,
+  const rmw_events_t * events)
+{
+  if (subscriptions) {
+    for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
+      if (!static_cast<Subscription *>(subscriptions->subscribers[i])->queue.samples.empty()) {
+        return true;
+      }
+    }
+  }
+  if (guard_conditions) {
+    for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
+      if (static_cast<GuardCondition *>(guard_conditions->guard_conditions[i])->triggered.load()) {
+        return true;
+      }
+    }
+  }
+  if (services) {
+    for (size_t i = 0; i < services->service_count; ++i) {
+      if (!static_cast<Service *>(services->services[i])->requests.samples.empty()) {
+        return true;
+      }
+    }
+  }
+  if (clients) {
+    for (size_t i = 0; i < clients->client_count; ++i) {
+      if (!static_cast<Client *>(clients->clients[i])->responses.samples.empty()) {
+        return true;
+      }
+    }
+  }
+  if (events) {
+    for (size_t i = 0; i < events->event_count; ++i) {
+      if (is_ready(static_cast<const rmw_event_t *>(events->events[i]))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Clear the entries that are not ready, consuming triggered guard conditions,
+// and tell whether any entry is left.
+bool
+clear_not_ready(
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  rmw_events_t * events)
+{
+  bool ready = false;
+  if (subscriptions) {
+    for (size_t i = 0; i < subscriptions->subscriber_count; ++i) {
+      if (static_cast<Subscription *>(subscriptions->subscribers[i])->queue.samples.empty()) {
+        subscriptions->subscribers[i] = nullptr;
+      } else {
+        ready = true;
+      }
+    }
+  }
+  if (guard_conditions) {
+    for (size_t i = 0; i < guard_conditions->guard_condition_count; ++i) {
+      auto guard_condition = static_cast<GuardCondition *>(guard_conditions->guard_conditions[i]);
+      if (guard_condition->triggered.exchange(false)) {
+        ready = true;
+      } else {
+        guard_conditions->guard_conditions[i] = nullptr;
+      }
+    }
+  }
+  if (services) {
+    for (size_t i = 0; i < services->service_count; ++i) {
+      if (static_cast<Service *>(services->services[i])->requests.samples.empty()) {
+        services->services[i] = nullptr;
+      } else {
+        ready = true;
+      }
+    }
+  }
+  if (clients) {
+    for (size_t i = 0; i < clients->client_count; ++i) {
+      if (static_cast<Client *>(clients->clients[i])->responses.samples.empty()) {
+        clients->clients[i] = nullptr;
+      } else {
+        ready = true;
+      }
+    }
+  }
+  if (events) {
+    for (size_t i = 0; i < events->event_count; ++i) {
+      if (is_ready(static_cast<const rmw_event_t *>(events->events[i]))) {
+        ready = true;
+      } else {
+        events->events[i] = nullptr;
+      }
+    }
+  }
+  return ready;
+}
+
+}  // namespace
+
+extern "C"
+{
+rmw_guard_condition_t *
+rmw_create_guard_condition(rmw_context_t * context)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    context, context->implementation_identifier, identifier,
+    return nullptr);
+  auto guard_condition = new (std::nothrow) GuardCondition;
+  if (!guard_condition) {
+    RMW_SET_ERROR_MSG("failed to allocate guard condition");
+    return nullptr;
+  }
+  guard_condition->handle.implementation_identifier = identifier;
+  guard_condition->handle.data = guard_condition;
+  guard_condition->handle.context = context;
+  return &guard_condition->handle;
+}
+
+rmw_ret_t
+rmw_destroy_guard_condition(rmw_guard_condition_t * guard_condition)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(guard_condition, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    guard_condition, guard_condition->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  delete static_cast<GuardCondition *>(guard_condition->data);
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_trigger_guard_condition(const rmw_guard_condition_t * guard_condition)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(guard_condition, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    guard_condition, guard_condition->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  static_cast<GuardCondition *>(guard_condition->data)->trigger();
+  return RMW_RET_OK;
+}
+
+rmw_wait_set_t *
+rmw_create_wait_set(rmw_context_t * context, size_t max_conditions)
+{
+  // Wait sets keep no state: rmw_wait() scans what it is given.
+  static_cast<void>(max_conditions);
+  RMW_CHECK_ARGUMENT_FOR_NULL(context, nullptr);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    context, context->implementation_identifier, identifier,
+    return nullptr);
+  auto wait_set = new (std::nothrow) rmw_wait_set_t;
+  if (!wait_set) {
+    RMW_SET_ERROR_MSG("failed to allocate wait set");
+    return nullptr;
+  }
+  wait_set->implementation_identifier = identifier;
+  wait_set->guard_conditions = nullptr;
+  wait_set->data = nullptr;
+  return wait_set;
+}
+
+rmw_ret_t
+rmw_destroy_wait_set(rmw_wait_set_t * wait_set)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    wait_set, wait_set->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+  delete wait_set;
+  return RMW_RET_OK;
+}
+
+rmw_ret_t
+rmw_wait(
+  rmw_subscriptions_t * subscriptions,
+  rmw_guard_conditions_t * guard_conditions,
+  rmw_services_t * services,
+  rmw_clients_t * clients,
+  rmw_events_t * events,
+  rmw_wait_set_t * wait_set,
+  const rmw_time_t * wait_timeout)
+{
+  RMW_CHECK_ARGUMENT_FOR_NULL(wait_set, RMW_RET_INVALID_ARGUMENT);
+  RMW_CHECK_TYPE_IDENTIFIERS_MATCH(
+    wait_set, wait_set->implementation_identifier, identifier,
+    return RMW_RET_INCORRECT_RMW_IMPLEMENTATION);
+
+  std::chrono::steady_clock::time_point deadline;
+  if (wait_timeout) {
+    deadline = std::chrono::steady_clock::now() +
+      std::chrono::seconds(wait_timeout->sec) + std::chrono::nanoseconds(wait_timeout->nsec);
+  }
+  Notifier & notifier = Notifier::instance();
+  // Reading the generation before scanning guarantees that anything becoming
+  // ready in between cuts the wait short.
+  for (;;) {
+    const uint64_t generation = notifier.generation();
+    if (any_ready(subscriptions, guard_conditions, services, clients, events)) {
+      break;
+    }
+    if (!notifier.wait(generation, wait_timeout ? &deadline : nullptr)) {
+      break;
+    }
+  }
+
+  if (!clear_not_ready(subscriptions, guard_conditions, services, clients, events)) {
+    return RMW_RET_TIMEOUT;
+  }
+  return RMW_RET_OK;
+}
+}  // extern "C"
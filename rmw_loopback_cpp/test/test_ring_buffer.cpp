@@ -0,0 +1,120 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../src/ring_buffer.hpp"
+
+using rmw_loopback_cpp::RingBuffer;
+
+TEST(RingBuffer, push_pop_in_order) {
+  RingBuffer<int> ring(3u);
+  EXPECT_EQ(3u, ring.capacity());
+  EXPECT_TRUE(ring.empty());
+  EXPECT_FALSE(ring.try_pop([](int &) {FAIL();}));
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(ring.try_push([i](int & value) {value = i;}));
+  }
+  EXPECT_FALSE(ring.try_push([](int &) {FAIL();}));
+  EXPECT_EQ(3u, ring.size());
+  EXPECT_FALSE(ring.empty());
+
+  // cells are reused once popped, wrapping around
+  for (int i = 0; i < 5; ++i) {
+    int popped = -1;
+    EXPECT_TRUE(ring.try_pop([&popped](int & value) {popped = value;}));
+    EXPECT_EQ(i, popped);
+    EXPECT_TRUE(ring.try_push([i](int & value) {value = i + 3;}));
+  }
+  EXPECT_EQ(3u, ring.size());
+}
+
+TEST(RingBuffer, push_overwriting_drops_oldest) {
+  RingBuffer<int> ring(2u);
+  for (int i = 0; i < 5; ++i) {
+    ring.push_overwriting([i](int & value) {value = i;});
+  }
+  EXPECT_EQ(2u, ring.size());
+  int popped = -1;
+  EXPECT_TRUE(ring.try_pop([&popped](int & value) {popped = value;}));
+  EXPECT_EQ(3, popped);
+  EXPECT_TRUE(ring.try_pop([&popped](int & value) {popped = value;}));
+  EXPECT_EQ(4, popped);
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST(RingBuffer, values_keep_their_storage) {
+  RingBuffer<std::vector<int>> ring(2u);
+  for (size_t i = 0u; i < ring.capacity(); ++i) {
+    ring.push_overwriting([](std::vector<int> & value) {value.assign(100u, 1);});
+    ring.try_pop([](std::vector<int> &) {});
+  }
+  ring.push_overwriting(
+    [](std::vector<int> & value) {
+      EXPECT_GE(value.capacity(), 100u);
+      value.assign(10u, 2);
+    });
+}
+
+TEST(RingBuffer, zero_capacity_holds_one_value) {
+  RingBuffer<int> ring(0u);
+  EXPECT_EQ(1u, ring.capacity());
+  EXPECT_TRUE(ring.try_push([](int & value) {value = 1;}));
+  EXPECT_FALSE(ring.try_push([](int &) {}));
+}
+
+TEST(RingBuffer, concurrent_producers_and_consumers) {
+  constexpr int producer_count = 4;
+  constexpr int values_per_producer = 10000;
+  RingBuffer<int> ring(64u);
+  std::atomic<long long> sum{0};
+  std::atomic<int> popped_count{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producer_count; ++p) {
+    threads.emplace_back(
+      [&ring]() {
+        for (int i = 1; i <= values_per_producer; ++i) {
+          while (!ring.try_push([i](int & value) {value = i;})) {
+            std::this_thread::yield();
+          }
+        }
+      });
+  }
+  for (int c = 0; c < 2; ++c) {
+    threads.emplace_back(
+      [&]() {
+        while (popped_count.load() < producer_count * values_per_producer) {
+          if (!ring.try_pop([&sum](int & value) {sum += value;})) {
+            std::this_thread::yield();
+            continue;
+          }
+          ++popped_count;
+        }
+      });
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  const long long expected =
+    producer_count * (static_cast<long long>(values_per_producer) * (values_per_producer + 1) / 2);
+  EXPECT_EQ(expected, sum.load());
+  EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,262 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <ctime>
+#include <string>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/subscription_content_filter_options.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_content_filter";
+constexpr size_t messages_per_iteration = 100u;
+constexpr rmw_time_t message_timeout{1, 0};
+constexpr std::chrono::seconds delivery_timeout{10};
+}  // namespace
+
+// Compares dropping messages in user code after taking them all against
+// letting a content filter drop them, either in the RMW implementation or in
+// rmw_implementation when the RMW_IMPLEMENTATION_CONTENT_FILTER_FALLBACK
+// environment variable is set.
+// Every iteration publishes as many messages as messages_per_iteration and
+// delivers as many as the benchmark argument, i.e. the selectivity of the
+// filter in percent. Besides the time per iteration, the CPU time the
+// process spends per delivered message is reported, in microseconds.
+class PerformanceTestContentFilter : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_content_filter_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const rosidl_message_type_support_t * ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = 1000u;
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &qos, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &qos, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    if (!test_msgs__msg__BasicTypes__init(&msg)) {
+      st.SkipWithError("failed to initialize message");
+      return;
+    }
+
+    // Let discovery complete before measuring anything.
+    bool taken = false;
+    void * subscriptions[1] = {sub->data};
+    rmw_subscriptions_t subscriptions_set{1, subscriptions};
+    if (
+      RMW_RET_OK != rmw_publish(pub, &msg, nullptr) ||
+      RMW_RET_OK != rmw_wait(
+        &subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout) ||
+      RMW_RET_OK != rmw_take(sub, &msg, &taken, nullptr) || !taken)
+    {
+      st.SkipWithError("failed to take a first message");
+      return;
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    test_msgs__msg__BasicTypes__fini(&msg);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+      wait_set = nullptr;
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+      sub = nullptr;
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+      pub = nullptr;
+    }
+    if (node) {
+      rmw_destroy_node(node);
+      node = nullptr;
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  // Publish messages whose int32_value goes from 0 to messages_per_iteration,
+  // and take all those that get delivered.
+  bool publish_and_take(benchmark::State & st, bool filter_in_user_code, size_t & delivered)
+  {
+    const int32_t threshold = static_cast<int32_t>(st.range(0));
+    for (size_t i = 0u; i < messages_per_iteration; ++i) {
+      msg.int32_value = static_cast<int32_t>(i);
+      if (RMW_RET_OK != rmw_publish(pub, &msg, nullptr)) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return false;
+      }
+    }
+
+    const size_t expected = filter_in_user_code ?
+      messages_per_iteration : static_cast<size_t>(threshold);
+    size_t received = 0u;
+    const auto start = std::chrono::steady_clock::now();
+    while (received < expected) {
+      if (std::chrono::steady_clock::now() - start > delivery_timeout) {
+        st.SkipWithError("timed out waiting for messages");
+        return false;
+      }
+      bool taken = false;
+      if (RMW_RET_OK != rmw_take(sub, &msg, &taken, nullptr)) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return false;
+      }
+      if (!taken) {
+        void * subscriptions[1] = {sub->data};
+        rmw_subscriptions_t subscriptions_set{1, subscriptions};
+        rmw_ret_t ret = rmw_wait(
+          &subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout);
+        if (RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return false;
+        }
+        continue;
+      }
+      ++received;
+      if (!filter_in_user_code || msg.int32_value < threshold) {
+        ++delivered;
+      }
+    }
+    return true;
+  }
+
+  void report(benchmark::State & st, std::clock_t cpu_time, size_t delivered)
+  {
+    if (delivered > 0u) {
+      const double cpu_time_us = 1e6 * static_cast<double>(cpu_time) / CLOCKS_PER_SEC;
+      st.counters["cpu_us_per_delivered_message"] = cpu_time_us / static_cast<double>(delivered);
+    }
+    st.SetItemsProcessed(static_cast<int64_t>(delivered));
+  }
+
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs__msg__BasicTypes msg{};
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestContentFilter, no_filter)(benchmark::State & st)
+{
+  size_t delivered = 0u;
+  reset_heap_counters();
+  const std::clock_t cpu_start = std::clock();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (!publish_and_take(st, true, delivered)) {
+      break;
+    }
+  }
+  report(st, std::clock() - cpu_start, delivered);
+}
+BENCHMARK_REGISTER_F(PerformanceTestContentFilter, no_filter)
+->ArgName("selectivity")->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond)
+->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestContentFilter, content_filter)(benchmark::State & st)
+{
+  const std::string threshold = std::to_string(st.range(0));
+  const char * parameters[] = {threshold.c_str()};
+  rmw_subscription_content_filter_options_t options =
+    rmw_get_zero_initialized_content_filter_options();
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  rmw_ret_t ret = rmw_subscription_content_filter_options_init(
+    "int32_value < %0", 1u, parameters, &allocator, &options);
+  if (RMW_RET_OK != ret) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+  ret = rmw_subscription_set_content_filter(sub, &options);
+  rmw_subscription_content_filter_options_fini(&options, &allocator);
+  if (RMW_RET_UNSUPPORTED == ret) {
+    st.SkipWithError("content filters are unsupported");
+    return;
+  }
+  if (RMW_RET_OK != ret) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+
+  size_t delivered = 0u;
+  reset_heap_counters();
+  const std::clock_t cpu_start = std::clock();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (!publish_and_take(st, false, delivered)) {
+      break;
+    }
+  }
+  report(st, std::clock() - cpu_start, delivered);
+}
+BENCHMARK_REGISTER_F(PerformanceTestContentFilter, content_filter)
+->ArgName("selectivity")->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond)
+->UseRealTime();
@@ -0,0 +1,279 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/get_node_info_and_types.h"
+#include "rmw/get_service_names_and_types.h"
+#include "rmw/get_topic_endpoint_info.h"
+#include "rmw/get_topic_names_and_types.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/srv/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char node_name_prefix[] = "benchmark_graph_node_";
+constexpr char node_namespace[] = "/benchmark_graph";
+constexpr char topic_name_prefix[] = "/benchmark_graph/topic_";
+constexpr char service_name_prefix[] = "/benchmark_graph/service_";
+// Endpoints per node, and per topic.
+constexpr size_t endpoints_per_node = 50u;
+constexpr size_t endpoints_per_topic = 10u;
+constexpr std::chrono::seconds discovery_timeout{60};
+}  // namespace
+
+// Measures graph queries against as many endpoints as the benchmark argument,
+// spread over one node per 50 endpoints and one topic per 10 endpoints, and
+// evenly split into publishers, subscriptions and services.
+// The time it takes to create all entities and for the graph to account for
+// them is reported as well.
+class PerformanceTestGraph : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const size_t endpoint_count = static_cast<size_t>(st.range(0));
+    const size_t node_count = (endpoint_count + endpoints_per_node - 1u) / endpoints_per_node;
+    topic_count = (endpoint_count + endpoints_per_topic - 1u) / endpoints_per_topic;
+    const rosidl_message_type_support_t * message_ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    const rosidl_service_type_support_t * service_ts =
+      ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+
+    const auto creation_start = std::chrono::steady_clock::now();
+    for (size_t i = 0u; i < node_count; ++i) {
+      const std::string node_name = node_name_prefix + std::to_string(i);
+      rmw_node_t * node = rmw_create_node(&context, node_name.c_str(), node_namespace);
+      if (!node) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      nodes.push_back(node);
+    }
+    for (size_t i = 0u; i < endpoint_count; ++i) {
+      rmw_node_t * node = nodes[i / endpoints_per_node];
+      const std::string topic_name = topic_name_prefix + std::to_string(i % topic_count);
+      if (0u == i % 3u) {
+        rmw_publisher_t * pub = rmw_create_publisher(
+          node, message_ts, topic_name.c_str(), &rmw_qos_profile_default, &pub_options);
+        if (!pub) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return;
+        }
+        pubs.emplace_back(node, pub);
+      } else if (1u == i % 3u) {
+        rmw_subscription_t * sub = rmw_create_subscription(
+          node, message_ts, topic_name.c_str(), &rmw_qos_profile_default, &sub_options);
+        if (!sub) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return;
+        }
+        subs.emplace_back(node, sub);
+      } else {
+        const std::string service_name = service_name_prefix + std::to_string(i);
+        rmw_service_t * srv = rmw_create_service(
+          node, service_ts, service_name.c_str(), &rmw_qos_profile_services_default);
+        if (!srv) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return;
+        }
+        srvs.emplace_back(node, srv);
+      }
+    }
+    const auto creation_end = std::chrono::steady_clock::now();
+
+    // Wait for the graph to account for every subscription.
+    size_t subscription_count = 0u;
+    while (subscription_count != subs.size()) {
+      if (std::chrono::steady_clock::now() - creation_end > discovery_timeout) {
+        st.SkipWithError("timed out waiting for the graph to converge");
+        return;
+      }
+      subscription_count = 0u;
+      for (size_t i = 0u; i < topic_count; ++i) {
+        const std::string topic_name = topic_name_prefix + std::to_string(i);
+        size_t count = 0u;
+        ret = rmw_count_subscribers(nodes.front(), topic_name.c_str(), &count);
+        if (RMW_RET_OK != ret) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return;
+        }
+        subscription_count += count;
+      }
+      if (subscription_count != subs.size()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      }
+    }
+    const auto convergence_end = std::chrono::steady_clock::now();
+    creation_ms = std::chrono::duration<double, std::milli>(creation_end - creation_start).count();
+    convergence_ms =
+      std::chrono::duration<double, std::milli>(convergence_end - creation_end).count();
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    for (const auto & srv : srvs) {
+      rmw_destroy_service(srv.first, srv.second);
+    }
+    for (const auto & sub : subs) {
+      rmw_destroy_subscription(sub.first, sub.second);
+    }
+    for (const auto & pub : pubs) {
+      rmw_destroy_publisher(pub.first, pub.second);
+    }
+    for (rmw_node_t * node : nodes) {
+      rmw_destroy_node(node);
+    }
+    srvs.clear();
+    subs.clear();
+    pubs.clear();
+    nodes.clear();
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  void report_discovery(benchmark::State & st)
+  {
+    st.counters["creation_ms"] = creation_ms;
+    st.counters["convergence_ms"] = convergence_ms;
+  }
+
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  std::vector<rmw_node_t *> nodes;
+  std::vector<std::pair<rmw_node_t *, rmw_publisher_t *>> pubs;
+  std::vector<std::pair<rmw_node_t *, rmw_subscription_t *>> subs;
+  std::vector<std::pair<rmw_node_t *, rmw_service_t *>> srvs;
+  size_t topic_count{0u};
+  double creation_ms{0.0};
+  double convergence_ms{0.0};
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestGraph, get_topic_names_and_types)(benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_names_and_types_t topic_names_and_types = rmw_get_zero_initialized_names_and_types();
+    rmw_ret_t ret =
+      rmw_get_topic_names_and_types(nodes.front(), &allocator, false, &topic_names_and_types);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    rmw_names_and_types_fini(&topic_names_and_types);
+  }
+  report_discovery(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestGraph, get_topic_names_and_types)
+->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(PerformanceTestGraph, get_service_names_and_types_by_node)(
+  benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  // The last node, for implementations to look for it the longest.
+  const std::string node_name = node_name_prefix + std::to_string(nodes.size() - 1u);
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_names_and_types_t service_names_and_types = rmw_get_zero_initialized_names_and_types();
+    rmw_ret_t ret = rmw_get_service_names_and_types_by_node(
+      nodes.front(), &allocator, node_name.c_str(), node_namespace, &service_names_and_types);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    rmw_names_and_types_fini(&service_names_and_types);
+  }
+  report_discovery(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestGraph, get_service_names_and_types_by_node)
+->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(PerformanceTestGraph, count_subscribers)(benchmark::State & st)
+{
+  const std::string topic_name = topic_name_prefix + std::to_string(topic_count - 1u);
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    size_t count = 0u;
+    if (RMW_RET_OK != rmw_count_subscribers(nodes.front(), topic_name.c_str(), &count)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  report_discovery(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestGraph, count_subscribers)
+->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_DEFINE_F(PerformanceTestGraph, get_subscriptions_info_by_topic)(benchmark::State & st)
+{
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  const std::string topic_name = topic_name_prefix + std::to_string(topic_count - 1u);
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_topic_endpoint_info_array_t subscriptions_info =
+      rmw_get_zero_initialized_topic_endpoint_info_array();
+    rmw_ret_t ret = rmw_get_subscriptions_info_by_topic(
+      nodes.front(), &allocator, topic_name.c_str(), false, &subscriptions_info);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    rmw_topic_endpoint_info_array_fini(&subscriptions_info, &allocator);
+  }
+  report_discovery(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestGraph, get_subscriptions_info_by_topic)
+->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,230 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+#include "rcutils/time.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "rosidl_runtime_c/primitives_sequence_functions.h"
+
+#include "test_msgs/msg/unbounded_sequences.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_latency";
+constexpr rmw_time_t message_timeout{10, 0};
+// Latency samples to make room for upfront, and to record at most, to keep
+// allocations out of the measurement.
+constexpr size_t reserved_sample_count = 1u << 20;
+}  // namespace
+
+// Measures one-way latency from rmw_publish() to rmw_take_with_info() between
+// a publisher and a subscription of the same node, for messages carrying as
+// many bytes as the benchmark argument.
+// Latency is the difference between the received and source timestamps in
+// the message info, or the time from publishing to taking if the RMW
+// implementation does not provide them.
+// Percentiles are reported as counters, since averages hide tail latencies.
+class PerformanceTestLatency : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    // Same setup as in TestSubscription.
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    constexpr char node_name[] = "my_test_node";
+    constexpr char node_namespace[] = "/my_test_ns";
+    node = rmw_create_node(&context, node_name, node_namespace);
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const rosidl_message_type_support_t * ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, UnboundedSequences);
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = 1u;
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &qos, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &qos, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const size_t size = static_cast<size_t>(st.range(0));
+    if (
+      !test_msgs__msg__UnboundedSequences__init(&pub_msg) ||
+      !test_msgs__msg__UnboundedSequences__init(&sub_msg) ||
+      !rosidl_runtime_c__octet__Sequence__init(&pub_msg.byte_values, size))
+    {
+      st.SkipWithError("failed to initialize messages");
+      return;
+    }
+    std::memset(pub_msg.byte_values.data, 0xA5, size);
+
+    // Let discovery complete before measuring anything.
+    rcutils_time_point_value_t latency;
+    if (!publish_and_take(&latency)) {
+      st.SkipWithError("failed to take a first message");
+      return;
+    }
+    latencies.clear();
+    latencies.reserve(reserved_sample_count);
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    test_msgs__msg__UnboundedSequences__fini(&sub_msg);
+    test_msgs__msg__UnboundedSequences__fini(&pub_msg);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+    }
+    if (node) {
+      rmw_destroy_node(node);
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  // Publish a message, wait for it to arrive and take it, computing its latency.
+  bool publish_and_take(rcutils_time_point_value_t * latency)
+  {
+    rcutils_time_point_value_t published_at = 0;
+    if (RCUTILS_RET_OK != rcutils_system_time_now(&published_at)) {
+      return false;
+    }
+    if (RMW_RET_OK != rmw_publish(pub, &pub_msg, nullptr)) {
+      return false;
+    }
+    void * subscriptions[1] = {sub->data};
+    rmw_subscriptions_t subscriptions_set{1, subscriptions};
+    rmw_ret_t ret =
+      rmw_wait(&subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout);
+    if (RMW_RET_OK != ret) {
+      return false;
+    }
+    bool taken = false;
+    rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+    ret = rmw_take_with_info(sub, &sub_msg, &taken, &message_info, nullptr);
+    if (RMW_RET_OK != ret || !taken) {
+      return false;
+    }
+    if (message_info.source_timestamp != 0 && message_info.received_timestamp != 0) {
+      *latency = message_info.received_timestamp - message_info.source_timestamp;
+      return true;
+    }
+    rcutils_time_point_value_t taken_at = 0;
+    if (RCUTILS_RET_OK != rcutils_system_time_now(&taken_at)) {
+      return false;
+    }
+    *latency = taken_at - published_at;
+    return true;
+  }
+
+  // Report latency percentiles and maximum, in nanoseconds.
+  void report_latencies(benchmark::State & st)
+  {
+    if (latencies.empty()) {
+      return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [this](double p) {
+        const size_t index = static_cast<size_t>(p * static_cast<double>(latencies.size() - 1u));
+        return static_cast<double>(latencies[index]);
+      };
+    st.counters["p50_ns"] = percentile(0.5);
+    st.counters["p99_ns"] = percentile(0.99);
+    st.counters["p99.9_ns"] = percentile(0.999);
+    st.counters["max_ns"] = static_cast<double>(latencies.back());
+  }
+
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs__msg__UnboundedSequences pub_msg{};
+  test_msgs__msg__UnboundedSequences sub_msg{};
+  std::vector<rcutils_time_point_value_t> latencies;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestLatency, publish_take_latency)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rcutils_time_point_value_t latency = 0;
+    if (!publish_and_take(&latency)) {
+      st.SkipWithError("failed to publish and take a message");
+      break;
+    }
+    if (latencies.size() < reserved_sample_count) {
+      latencies.push_back(latency);
+    }
+  }
+  report_latencies(st);
+  st.SetBytesProcessed(st.iterations() * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTestLatency, publish_take_latency)
+->RangeMultiplier(16)->Range(16, 16 << 20);
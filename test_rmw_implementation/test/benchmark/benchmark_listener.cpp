@@ -0,0 +1,349 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_listener";
+constexpr rmw_time_t message_timeout{1, 0};
+constexpr std::chrono::seconds notification_timeout{1};
+// Messages whose latency is recorded, at most.
+constexpr size_t max_latency_samples = 1u << 20u;
+
+int64_t
+now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time spent by the calling thread, in nanoseconds, or -1 if unknown.
+int64_t
+thread_cpu_time_ns()
+{
+#ifndef _WIN32
+  struct timespec ts;
+  if (0 == clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts)) {
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+  }
+#endif
+  return -1;
+}
+}  // namespace
+
+// Compares receiving messages upon listener callbacks, as set with
+// rmw_subscription_set_on_new_message_callback(), against receiving them
+// upon rmw_wait(), while another thread publishes them at as many hertz as
+// the benchmark argument.
+// Every iteration handles one message. Besides percentiles of the latency
+// from publication to handling, in microseconds, the CPU time the receiving
+// thread spends per message is reported, in microseconds as well, where
+// supported.
+class PerformanceTestListener : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_listener_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const rosidl_message_type_support_t * ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = 1000u;
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &qos, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &qos, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    if (!test_msgs__msg__BasicTypes__init(&msg)) {
+      st.SkipWithError("failed to initialize message");
+      return;
+    }
+
+    // Let discovery complete before measuring anything.
+    bool taken = false;
+    if (
+      RMW_RET_OK != rmw_publish(pub, &msg, nullptr) || !wait_for_message() ||
+      RMW_RET_OK != rmw_take(sub, &msg, &taken, nullptr) || !taken)
+    {
+      st.SkipWithError("failed to take a first message");
+      return;
+    }
+    latencies_us.reserve(max_latency_samples);
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    stop_publishing();
+    if (sub) {
+      rmw_subscription_set_on_new_message_callback(sub, nullptr, nullptr);
+    }
+    test_msgs__msg__BasicTypes__fini(&msg);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+      wait_set = nullptr;
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+      sub = nullptr;
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+      pub = nullptr;
+    }
+    if (node) {
+      rmw_destroy_node(node);
+      node = nullptr;
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    latencies_us.clear();
+    pending_messages = 0u;
+    rmw_reset_error();
+  }
+
+protected:
+  static void on_new_message(const void * user_data, size_t number_of_events)
+  {
+    auto self = static_cast<PerformanceTestListener *>(const_cast<void *>(user_data));
+    {
+      std::lock_guard<std::mutex> lock(self->mutex);
+      self->pending_messages += number_of_events;
+    }
+    self->condition.notify_one();
+  }
+
+  bool wait_for_message()
+  {
+    void * subscriptions[1] = {sub->data};
+    rmw_subscriptions_t subscriptions_set{1, subscriptions};
+    return RMW_RET_OK == rmw_wait(
+      &subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout);
+  }
+
+  bool wait_for_notification()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!condition.wait_for(lock, notification_timeout, [this] {return pending_messages > 0u;})) {
+      return false;
+    }
+    --pending_messages;
+    return true;
+  }
+
+  // Publish messages at the given rate from another thread, stamped with
+  // the time they are published at.
+  void start_publishing(int64_t rate_hz)
+  {
+    publishing = true;
+    publisher_thread = std::thread(
+      [this, rate_hz, stamped_msg = msg]() mutable {
+        const auto period = std::chrono::nanoseconds(1000000000 / rate_hz);
+        auto next_time = std::chrono::steady_clock::now();
+        while (publishing) {
+          stamped_msg.int64_value = now_ns();
+          rmw_publish(pub, &stamped_msg, nullptr);
+          next_time += period;
+          if (period > std::chrono::milliseconds(1)) {
+            std::this_thread::sleep_until(next_time);
+          } else {
+            // sleeps are too coarse for high rates
+            while (publishing && std::chrono::steady_clock::now() < next_time) {
+              std::this_thread::yield();
+            }
+          }
+        }
+      });
+  }
+
+  void stop_publishing()
+  {
+    publishing = false;
+    if (publisher_thread.joinable()) {
+      publisher_thread.join();
+    }
+  }
+
+  // Take one message, if any, and record its latency.
+  bool take_message(bool & taken)
+  {
+    if (RMW_RET_OK != rmw_take(sub, &msg, &taken, nullptr)) {
+      return false;
+    }
+    if (taken && latencies_us.size() < max_latency_samples) {
+      latencies_us.push_back(static_cast<double>(now_ns() - msg.int64_value) / 1000.0);
+    }
+    return true;
+  }
+
+  void report(benchmark::State & st, int64_t cpu_start_ns, int64_t cpu_end_ns)
+  {
+    if (st.iterations() > 0 && cpu_start_ns >= 0 && cpu_end_ns >= 0) {
+      const double cpu_time_us = static_cast<double>(cpu_end_ns - cpu_start_ns) / 1000.0;
+      st.counters["cpu_us_per_message"] = cpu_time_us / static_cast<double>(st.iterations());
+    }
+    if (latencies_us.empty()) {
+      return;
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    const double last_index = static_cast<double>(latencies_us.size() - 1u);
+    const auto percentile = [this, last_index](double p) {
+        return latencies_us[static_cast<size_t>(p * last_index)];
+      };
+    st.counters["latency_p50_us"] = percentile(0.5);
+    st.counters["latency_p99_us"] = percentile(0.99);
+    st.counters["latency_max_us"] = latencies_us.back();
+  }
+
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs__msg__BasicTypes msg{};
+  std::vector<double> latencies_us;
+
+  std::thread publisher_thread;
+  std::atomic<bool> publishing{false};
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t pending_messages{0u};
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestListener, receive_upon_callback)(benchmark::State & st)
+{
+  if (RMW_RET_OK != rmw_subscription_set_on_new_message_callback(sub, on_new_message, this)) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+  start_publishing(st.range(0));
+
+  reset_heap_counters();
+  const int64_t cpu_start_ns = thread_cpu_time_ns();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    bool taken = false;
+    while (!taken) {
+      if (!wait_for_notification()) {
+        st.SkipWithError("timed out waiting for a message");
+        break;
+      }
+      if (!take_message(taken)) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+    }
+    if (!taken) {
+      break;
+    }
+  }
+  const int64_t cpu_end_ns = thread_cpu_time_ns();
+
+  stop_publishing();
+  report(st, cpu_start_ns, cpu_end_ns);
+}
+BENCHMARK_REGISTER_F(PerformanceTestListener, receive_upon_callback)
+->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+BENCHMARK_DEFINE_F(PerformanceTestListener, receive_upon_wait)(benchmark::State & st)
+{
+  start_publishing(st.range(0));
+
+  reset_heap_counters();
+  const int64_t cpu_start_ns = thread_cpu_time_ns();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    bool taken = false;
+    while (!taken) {
+      if (!wait_for_message()) {
+        st.SkipWithError("timed out waiting for a message");
+        break;
+      }
+      if (!take_message(taken)) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+    }
+    if (!taken) {
+      break;
+    }
+  }
+  const int64_t cpu_end_ns = thread_cpu_time_ns();
+
+  stop_publishing();
+  report(st, cpu_start_ns, cpu_end_ns);
+}
+BENCHMARK_REGISTER_F(PerformanceTestListener, receive_upon_wait)
+->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond)->UseRealTime();
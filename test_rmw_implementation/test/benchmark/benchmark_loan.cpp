@@ -0,0 +1,227 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_loan";
+constexpr rmw_time_t message_timeout{1, 0};
+}  // namespace
+
+// Compares publishing and taking loaned messages against publishing and
+// taking copies of them, in terms of throughput and heap operations.
+// Loans require plain messages of a fixed size, such as BasicTypes.
+class PerformanceTestLoan : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_loan_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = 1u;
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &qos, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &qos, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    if (!test_msgs__msg__BasicTypes__init(&msg)) {
+      st.SkipWithError("failed to initialize message");
+      return;
+    }
+
+    // Let discovery complete before measuring anything.
+    bool taken = false;
+    if (
+      RMW_RET_OK != rmw_publish(pub, &msg, nullptr) || !wait_for_message() ||
+      RMW_RET_OK != rmw_take(sub, &msg, &taken, nullptr) || !taken)
+    {
+      st.SkipWithError("failed to take a first message");
+      return;
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    test_msgs__msg__BasicTypes__fini(&msg);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+    }
+    if (node) {
+      rmw_destroy_node(node);
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  bool wait_for_message()
+  {
+    void * subscriptions[1] = {sub->data};
+    rmw_subscriptions_t subscriptions_set{1, subscriptions};
+    return RMW_RET_OK == rmw_wait(
+      &subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout);
+  }
+
+  const rosidl_message_type_support_t * ts{
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes)};
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs__msg__BasicTypes msg{};
+};
+
+BENCHMARK_F(PerformanceTestLoan, publish_copy)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (RMW_RET_OK != rmw_publish(pub, &msg, nullptr)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  st.SetBytesProcessed(st.iterations() * sizeof(msg));
+}
+
+BENCHMARK_F(PerformanceTestLoan, publish_loaned)(benchmark::State & st)
+{
+  if (!pub->can_loan_messages) {
+    st.SkipWithError("publisher cannot loan messages");
+    return;
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    void * loaned_msg = nullptr;
+    if (RMW_RET_OK != rmw_borrow_loaned_message(pub, ts, &loaned_msg)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    *static_cast<test_msgs__msg__BasicTypes *>(loaned_msg) = msg;
+    if (RMW_RET_OK != rmw_publish_loaned_message(pub, loaned_msg, nullptr)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  st.SetBytesProcessed(st.iterations() * sizeof(msg));
+}
+
+BENCHMARK_F(PerformanceTestLoan, take_copy)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    st.PauseTiming();
+    if (RMW_RET_OK != rmw_publish(pub, &msg, nullptr) || !wait_for_message()) {
+      st.SkipWithError("failed to publish a message");
+      break;
+    }
+    st.ResumeTiming();
+    bool taken = false;
+    if (RMW_RET_OK != rmw_take(sub, &msg, &taken, nullptr) || !taken) {
+      st.SkipWithError("failed to take a message");
+      break;
+    }
+  }
+  st.SetBytesProcessed(st.iterations() * sizeof(msg));
+}
+
+BENCHMARK_F(PerformanceTestLoan, take_loaned)(benchmark::State & st)
+{
+  if (!sub->can_loan_messages) {
+    st.SkipWithError("subscription cannot loan messages");
+    return;
+  }
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    st.PauseTiming();
+    if (RMW_RET_OK != rmw_publish(pub, &msg, nullptr) || !wait_for_message()) {
+      st.SkipWithError("failed to publish a message");
+      break;
+    }
+    st.ResumeTiming();
+    bool taken = false;
+    void * loaned_msg = nullptr;
+    if (RMW_RET_OK != rmw_take_loaned_message(sub, &loaned_msg, &taken, nullptr) || !taken) {
+      st.SkipWithError("failed to take a loaned message");
+      break;
+    }
+    benchmark::DoNotOptimize(*static_cast<test_msgs__msg__BasicTypes *>(loaned_msg));
+    if (RMW_RET_OK != rmw_return_loaned_message_from_subscription(sub, loaned_msg)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  st.SetBytesProcessed(st.iterations() * sizeof(msg));
+}
@@ -0,0 +1,261 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+#include "rmw/serialized_message.h"
+
+#include "rmw_implementation/serialized_message_pool.h"
+
+#include "test_msgs/message_fixtures.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+// Measures serialization, deserialization and serialized size computation of
+// every test_msgs message type, plus UnboundedSequences messages whose
+// sequences hold as many elements as the benchmark argument.
+// The serialized message buffer and the deserialized message are reused
+// across iterations, so that steady state allocations show, except when
+// comparing new serialized messages with and without a buffer pool.
+class PerformanceTestSerialize : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    rmw_ret_t ret = rmw_serialized_message_init(&serialized_message, 0u, &allocator);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    input_message.reset();
+    output_message.reset();
+    rmw_serialized_message_fini(&serialized_message);
+    rmw_reset_error();
+  }
+
+protected:
+  // Use the given message, serializing it once to size the buffer.
+  template<typename MessageT>
+  bool use_message(std::shared_ptr<MessageT> message)
+  {
+    ts = rosidl_typesupport_cpp::get_message_type_support_handle<MessageT>();
+    input_message = message;
+    output_message = std::make_shared<MessageT>();
+    return
+      RMW_RET_OK == rmw_serialize(input_message.get(), ts, &serialized_message) &&
+      RMW_RET_OK == rmw_deserialize(&serialized_message, ts, output_message.get());
+  }
+
+  void serialize(benchmark::State & st)
+  {
+    reset_heap_counters();
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      if (RMW_RET_OK != rmw_serialize(input_message.get(), ts, &serialized_message)) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+    }
+    st.SetBytesProcessed(st.iterations() * serialized_message.buffer_length);
+  }
+
+  // Serialize into a new serialized message every time, as recorders do.
+  void serialize_to_new_message(benchmark::State & st, rcutils_allocator_t allocator)
+  {
+    reset_heap_counters();
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      rmw_serialized_message_t new_message = rmw_get_zero_initialized_serialized_message();
+      if (
+        RMW_RET_OK != rmw_serialized_message_init(&new_message, 0u, &allocator) ||
+        RMW_RET_OK != rmw_serialize(input_message.get(), ts, &new_message) ||
+        RMW_RET_OK != rmw_serialized_message_fini(&new_message))
+      {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+    }
+    st.SetBytesProcessed(st.iterations() * serialized_message.buffer_length);
+  }
+
+  void deserialize(benchmark::State & st)
+  {
+    reset_heap_counters();
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      if (RMW_RET_OK != rmw_deserialize(&serialized_message, ts, output_message.get())) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+    }
+    st.SetBytesProcessed(st.iterations() * serialized_message.buffer_length);
+  }
+
+  void get_serialized_message_size(benchmark::State & st)
+  {
+    // Plain messages need no bounds.
+    rosidl_runtime_c__Sequence__bound message_bounds{};
+    size_t size = 0u;
+    rmw_ret_t ret = rmw_get_serialized_message_size(ts, &message_bounds, &size);
+    if (RMW_RET_UNSUPPORTED == ret) {
+      st.SkipWithError("rmw_get_serialized_message_size() is unsupported");
+      return;
+    }
+
+    reset_heap_counters();
+    for (auto _ : st) {
+      RCUTILS_UNUSED(_);
+      if (RMW_RET_OK != rmw_get_serialized_message_size(ts, &message_bounds, &size)) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+    }
+  }
+
+  const rosidl_message_type_support_t * ts{nullptr};
+  std::shared_ptr<void> input_message;
+  std::shared_ptr<void> output_message;
+  rmw_serialized_message_t serialized_message{rmw_get_zero_initialized_serialized_message()};
+};
+
+// Define benchmarks for the last, i.e. most populated, message of a fixture.
+#define SERIALIZE_BENCHMARKS(type_name) \
+  BENCHMARK_F(PerformanceTestSerialize, serialize_ ## type_name)(benchmark::State & st) \
+  { \
+    if (!use_message(test_msgs::get_messages_ ## type_name().back())) { \
+      st.SkipWithError(rmw_get_error_string().str); \
+      return; \
+    } \
+    serialize(st); \
+  } \
+  BENCHMARK_F(PerformanceTestSerialize, deserialize_ ## type_name)(benchmark::State & st) \
+  { \
+    if (!use_message(test_msgs::get_messages_ ## type_name().back())) { \
+      st.SkipWithError(rmw_get_error_string().str); \
+      return; \
+    } \
+    deserialize(st); \
+  } \
+  BENCHMARK_F( \
+    PerformanceTestSerialize, get_serialized_message_size_ ## type_name)(benchmark::State & st) \
+  { \
+    if (!use_message(test_msgs::get_messages_ ## type_name().back())) { \
+      st.SkipWithError(rmw_get_error_string().str); \
+      return; \
+    } \
+    get_serialized_message_size(st); \
+  }
+
+SERIALIZE_BENCHMARKS(empty)
+SERIALIZE_BENCHMARKS(basic_types)
+SERIALIZE_BENCHMARKS(constants)
+SERIALIZE_BENCHMARKS(defaults)
+SERIALIZE_BENCHMARKS(strings)
+SERIALIZE_BENCHMARKS(wstrings)
+SERIALIZE_BENCHMARKS(arrays)
+SERIALIZE_BENCHMARKS(bounded_plain_sequences)
+SERIALIZE_BENCHMARKS(bounded_sequences)
+SERIALIZE_BENCHMARKS(unbounded_sequences)
+SERIALIZE_BENCHMARKS(nested)
+SERIALIZE_BENCHMARKS(multi_nested)
+SERIALIZE_BENCHMARKS(builtins)
+
+static std::shared_ptr<test_msgs::msg::UnboundedSequences>
+make_large_unbounded_sequences(size_t length)
+{
+  auto message = std::make_shared<test_msgs::msg::UnboundedSequences>();
+  message->bool_values.assign(length, true);
+  message->byte_values.assign(length, 0xAB);
+  message->char_values.assign(length, 'a');
+  message->float32_values.assign(length, 1.125f);
+  message->float64_values.assign(length, 1.125);
+  message->int8_values.assign(length, -8);
+  message->uint8_values.assign(length, 8u);
+  message->int16_values.assign(length, -16);
+  message->uint16_values.assign(length, 16u);
+  message->int32_values.assign(length, -32);
+  message->uint32_values.assign(length, 32u);
+  message->int64_values.assign(length, -64);
+  message->uint64_values.assign(length, 64u);
+  message->string_values.assign(length, std::string(16u, 's'));
+  message->basic_types_values.resize(length);
+  return message;
+}
+
+BENCHMARK_DEFINE_F(PerformanceTestSerialize, serialize_large_unbounded_sequences)(
+  benchmark::State & st)
+{
+  if (!use_message(make_large_unbounded_sequences(static_cast<size_t>(st.range(0))))) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+  serialize(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestSerialize, serialize_large_unbounded_sequences)
+->RangeMultiplier(16)->Range(1, 1 << 16);
+
+BENCHMARK_DEFINE_F(PerformanceTestSerialize, deserialize_large_unbounded_sequences)(
+  benchmark::State & st)
+{
+  if (!use_message(make_large_unbounded_sequences(static_cast<size_t>(st.range(0))))) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+  deserialize(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestSerialize, deserialize_large_unbounded_sequences)
+->RangeMultiplier(16)->Range(1, 1 << 16);
+
+BENCHMARK_DEFINE_F(PerformanceTestSerialize, serialize_to_new_message)(benchmark::State & st)
+{
+  if (!use_message(make_large_unbounded_sequences(static_cast<size_t>(st.range(0))))) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+  serialize_to_new_message(st, rcutils_get_default_allocator());
+}
+BENCHMARK_REGISTER_F(PerformanceTestSerialize, serialize_to_new_message)
+->RangeMultiplier(16)->Range(1, 1 << 16);
+
+BENCHMARK_DEFINE_F(PerformanceTestSerialize, serialize_to_new_pooled_message)(
+  benchmark::State & st)
+{
+  if (!use_message(make_large_unbounded_sequences(static_cast<size_t>(st.range(0))))) {
+    st.SkipWithError(rmw_get_error_string().str);
+    return;
+  }
+  serialize_to_new_message(st, rmw_implementation_get_serialized_message_pool_allocator());
+  rmw_implementation_trim_serialized_message_pool();
+}
+BENCHMARK_REGISTER_F(PerformanceTestSerialize, serialize_to_new_pooled_message)
+->RangeMultiplier(16)->Range(1, 1 << 16);
@@ -0,0 +1,291 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rosidl_typesupport_cpp/service_type_support.hpp"
+
+#include "rmw/error_handling.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/srv/arrays.hpp"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char service_name[] = "/benchmark_service";
+constexpr rmw_time_t wait_timeout{1, 0};
+constexpr std::chrono::seconds discovery_timeout{10};
+// Round trips whose latency is recorded, at most.
+constexpr size_t max_latency_samples = 1u << 20u;
+}  // namespace
+
+// Measures request to response round trips between as many clients as the
+// first benchmark argument and a single service, all in the same thread.
+// Every iteration, each client sends a request, the service responds to all
+// of them, and each client takes its response, so that there are as many
+// requests in flight as there are clients.
+// Requests and responses carry three strings as long as the second benchmark
+// argument, and Arrays services otherwise hold about 1 KiB of data.
+// Besides the throughput in requests per second, round trip latency
+// percentiles are reported, in microseconds.
+class PerformanceTestService : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_service_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const rosidl_service_type_support_t * ts =
+      rosidl_typesupport_cpp::get_service_type_support_handle<test_msgs::srv::Arrays>();
+    service = rmw_create_service(node, ts, service_name, &rmw_qos_profile_services_default);
+    if (!service) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    const size_t client_count = static_cast<size_t>(st.range(0));
+    for (size_t i = 0u; i < client_count; ++i) {
+      rmw_client_t * client =
+        rmw_create_client(node, ts, service_name, &rmw_qos_profile_services_default);
+      if (!client) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      clients.push_back(client);
+    }
+    wait_set = rmw_create_wait_set(&context, client_count + 1u);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const std::string payload(static_cast<size_t>(st.range(1)), 'p');
+    request.string_values.fill(payload);
+    response.string_values.fill(payload);
+    sequence_numbers.resize(client_count);
+    send_times.resize(client_count);
+    pending.resize(client_count);
+    clients_data.resize(client_count);
+    latencies_us.reserve(max_latency_samples);
+
+    // Let discovery complete before measuring anything.
+    const auto start = std::chrono::steady_clock::now();
+    for (rmw_client_t * client : clients) {
+      bool is_available = false;
+      while (!is_available) {
+        if (std::chrono::steady_clock::now() - start > discovery_timeout) {
+          st.SkipWithError("timed out waiting for the service to be available");
+          return;
+        }
+        if (RMW_RET_OK != rmw_service_server_is_available(node, client, &is_available)) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return;
+        }
+        if (!is_available) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+      }
+    }
+    if (!round_trip(st)) {
+      return;
+    }
+    latencies_us.clear();
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+      wait_set = nullptr;
+    }
+    for (rmw_client_t * client : clients) {
+      rmw_destroy_client(node, client);
+    }
+    clients.clear();
+    if (service) {
+      rmw_destroy_service(node, service);
+      service = nullptr;
+    }
+    if (node) {
+      rmw_destroy_node(node);
+      node = nullptr;
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    latencies_us.clear();
+    rmw_reset_error();
+  }
+
+protected:
+  // Send a request from every client, serve them all and take all responses.
+  bool round_trip(benchmark::State & st)
+  {
+    const size_t client_count = clients.size();
+    for (size_t i = 0u; i < client_count; ++i) {
+      send_times[i] = std::chrono::steady_clock::now();
+      if (RMW_RET_OK != rmw_send_request(clients[i], &request, &sequence_numbers[i])) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return false;
+      }
+      pending[i] = true;
+    }
+
+    size_t served = 0u;
+    while (served < client_count) {
+      void * services_data[1] = {service->data};
+      rmw_services_t services_set{1u, services_data};
+      if (RMW_RET_OK != rmw_wait(
+          nullptr, nullptr, &services_set, nullptr, nullptr, wait_set, &wait_timeout))
+      {
+        st.SkipWithError("timed out waiting for requests");
+        return false;
+      }
+      bool taken = true;
+      while (taken && served < client_count) {
+        rmw_service_info_t request_header;
+        if (RMW_RET_OK != rmw_take_request(service, &request_header, &served_request, &taken)) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return false;
+        }
+        if (taken) {
+          if (RMW_RET_OK != rmw_send_response(service, &request_header.request_id, &response)) {
+            st.SkipWithError(rmw_get_error_string().str);
+            return false;
+          }
+          ++served;
+        }
+      }
+    }
+
+    size_t received = 0u;
+    while (received < client_count) {
+      size_t pending_count = 0u;
+      for (size_t i = 0u; i < client_count; ++i) {
+        if (pending[i]) {
+          clients_data[pending_count++] = clients[i]->data;
+        }
+      }
+      rmw_clients_t clients_set{pending_count, clients_data.data()};
+      if (RMW_RET_OK != rmw_wait(
+          nullptr, nullptr, nullptr, &clients_set, nullptr, wait_set, &wait_timeout))
+      {
+        st.SkipWithError("timed out waiting for responses");
+        return false;
+      }
+      for (size_t i = 0u; i < client_count; ++i) {
+        if (!pending[i]) {
+          continue;
+        }
+        bool taken = false;
+        rmw_service_info_t response_header;
+        rmw_ret_t ret =
+          rmw_take_response(clients[i], &response_header, &taken_response, &taken);
+        if (RMW_RET_OK != ret) {
+          st.SkipWithError(rmw_get_error_string().str);
+          return false;
+        }
+        if (taken) {
+          const std::chrono::duration<double, std::micro> latency =
+            std::chrono::steady_clock::now() - send_times[i];
+          if (latencies_us.size() < max_latency_samples) {
+            latencies_us.push_back(latency.count());
+          }
+          pending[i] = false;
+          ++received;
+        }
+      }
+    }
+    return true;
+  }
+
+  void report_latencies(benchmark::State & st)
+  {
+    if (latencies_us.empty()) {
+      return;
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    const double last_index = static_cast<double>(latencies_us.size() - 1u);
+    const auto percentile = [this, last_index](double p) {
+        return latencies_us[static_cast<size_t>(p * last_index)];
+      };
+    st.counters["latency_p50_us"] = percentile(0.5);
+    st.counters["latency_p90_us"] = percentile(0.9);
+    st.counters["latency_p99_us"] = percentile(0.99);
+    st.counters["latency_max_us"] = latencies_us.back();
+  }
+
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_service_t * service{nullptr};
+  std::vector<rmw_client_t *> clients;
+  rmw_wait_set_t * wait_set{nullptr};
+  test_msgs::srv::Arrays::Request request;
+  test_msgs::srv::Arrays::Request served_request;
+  test_msgs::srv::Arrays::Response response;
+  test_msgs::srv::Arrays::Response taken_response;
+  std::vector<int64_t> sequence_numbers;
+  std::vector<std::chrono::steady_clock::time_point> send_times;
+  std::vector<bool> pending;
+  std::vector<void *> clients_data;
+  std::vector<double> latencies_us;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestService, round_trip)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (!round_trip(st)) {
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * st.range(0));
+  report_latencies(st);
+}
+BENCHMARK_REGISTER_F(PerformanceTestService, round_trip)
+->ArgNames({"clients", "payload"})
+->ArgsProduct({{1, 2, 4, 8, 16}, {0, 64 * 1024}})
+->Unit(benchmark::kMicrosecond)->UseRealTime();
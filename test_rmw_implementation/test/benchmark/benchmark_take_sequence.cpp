@@ -0,0 +1,255 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/message_sequence.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_take_sequence";
+constexpr size_t backlog_size = 1000u;
+constexpr rmw_time_t message_timeout{1, 0};
+}  // namespace
+
+// Compares draining a backlog of 1000 messages by taking them one at a time
+// against taking them all with rmw_take_sequence(), which rmw_implementation
+// emulates on top of rmw_take_with_info() for RMW implementations lacking it.
+// Messages are published and given time to arrive before each drain, which
+// waits for stragglers, if any.
+class PerformanceTestTakeSequence : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_take_sequence_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    rmw_qos_profile_t qos = rmw_qos_profile_default;
+    qos.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos.depth = backlog_size;
+    rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+    pub = rmw_create_publisher(node, ts, topic_name, &qos, &pub_options);
+    if (!pub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    sub = rmw_create_subscription(node, ts, topic_name, &qos, &sub_options);
+    if (!sub) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    wait_set = rmw_create_wait_set(&context, 1);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    rcutils_allocator_t allocator = rcutils_get_default_allocator();
+    ret = rmw_message_sequence_init(&message_sequence, backlog_size, &allocator);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    ret = rmw_message_info_sequence_init(&message_info_sequence, backlog_size, &allocator);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    msgs.resize(backlog_size);
+    for (size_t i = 0u; i < backlog_size; ++i) {
+      if (!test_msgs__msg__BasicTypes__init(&msgs[i])) {
+        msgs.resize(i);
+        st.SkipWithError("failed to initialize message");
+        return;
+      }
+      message_sequence.data[i] = &msgs[i];
+    }
+
+    // Let discovery complete before measuring anything.
+    bool taken = false;
+    rmw_message_info_t message_info = rmw_get_zero_initialized_message_info();
+    if (
+      RMW_RET_OK != rmw_publish(pub, &msgs[0], nullptr) || !wait_for_message() ||
+      RMW_RET_OK != rmw_take_with_info(sub, &msgs[0], &taken, &message_info, nullptr) || !taken)
+    {
+      st.SkipWithError("failed to take a first message");
+      return;
+    }
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    for (test_msgs__msg__BasicTypes & msg : msgs) {
+      test_msgs__msg__BasicTypes__fini(&msg);
+    }
+    msgs.clear();
+    rmw_message_info_sequence_fini(&message_info_sequence);
+    rmw_message_sequence_fini(&message_sequence);
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+    }
+    if (sub) {
+      rmw_destroy_subscription(node, sub);
+    }
+    if (pub) {
+      rmw_destroy_publisher(node, pub);
+    }
+    if (node) {
+      rmw_destroy_node(node);
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+    rmw_reset_error();
+  }
+
+protected:
+  bool wait_for_message()
+  {
+    void * subscriptions[1] = {sub->data};
+    rmw_subscriptions_t subscriptions_set{1, subscriptions};
+    return RMW_RET_OK == rmw_wait(
+      &subscriptions_set, nullptr, nullptr, nullptr, nullptr, wait_set, &message_timeout);
+  }
+
+  bool publish_backlog()
+  {
+    for (size_t i = 0u; i < backlog_size; ++i) {
+      if (RMW_RET_OK != rmw_publish(pub, &msgs[i], nullptr)) {
+        return false;
+      }
+    }
+    if (!wait_for_message()) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return true;
+  }
+
+  const rosidl_message_type_support_t * ts{
+    ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes)};
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_publisher_t * pub{nullptr};
+  rmw_subscription_t * sub{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  std::vector<test_msgs__msg__BasicTypes> msgs;
+  rmw_message_sequence_t message_sequence{rmw_get_zero_initialized_message_sequence()};
+  rmw_message_info_sequence_t message_info_sequence{
+    rmw_get_zero_initialized_message_info_sequence()};
+};
+
+BENCHMARK_F(PerformanceTestTakeSequence, drain_with_single_takes)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    st.PauseTiming();
+    if (!publish_backlog()) {
+      st.SkipWithError("failed to publish the backlog");
+      break;
+    }
+    st.ResumeTiming();
+    size_t drained = 0u;
+    while (drained < backlog_size) {
+      bool taken = false;
+      rmw_ret_t ret = rmw_take_with_info(
+        sub, &msgs[drained], &taken, &message_info_sequence.data[drained], nullptr);
+      if (RMW_RET_OK != ret) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+      if (taken) {
+        ++drained;
+      } else if (!wait_for_message()) {
+        st.SkipWithError("timed out waiting for the backlog");
+        break;
+      }
+    }
+    if (drained != backlog_size) {
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * backlog_size);
+}
+
+BENCHMARK_F(PerformanceTestTakeSequence, drain_with_sequence_takes)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    st.PauseTiming();
+    if (!publish_backlog()) {
+      st.SkipWithError("failed to publish the backlog");
+      break;
+    }
+    st.ResumeTiming();
+    size_t drained = 0u;
+    while (drained < backlog_size) {
+      size_t taken = 0u;
+      rmw_ret_t ret = rmw_take_sequence(
+        sub, backlog_size - drained, &message_sequence, &message_info_sequence, &taken, nullptr);
+      if (RMW_RET_OK != ret) {
+        st.SkipWithError(rmw_get_error_string().str);
+        break;
+      }
+      if (0u != taken) {
+        drained += taken;
+      } else if (!wait_for_message()) {
+        st.SkipWithError("timed out waiting for the backlog");
+        break;
+      }
+    }
+    if (drained != backlog_size) {
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * backlog_size);
+}
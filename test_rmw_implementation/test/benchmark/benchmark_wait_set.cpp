@@ -0,0 +1,272 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+
+#include "performance_test_fixture/performance_test_fixture.hpp"
+
+#include "rcutils/allocator.h"
+#include "rcutils/macros.h"
+#include "rcutils/strdup.h"
+
+#include "rmw/error_handling.h"
+#include "rmw/event.h"
+#include "rmw/rmw.h"
+
+#include "test_msgs/msg/basic_types.h"
+#include "test_msgs/srv/basic_types.h"
+
+using performance_test_fixture::PerformanceTest;
+
+namespace
+{
+constexpr char topic_name[] = "/benchmark_wait_set";
+constexpr char service_name[] = "/benchmark_wait_set";
+constexpr rmw_time_t no_timeout{0, 0};
+constexpr rmw_time_t wake_up_timeout{1, 0};
+}  // namespace
+
+// Measures rmw_wait() on wait sets holding as many subscriptions, guard
+// conditions, services, clients and subscription events as the benchmark
+// argument, the way executors use them.
+// Waiting with nothing ready reports the cost of a single pass over the
+// wait set, while waiting on a triggered guard condition reports the
+// wake-up latency. Both should stay flat and allocation free as the wait
+// set grows.
+class PerformanceTestWaitSet : public PerformanceTest
+{
+public:
+  void SetUp(benchmark::State & st) override
+  {
+    rmw_ret_t ret = rmw_init_options_init(&init_options, rcutils_get_default_allocator());
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    init_options.enclave = rcutils_strdup("/", rcutils_get_default_allocator());
+    ret = rmw_init(&init_options, &context);
+    if (RMW_RET_OK != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    node = rmw_create_node(&context, "benchmark_wait_set_node", "/");
+    if (!node) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    const size_t count = static_cast<size_t>(st.range(0));
+    const rosidl_message_type_support_t * message_ts =
+      ROSIDL_GET_MSG_TYPE_SUPPORT(test_msgs, msg, BasicTypes);
+    const rosidl_service_type_support_t * service_ts =
+      ROSIDL_GET_SRV_TYPE_SUPPORT(test_msgs, srv, BasicTypes);
+    rmw_subscription_options_t sub_options = rmw_get_default_subscription_options();
+    // Events are waited on by address, so they must not move.
+    events.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      rmw_subscription_t * sub = rmw_create_subscription(
+        node, message_ts, topic_name, &rmw_qos_profile_default, &sub_options);
+      if (!sub) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      subs.push_back(sub);
+      events.push_back(rmw_get_zero_initialized_event());
+      ret = rmw_subscription_event_init(&events.back(), sub, RMW_EVENT_LIVELINESS_CHANGED);
+      if (RMW_RET_OK != ret) {
+        events.pop_back();
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      rmw_guard_condition_t * gc = rmw_create_guard_condition(&context);
+      if (!gc) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      gcs.push_back(gc);
+      rmw_service_t * srv =
+        rmw_create_service(node, service_ts, service_name, &rmw_qos_profile_services_default);
+      if (!srv) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      srvs.push_back(srv);
+      rmw_client_t * client =
+        rmw_create_client(node, service_ts, service_name, &rmw_qos_profile_services_default);
+      if (!client) {
+        st.SkipWithError(rmw_get_error_string().str);
+        return;
+      }
+      clients.push_back(client);
+    }
+
+    wait_set = rmw_create_wait_set(&context, 5u * count);
+    if (!wait_set) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      all_subscriptions.push_back(subs[i]->data);
+      all_guard_conditions.push_back(gcs[i]->data);
+      all_services.push_back(srvs[i]->data);
+      all_clients.push_back(clients[i]->data);
+      all_events.push_back(&events[i]);
+    }
+    subscriptions_storage.resize(count);
+    guard_conditions_storage.resize(count);
+    services_storage.resize(count);
+    clients_storage.resize(count);
+    events_storage.resize(count);
+
+    // Wait once upfront, for lazily allocated resources to be in place.
+    ret = wait_on_all(&no_timeout);
+    if (RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      return;
+    }
+    rmw_reset_error();
+
+    PerformanceTest::SetUp(st);
+  }
+
+  void TearDown(benchmark::State & st) override
+  {
+    PerformanceTest::TearDown(st);
+
+    if (wait_set) {
+      rmw_destroy_wait_set(wait_set);
+    }
+    for (rmw_event_t & event : events) {
+      rmw_event_fini(&event);
+    }
+    for (rmw_client_t * client : clients) {
+      rmw_destroy_client(node, client);
+    }
+    for (rmw_service_t * srv : srvs) {
+      rmw_destroy_service(node, srv);
+    }
+    for (rmw_guard_condition_t * gc : gcs) {
+      rmw_destroy_guard_condition(gc);
+    }
+    for (rmw_subscription_t * sub : subs) {
+      rmw_destroy_subscription(node, sub);
+    }
+    if (node) {
+      rmw_destroy_node(node);
+    }
+    rmw_shutdown(&context);
+    rmw_context_fini(&context);
+    rmw_init_options_fini(&init_options);
+
+    // The fixture is reused for every wait set size.
+    init_options = rmw_get_zero_initialized_init_options();
+    context = rmw_get_zero_initialized_context();
+    node = nullptr;
+    wait_set = nullptr;
+    subs.clear();
+    gcs.clear();
+    srvs.clear();
+    clients.clear();
+    events.clear();
+    all_subscriptions.clear();
+    all_guard_conditions.clear();
+    all_services.clear();
+    all_clients.clear();
+    all_events.clear();
+    rmw_reset_error();
+  }
+
+protected:
+  // Wait on every entity, refilling the arrays rmw_wait() clears.
+  rmw_ret_t wait_on_all(const rmw_time_t * timeout)
+  {
+    std::copy(all_subscriptions.begin(), all_subscriptions.end(), subscriptions_storage.begin());
+    std::copy(
+      all_guard_conditions.begin(), all_guard_conditions.end(), guard_conditions_storage.begin());
+    std::copy(all_services.begin(), all_services.end(), services_storage.begin());
+    std::copy(all_clients.begin(), all_clients.end(), clients_storage.begin());
+    std::copy(all_events.begin(), all_events.end(), events_storage.begin());
+    rmw_subscriptions_t subscriptions_set{
+      subscriptions_storage.size(), subscriptions_storage.data()};
+    rmw_guard_conditions_t guard_conditions_set{
+      guard_conditions_storage.size(), guard_conditions_storage.data()};
+    rmw_services_t services_set{services_storage.size(), services_storage.data()};
+    rmw_clients_t clients_set{clients_storage.size(), clients_storage.data()};
+    rmw_events_t events_set{events_storage.size(), events_storage.data()};
+    return rmw_wait(
+      &subscriptions_set, &guard_conditions_set, &services_set, &clients_set, &events_set,
+      wait_set, timeout);
+  }
+
+  rmw_init_options_t init_options{rmw_get_zero_initialized_init_options()};
+  rmw_context_t context{rmw_get_zero_initialized_context()};
+  rmw_node_t * node{nullptr};
+  rmw_wait_set_t * wait_set{nullptr};
+  std::vector<rmw_subscription_t *> subs;
+  std::vector<rmw_guard_condition_t *> gcs;
+  std::vector<rmw_service_t *> srvs;
+  std::vector<rmw_client_t *> clients;
+  std::vector<rmw_event_t> events;
+  std::vector<void *> all_subscriptions;
+  std::vector<void *> all_guard_conditions;
+  std::vector<void *> all_services;
+  std::vector<void *> all_clients;
+  std::vector<void *> all_events;
+  std::vector<void *> subscriptions_storage;
+  std::vector<void *> guard_conditions_storage;
+  std::vector<void *> services_storage;
+  std::vector<void *> clients_storage;
+  std::vector<void *> events_storage;
+};
+
+BENCHMARK_DEFINE_F(PerformanceTestWaitSet, wait_nothing_ready)(benchmark::State & st)
+{
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    rmw_ret_t ret = wait_on_all(&no_timeout);
+    if (RMW_RET_OK != ret && RMW_RET_TIMEOUT != ret) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * 5 * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTestWaitSet, wait_nothing_ready)
+->RangeMultiplier(4)->Range(1, 4096);
+
+BENCHMARK_DEFINE_F(PerformanceTestWaitSet, wait_guard_condition_wake_up)(benchmark::State & st)
+{
+  // The last guard condition is the worst case for implementations
+  // scanning the wait set in order.
+  rmw_guard_condition_t * gc = gcs.back();
+
+  reset_heap_counters();
+  for (auto _ : st) {
+    RCUTILS_UNUSED(_);
+    if (RMW_RET_OK != rmw_trigger_guard_condition(gc)) {
+      st.SkipWithError(rmw_get_error_string().str);
+      break;
+    }
+    if (RMW_RET_OK != wait_on_all(&wake_up_timeout)) {
+      st.SkipWithError("failed to wake up on a triggered guard condition");
+      break;
+    }
+  }
+  st.SetItemsProcessed(st.iterations() * 5 * st.range(0));
+}
+BENCHMARK_REGISTER_F(PerformanceTestWaitSet, wait_guard_condition_wake_up)
+->RangeMultiplier(4)->Range(1, 4096);
@@ -555,6 +555,35 @@ protected:
   }
 };
 
+TEST_F(TestPublisherUseLoan, borrow_and_publish_loaned_message_without_memory_operations) {
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest sqg;
+
+  rmw_publisher_allocation_t * null_allocation{nullptr};  // still valid allocation
+  // Borrow and publish once upfront, for lazily allocated resources to be in place.
+  void * msg_pointer = nullptr;
+  rmw_ret_t ret = rmw_borrow_loaned_message(pub, ts, &msg_pointer);
+  ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(
+      static_cast<test_msgs__msg__BasicTypes *>(msg_pointer)));
+  ret = rmw_publish_loaned_message(pub, msg_pointer, null_allocation);
+  ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+
+  msg_pointer = nullptr;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    ret = rmw_borrow_loaned_message(pub, ts, &msg_pointer);
+  });
+  ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  ASSERT_NE(nullptr, msg_pointer);
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(
+      static_cast<test_msgs__msg__BasicTypes *>(msg_pointer)));
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    ret = rmw_publish_loaned_message(pub, msg_pointer, null_allocation);
+  });
+  EXPECT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+}
+
 TEST_F(TestPublisherUseLoan, borrow_loaned_message_with_bad_arguments) {
   void * msg_pointer = nullptr;
   rmw_ret_t ret = rmw_borrow_loaned_message(nullptr, ts, &msg_pointer);
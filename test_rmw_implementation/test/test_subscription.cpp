@@ -1120,6 +1120,80 @@ TEST_F(
   sub->implementation_identifier = implementation_identifier;
 }
 
+TEST_F(TestSubscriptionUseLoan, rmw_take_loaned_message_without_memory_operations) {
+  rmw_ret_t ret;
+  rmw_publisher_options_t pub_options = rmw_get_default_publisher_options();
+  rmw_publisher_t * pub = rmw_create_publisher(node, ts, topic_name, &qos_profile, &pub_options);
+  ASSERT_NE(nullptr, pub) << rmw_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RMW_RET_OK, rmw_destroy_publisher(node, pub)) << rmw_get_error_string().str;
+  });
+
+  size_t subscription_count = 0u;
+  SLEEP_AND_RETRY_UNTIL(rmw_intraprocess_discovery_delay, rmw_intraprocess_discovery_delay * 10) {
+    ret = rmw_publisher_count_matched_subscriptions(pub, &subscription_count);
+    if (RMW_RET_OK == ret && 1u == subscription_count) {
+      break;
+    }
+  }
+
+  rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, 1);
+  ASSERT_NE(nullptr, wait_set) << rmw_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    EXPECT_EQ(RMW_RET_OK, rmw_destroy_wait_set(wait_set)) << rmw_get_error_string().str;
+  });
+
+  test_msgs__msg__BasicTypes original_message{};
+  ASSERT_TRUE(test_msgs__msg__BasicTypes__init(&original_message));
+  original_message.int32_value = 42;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    test_msgs__msg__BasicTypes__fini(&original_message);
+  });
+
+  rmw_publisher_allocation_t * null_allocation_p{nullptr};
+  rmw_subscription_allocation_t * null_allocation_s{nullptr};
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest sqg;
+  // Take a loaned message once upfront, for lazily allocated resources to be in place.
+  for (int i = 0; i < 2; ++i) {
+    ret = rmw_publish(pub, &original_message, null_allocation_p);
+    ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+
+    void * subscriptions_storage[1] = {sub->data};
+    rmw_subscriptions_t subscriptions{1, subscriptions_storage};
+    rmw_time_t timeout = {1, 0};  // 1000ms
+    ret = rmw_wait(&subscriptions, nullptr, nullptr, nullptr, nullptr, wait_set, &timeout);
+    ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+    ASSERT_NE(nullptr, subscriptions.subscribers[0]);
+
+    bool taken = false;
+    void * loaned_message = nullptr;
+    if (0 == i) {
+      ret = rmw_take_loaned_message(sub, &loaned_message, &taken, null_allocation_s);
+    } else {
+      EXPECT_NO_MEMORY_OPERATIONS(
+      {
+        ret = rmw_take_loaned_message(sub, &loaned_message, &taken, null_allocation_s);
+      });
+    }
+    ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+    ASSERT_TRUE(taken);
+    ASSERT_NE(nullptr, loaned_message);
+    EXPECT_EQ(42, static_cast<test_msgs__msg__BasicTypes *>(loaned_message)->int32_value);
+    if (0 == i) {
+      ret = rmw_return_loaned_message_from_subscription(sub, loaned_message);
+    } else {
+      EXPECT_NO_MEMORY_OPERATIONS(
+      {
+        ret = rmw_return_loaned_message_from_subscription(sub, loaned_message);
+      });
+    }
+    EXPECT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  }
+}
+
 TEST_F(TestSubscriptionUseLoan, rmw_return_loaned_message_from_subscription) {
   test_msgs__msg__BasicTypes msg{};
   rmw_ret_t ret = rmw_return_loaned_message_from_subscription(nullptr, &msg);
@@ -14,6 +14,7 @@
 
 #include <gtest/gtest.h>
 
+#include "osrf_testing_tools_cpp/memory_tools/gtest_quickstart.hpp"
 #include "osrf_testing_tools_cpp/scope_exit.hpp"
 
 #include "rcutils/allocator.h"
@@ -380,6 +381,71 @@ TEST_F(TestWaitSetUse, rmw_wait)
   });
 }
 
+TEST_F(TestWaitSetUse, rmw_wait_without_memory_operations)
+{
+  constexpr size_t num_conditions = 5u;
+  rmw_wait_set_t * wait_set = rmw_create_wait_set(&context, num_conditions);
+  ASSERT_NE(nullptr, wait_set) << rmw_get_error_string().str;
+  OSRF_TESTING_TOOLS_CPP_SCOPE_EXIT(
+  {
+    rmw_ret_t ret = rmw_destroy_wait_set(wait_set);
+    EXPECT_EQ(ret, RMW_RET_OK) << rcutils_get_error_string().str;
+  });
+
+  rmw_subscriptions_t subscriptions;
+  rmw_guard_conditions_t guard_conditions;
+  rmw_services_t services;
+  rmw_clients_t clients;
+  rmw_events_t events;
+  INITIALIZE_ARRAY(subscriptions, subscriber, 1u);
+  INITIALIZE_ARRAY(guard_conditions, guard_condition, 1u);
+  INITIALIZE_ARRAY(services, service, 1u);
+  INITIALIZE_ARRAY(clients, client, 1u);
+  INITIALIZE_ARRAY(events, event, 1u);
+
+  rmw_time_t timeout_argument_zero = {0, 0};
+  rmw_ret_t ret = RMW_RET_ERROR;
+  auto wait_on_all = [&]() {
+      subscriptions.subscribers[0] = sub->data;
+      guard_conditions.guard_conditions[0] = gc->data;
+      services.services[0] = srv->data;
+      clients.clients[0] = client->data;
+      events.events[0] = &event;
+      ret = rmw_wait(
+        &subscriptions, &guard_conditions, &services, &clients, &events, wait_set,
+        &timeout_argument_zero);
+    };
+
+  osrf_testing_tools_cpp::memory_tools::ScopedQuickstartGtest sqg;
+
+  // Wait once upfront, for lazily allocated resources to be in place.
+  wait_on_all();
+  EXPECT_EQ(RMW_RET_TIMEOUT, ret) << rmw_get_error_string().str;
+  rmw_reset_error();
+
+  // Steady state waits with nothing ready must not touch the heap.
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    wait_on_all();
+  });
+  EXPECT_EQ(RMW_RET_TIMEOUT, ret) << rmw_get_error_string().str;
+  rmw_reset_error();
+
+  // Nor may waking up on a triggered guard condition.
+  ret = rmw_trigger_guard_condition(gc);
+  ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  wait_on_all();
+  EXPECT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  ret = rmw_trigger_guard_condition(gc);
+  ASSERT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  EXPECT_NO_MEMORY_OPERATIONS(
+  {
+    wait_on_all();
+  });
+  EXPECT_EQ(RMW_RET_OK, ret) << rmw_get_error_string().str;
+  EXPECT_NE(nullptr, guard_conditions.guard_conditions[0]);
+}
+
 TEST_F(TestWaitSet, rmw_destroy_wait_set)
 {
   // Try to destroy a nullptr